@@ -32,6 +32,7 @@
 #include <openssl/crypto.h>
 
 #include "Common.h"
+#include "Threading.h"
 #include "Database/DatabaseEnv.h"
 #include "Configuration/Config.h"
 #include "Log.h"
@@ -74,6 +75,23 @@ public:
     }
 };
 
+/// Additional thread running the reactor event loop, see Network.Threads
+class AuthReactorRunnable : public ACE_Based::Runnable
+{
+public:
+    void run()
+    {
+        while (!stopEvent)
+        {
+            // dont move this outside the loop, the reactor will modify it
+            ACE_Time_Value interval(0, 100000);
+
+            if (ACE_Reactor::instance()->run_reactor_event_loop(interval) == -1)
+                break;
+        }
+    }
+};
+
 /// Print out the usage string for this program on the console.
 void usage(const char* prog)
 {
@@ -243,6 +261,21 @@ extern int main(int argc, char** argv)
 
 #endif
 
+    // The main thread runs the reactor too
+    int32 networkThreads = sConfigMgr->GetIntDefault("Network.Threads", 1);
+    if (networkThreads < 1)
+    {
+        IC_LOG_ERROR("server.authserver", "Network.Threads is wrong in your config file, defaulting to 1.");
+        networkThreads = 1;
+    }
+
+    std::vector<ACE_Based::Thread*> reactorThreads;
+    for (int32 i = 1; i < networkThreads; ++i)
+        reactorThreads.push_back(new ACE_Based::Thread(new AuthReactorRunnable));
+
+    if (networkThreads > 1)
+        IC_LOG_INFO("server.authserver", "Running the network reactor in %d threads", networkThreads);
+
     // maximum counter for next ping
     uint32 numLoops = (sConfigMgr->GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000000 / 100000));
     uint32 loopCounter = 0;
@@ -256,6 +289,10 @@ extern int main(int argc, char** argv)
         if (ACE_Reactor::instance()->run_reactor_event_loop(interval) == -1)
             break;
 
+        RealmSocket::dispatch_completed();
+
+        sRealmList->UpdateIfNeed();
+
         if ((++loopCounter) == numLoops)
         {
             loopCounter = 0;
@@ -264,6 +301,14 @@ extern int main(int argc, char** argv)
         }
     }
 
+    // the other reactor threads leave their loop on stopEvent too
+    stopEvent = true;
+    for (std::vector<ACE_Based::Thread*>::iterator itr = reactorThreads.begin(); itr != reactorThreads.end(); ++itr)
+    {
+        (*itr)->wait();
+        delete *itr;
+    }
+
     // Close the Database Pool and library
     StopDB();
 
@@ -297,7 +342,7 @@ bool StartDB()
         synch_threads = 1;
     }
 
-    // NOTE: While authserver is singlethreaded you should keep synch_threads == 1. Increasing it is just silly since only 1 will be used ever.
+    // NOTE: The handshake only uses asynchronous queries, keep synch_threads == 1 and raise worker_threads instead.
     if (!LoginDatabase.Open(dbstring, uint8(worker_threads), uint8(synch_threads)))
     {
         IC_LOG_ERROR("server.authserver", "Cannot connect to database");
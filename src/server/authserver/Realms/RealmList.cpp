@@ -18,9 +18,10 @@
 
 #include "Common.h"
 #include "RealmList.h"
+#include "AuthCodes.h"
 #include "Database/DatabaseEnv.h"
 
-RealmList::RealmList() : m_UpdateInterval(0), m_NextUpdateTime(time(NULL)) { }
+RealmList::RealmList() : m_updating(false), m_UpdateInterval(0), m_NextUpdateTime(time(NULL)) { }
 
 // Load the realm list from the database
 void RealmList::Initialize(uint32 updateInterval)
@@ -28,13 +29,23 @@ void RealmList::Initialize(uint32 updateInterval)
     m_UpdateInterval = updateInterval;
 
     // Get the content of the realmlist table in the database
-    UpdateRealms(true);
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_REALMLIST);
+    UpdateRealms(LoginDatabase.Query(stmt), true);
 }
 
-void RealmList::UpdateRealm(uint32 id, const std::string& name, ACE_INET_Addr const& address, ACE_INET_Addr const& localAddr, ACE_INET_Addr const& localSubmask, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, uint32 build)
+bool RealmList::UpdateRealm(uint32 id, const std::string& name, ACE_INET_Addr const& address, ACE_INET_Addr const& localAddr, ACE_INET_Addr const& localSubmask, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, uint32 build)
 {
     // Create new if not exist or update existed
-    Realm& realm = m_realms[name];
+    RealmMap::iterator itr = m_realms.find(name);
+    bool changed = itr == m_realms.end();
+    if (changed)
+        itr = m_realms.insert(RealmMap::value_type(name, Realm())).first;
+
+    Realm& realm = itr->second;
+
+    // the security level, population and addresses are written per client, see RealmListEntry
+    if (!changed)
+        changed = realm.icon != icon || realm.flag != flag || realm.timezone != timezone || realm.gamebuild != build;
 
     realm.m_ID = id;
     realm.name = name;
@@ -49,29 +60,46 @@ void RealmList::UpdateRealm(uint32 id, const std::string& name, ACE_INET_Addr co
     realm.LocalAddress = localAddr;
     realm.LocalSubnetMask = localSubmask;
     realm.gamebuild = build;
+
+    return changed;
 }
 
 void RealmList::UpdateIfNeed()
 {
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    // apply the result of the running update
+    if (m_updating)
+    {
+        if (!m_updateFuture.ready())
+            return;
+
+        PreparedQueryResult result;
+        m_updateFuture.get(result);
+        m_updateFuture.cancel();
+        m_updating = false;
+
+        UpdateRealms(result);
+        return;
+    }
+
     // maybe disabled or updated recently
     if (!m_UpdateInterval || m_NextUpdateTime > time(NULL))
         return;
 
     m_NextUpdateTime = time(NULL) + m_UpdateInterval;
 
-    // Clears Realm list
-    m_realms.clear();
-
     // Get the content of the realmlist table in the database
-    UpdateRealms();
+    m_updateFuture = LoginDatabase.AsyncQuery(LoginDatabase.GetPreparedStatement(LOGIN_SEL_REALMLIST));
+    m_updating = true;
 }
 
-void RealmList::UpdateRealms(bool init)
+void RealmList::UpdateRealms(PreparedQueryResult result, bool init)
 {
     IC_LOG_INFO("server.authserver", "Updating Realm List...");
 
-    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_REALMLIST);
-    PreparedQueryResult result = LoginDatabase.Query(stmt);
+    std::set<std::string> listed;
+    bool changed = false;
 
     // Circle through results and add them to the realm map
     if (result)
@@ -96,11 +124,99 @@ void RealmList::UpdateRealms(bool init)
             ACE_INET_Addr localAddr(port, localAddress.c_str(), AF_INET);
             ACE_INET_Addr submask(0, localSubmask.c_str(), AF_INET);
 
-            UpdateRealm(realmId, name, externalAddr, localAddr, submask, icon, flag, timezone, (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR), pop, build);
+            if (UpdateRealm(realmId, name, externalAddr, localAddr, submask, icon, flag, timezone, (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR), pop, build))
+                changed = true;
+
+            listed.insert(name);
 
             if (init)
                 IC_LOG_INFO("server.authserver", "Added realm \"%s\" at %s:%u.", name.c_str(), m_realms[name].ExternalAddress.get_host_addr(), port);
         }
         while (result->NextRow());
     }
+
+    // Remove the realms that are no longer listed
+    for (RealmMap::iterator itr = m_realms.begin(); itr != m_realms.end();)
+    {
+        if (listed.find(itr->first) == listed.end())
+        {
+            m_realms.erase(itr++);
+            changed = true;
+        }
+        else
+            ++itr;
+    }
+
+    // population changes are picked up by the cached packets as they are
+    if (changed)
+        m_realmListCaches.clear();
+}
+
+RealmList::RealmListCache const& RealmList::GetRealmListCache(uint32 build)
+{
+    std::map<uint32, RealmListCache>::iterator itr = m_realmListCaches.find(build);
+    if (itr != m_realmListCaches.end())
+        return itr->second;
+
+    RealmListCache& cache = m_realmListCaches[build];
+    BuildRealmListCache(build, cache);
+    return cache;
+}
+
+void RealmList::BuildRealmListCache(uint32 build, RealmListCache& cache) const
+{
+    uint8 expversion = uint8(AuthHelper::IsPostBCAcceptedClientBuild(build) ? POST_BC_EXP_FLAG : (AuthHelper::IsPreBCAcceptedClientBuild(build) ? PRE_BC_EXP_FLAG : NO_VALID_EXP_FLAG));
+
+    cache.reserve(m_realms.size());
+    for (RealmMap::const_iterator i = m_realms.begin(); i != m_realms.end(); ++i)
+    {
+        Realm const& realm = i->second;
+        // don't work with realms which not compatible with the client
+        bool okBuild = ((expversion & POST_BC_EXP_FLAG) && realm.gamebuild == build) || ((expversion & PRE_BC_EXP_FLAG) && !AuthHelper::IsPreBCAcceptedClientBuild(realm.gamebuild));
+
+        uint32 flag = realm.flag;
+        RealmBuildInfo const* buildInfo = AuthHelper::GetBuildInfo(realm.gamebuild);
+        if (!okBuild)
+        {
+            if (!buildInfo)
+                continue;
+
+            flag |= REALM_FLAG_OFFLINE | REALM_FLAG_SPECIFYBUILD;   // tell the client what build the realm is for
+        }
+
+        if (!buildInfo)
+            flag &= ~REALM_FLAG_SPECIFYBUILD;
+
+        std::string name = i->first;
+        if (expversion & PRE_BC_EXP_FLAG && flag & REALM_FLAG_SPECIFYBUILD)
+        {
+            std::ostringstream ss;
+            ss << name << " (" << buildInfo->MajorVersion << '.' << buildInfo->MinorVersion << '.' << buildInfo->BugfixVersion << ')';
+            name = ss.str();
+        }
+
+        RealmListEntry entry;
+        entry.RealmInfo = &realm;
+
+        entry.Head << realm.icon;                           // realm type
+
+        entry.Body << uint8(flag);                          // RealmFlags
+        entry.Body << name;
+
+        entry.Tail << realm.timezone;                       // realm category
+        if (expversion & POST_BC_EXP_FLAG)                  // 2.x and 3.x clients
+            entry.Tail << uint8(0x2C);                      // unk, may be realm number/id?
+        else
+            entry.Tail << uint8(0x0);                       // 1.12.1 and 1.12.2 clients
+
+        if (expversion & POST_BC_EXP_FLAG && flag & REALM_FLAG_SPECIFYBUILD)
+        {
+            entry.Tail << uint8(buildInfo->MajorVersion);
+            entry.Tail << uint8(buildInfo->MinorVersion);
+            entry.Tail << uint8(buildInfo->BugfixVersion);
+            entry.Tail << uint16(buildInfo->Build);
+        }
+
+        cache.push_back(entry);
+    }
 }
@@ -21,8 +21,11 @@
 
 #include <ace/Singleton.h>
 #include <ace/Null_Mutex.h>
+#include <ace/Thread_Mutex.h>
 #include <ace/INET_Addr.h>
 #include "Common.h"
+#include "ByteBuffer.h"
+#include "Database/DatabaseEnv.h"
 
 enum RealmFlags
 {
@@ -53,11 +56,25 @@ struct Realm
     uint32 gamebuild;
 };
 
+/**
+    Realm list packet entry of one realm, serialized once per client build.
+    The lock flag, address, population and character count differ per client and
+    are written between the parts when the packet is sent.
+*/
+struct RealmListEntry
+{
+    Realm const* RealmInfo;
+    ByteBuffer Head;                                        // icon
+    ByteBuffer Body;                                        // flags, name
+    ByteBuffer Tail;                                        // timezone, realm number, build info
+};
+
 /// Storage object for the list of realms on the server
 class RealmList
 {
 public:
     typedef std::map<std::string, Realm> RealmMap;
+    typedef std::vector<RealmListEntry> RealmListCache;
 
     RealmList();
     ~RealmList() { }
@@ -66,19 +83,30 @@ public:
 
     void UpdateIfNeed();
 
-    void AddRealm(const Realm& NewRealm) { m_realms[NewRealm.name] = NewRealm; }
+    void AddRealm(const Realm& NewRealm) { m_realms[NewRealm.name] = NewRealm; m_realmListCaches.clear(); }
 
     RealmMap::const_iterator begin() const { return m_realms.begin(); }
     RealmMap::const_iterator end() const { return m_realms.end(); }
     uint32 size() const { return m_realms.size(); }
 
+    /// Serialized realm list of the given client build, rebuilt only when realms were added, removed or changed
+    RealmListCache const& GetRealmListCache(uint32 build);
+
+    /// Held while reading the list or its caches, the network reactor may run in several threads
+    ACE_Thread_Mutex& GetLock() { return m_lock; }
+
 private:
-    void UpdateRealms(bool init=false);
-    void UpdateRealm(uint32 id, const std::string& name, ACE_INET_Addr const& address, ACE_INET_Addr const& localAddr, ACE_INET_Addr const& localSubmask, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, uint32 build);
+    void UpdateRealms(PreparedQueryResult result, bool init=false);
+    bool UpdateRealm(uint32 id, const std::string& name, ACE_INET_Addr const& address, ACE_INET_Addr const& localAddr, ACE_INET_Addr const& localSubmask, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, uint32 build);
+    void BuildRealmListCache(uint32 build, RealmListCache& cache) const;
 
     RealmMap m_realms;
+    std::map<uint32, RealmListCache> m_realmListCaches;
+    PreparedQueryResultFuture m_updateFuture;
+    bool     m_updating;
     uint32   m_UpdateInterval;
     time_t   m_NextUpdateTime;
+    ACE_Thread_Mutex m_lock;
 };
 
 #define sRealmList ACE_Singleton<RealmList, ACE_Null_Mutex>::instance()
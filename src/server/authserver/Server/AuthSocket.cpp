@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <openssl/md5.h>
+#include <ace/Singleton.h>
 
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
@@ -193,16 +194,41 @@ const AuthHandler table[] =
 
 #define AUTH_TOTAL_COMMANDS 8
 
+#define SRP6_MODULUS            "894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7"
+#define SRP6_GENERATOR          7
+#define SRP6_MAX_EXPONENT_BITS  160                         // x is a SHA1 digest, b is 152 bits
+
+// Montgomery context of N with the precomputed powers of g, shared by all sessions
+class SRP6ModExp : public ModExpContext
+{
+    friend class ACE_Singleton<SRP6ModExp, ACE_Thread_Mutex>;
+
+    private:
+        SRP6ModExp() : ModExpContext(Modulus())
+        {
+            SetFixedBase(BigNumber(SRP6_GENERATOR), SRP6_MAX_EXPONENT_BITS);
+        }
+
+        static BigNumber Modulus()
+        {
+            BigNumber N;
+            N.SetHexStr(SRP6_MODULUS);
+            return N;
+        }
+};
+
+#define sSRP6ModExp ACE_Singleton<SRP6ModExp, ACE_Thread_Mutex>::instance()
+
 // Holds the MD5 hash of client patches present on the server
 Patcher PatchesCache;
 
 // Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket(RealmSocket& socket) :
-    pPatch(NULL), socket_(socket), _authed(false), _build(0),
+    pPatch(NULL), socket_(socket), _queryCallback(NULL), _authed(false), _accountId(0), _realmCharactersTime(0), _build(0),
     _expversion(0), _accountSecurityLevel(SEC_PLAYER)
 {
-    N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
-    g.SetDword(7);
+    N.SetHexStr(SRP6_MODULUS);
+    g.SetDword(SRP6_GENERATOR);
 }
 
 // Close patch file descriptor before leaving
@@ -219,12 +245,54 @@ void AuthSocket::OnClose(void)
     IC_LOG_DEBUG("server.authserver", "AuthSocket::OnClose");
 }
 
+// Continue the handshake with the result of the running query
+void AuthSocket::OnQueryResult(void)
+{
+    if (!_queryCallback)
+        return;
+
+    PreparedQueryResult result;
+    _queryFuture.get(result);
+
+    QueryCallback callback = _queryCallback;
+    _queryCallback = NULL;
+    _queryFuture.cancel();
+
+    (this->*callback)(result);
+}
+
+void AuthSocket::update(PreparedQueryResultFuture const& /*future*/)
+{
+    if (!socket().notify())
+        IC_LOG_DEBUG("server.authserver", "'%s:%d' Could not notify the reactor of a completed query, it is picked up by the next reactor loop", socket().getRemoteAddress().c_str(), socket().getRemotePort());
+
+    // may delete the socket and this session, the notification holds its own reference
+    socket().remove_reference();
+}
+
+void AuthSocket::_AsyncQuery(PreparedStatement* stmt, QueryCallback callback)
+{
+    ASSERT(!_queryCallback);
+
+    _queryCallback = callback;
+
+    // keep the socket alive until the worker thread is done with it in update()
+    socket().add_reference();
+
+    _queryFuture = LoginDatabase.AsyncQuery(stmt);
+    _queryFuture.attach(this);
+}
+
 // Read the packet from the client
 void AuthSocket::OnRead()
 {
     uint8 _cmd;
     while (1)
     {
+        // waiting for a query, the input is handled once OnQueryResult continued the handshake
+        if (_queryCallback)
+            return;
+
         if (!socket().recv_soft((char *)&_cmd, 1))
             return;
 
@@ -278,7 +346,7 @@ void AuthSocket::_SetVSFields(const std::string& rI)
     sha.Finalize();
     BigNumber x;
     x.SetBinary(sha.GetDigest(), sha.GetLength());
-    v = g.ModExp(x, N);
+    v = sSRP6ModExp->FixedBaseModExp(x);
 
     // No SQL injection (username escaped)
     char *v_hex, *s_hex;
@@ -340,8 +408,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->ip);
 #endif
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
     _expversion = uint8(AuthHelper::IsPostBCAcceptedClientBuild(_build) ? POST_BC_EXP_FLAG : (AuthHelper::IsPreBCAcceptedClientBuild(_build) ? PRE_BC_EXP_FLAG : NO_VALID_EXP_FLAG));
@@ -353,196 +419,232 @@ bool AuthSocket::_HandleLogonChallenge()
     // Restore string order as its byte order is reversed
     std::reverse(_os.begin(), _os.end());
 
-    pkt << uint8(AUTH_LOGON_CHALLENGE);
-    pkt << uint8(0x00);
+    _localizationName.resize(4);
+    for (int i = 0; i < 4; ++i)
+        _localizationName[i] = ch->country[4-i-1];
 
     // Verify that this IP is not in the ip_banned table
     LoginDatabase.Execute(LoginDatabase.GetPreparedStatement(LOGIN_DEL_EXPIRED_IP_BANS));
 
-    std::string const& ip_address = socket().getRemoteAddress();
     PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_IP_BANNED);
-    stmt->setString(0, ip_address);
-    PreparedQueryResult result = LoginDatabase.Query(stmt);
+    stmt->setString(0, socket().getRemoteAddress());
+    _AsyncQuery(stmt, &AuthSocket::_LogonChallengeIpBanCallback);
+    return true;
+}
+
+void AuthSocket::_SendLogonChallengeError(uint8 error)
+{
+    ByteBuffer pkt;
+    pkt << uint8(AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
+    pkt << uint8(error);
+    socket().send((char const*)pkt.contents(), pkt.size());
+}
+
+void AuthSocket::_LogonChallengeIpBanCallback(PreparedQueryResult result)
+{
     if (result)
     {
-        pkt << uint8(WOW_FAIL_BANNED);
         IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] Banned ip tries to login!", socket().getRemoteAddress().c_str(), socket().getRemotePort());
+        _SendLogonChallengeError(WOW_FAIL_BANNED);
+        return;
+    }
+
+    // Get the account details from the account table
+    // No SQL injection (prepared statement)
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGONCHALLENGE);
+    stmt->setString(0, _login);
+    _AsyncQuery(stmt, &AuthSocket::_LogonChallengeAccountCallback);
+}
+
+void AuthSocket::_LogonChallengeAccountCallback(PreparedQueryResult result)
+{
+    if (!result)                                            //no account
+    {
+        _SendLogonChallengeError(WOW_FAIL_UNKNOWN_ACCOUNT);
+        return;
+    }
+
+    _accountResult = result;
+    Field* fields = result->Fetch();
+    std::string const& ip_address = socket().getRemoteAddress();
+
+    // If the IP is 'locked', check that the player comes indeed from the correct IP address
+    if (fields[2].GetUInt8() == 1)                          // if ip is locked
+    {
+        IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), fields[3].GetCString());
+        IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Player address is '%s'", ip_address.c_str());
+
+        if (strcmp(fields[4].GetCString(), ip_address.c_str()) != 0)
+        {
+            IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account IP differs");
+            _accountResult.reset();
+            _SendLogonChallengeError(WOW_FAIL_LOCKED_ENFORCED);
+            return;
+        }
+
+        IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account IP matches");
     }
     else
     {
-        // Get the account details from the account table
-        // No SQL injection (prepared statement)
-        stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGONCHALLENGE);
-        stmt->setString(0, _login);
+        IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
+        std::string accountCountry = fields[3].GetString();
+        if (accountCountry.empty() || accountCountry == "00")
+            IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is not locked to country", _login.c_str());
+        else
+        {
+            uint32 ip = inet_addr(ip_address.c_str());
+            EndianConvertReverse(ip);
+
+            PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGON_COUNTRY);
+            stmt->setUInt32(0, ip);
+            _AsyncQuery(stmt, &AuthSocket::_LogonChallengeCountryCallback);
+            return;
+        }
+    }
+
+    _LogonChallengeCheckAccountBan();
+}
 
-        PreparedQueryResult res2 = LoginDatabase.Query(stmt);
-        if (res2)
+void AuthSocket::_LogonChallengeCountryCallback(PreparedQueryResult result)
+{
+    if (result)
+    {
+        std::string accountCountry = (*_accountResult)[3].GetString();
+        std::string loginCountry = (*result)[0].GetString();
+        IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is locked to country: '%s' Player country is '%s'", _login.c_str(), accountCountry.c_str(), loginCountry.c_str());
+        if (loginCountry != accountCountry)
         {
-            Field* fields = res2->Fetch();
+            IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account country differs.");
+            _accountResult.reset();
+            _SendLogonChallengeError(WOW_FAIL_UNLOCKABLE_LOCK);
+            return;
+        }
 
-            // If the IP is 'locked', check that the player comes indeed from the correct IP address
-            bool locked = false;
-            if (fields[2].GetUInt8() == 1)                  // if ip is locked
-            {
-                IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), fields[3].GetCString());
-                IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Player address is '%s'", ip_address.c_str());
+        IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account country matches");
+    }
+    else
+        IC_LOG_DEBUG("server.authserver", "[AuthChallenge] IP2NATION Table empty");
 
-                if (strcmp(fields[4].GetCString(), ip_address.c_str()) != 0)
-                {
-                    IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account IP differs");
-                    pkt << uint8(WOW_FAIL_LOCKED_ENFORCED);
+    _LogonChallengeCheckAccountBan();
+}
 
-                    locked = true;
-                }
-                else
-                    IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account IP matches");
-            }
-            else
-            {
-                IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
-                std::string accountCountry = fields[3].GetString();
-                if (accountCountry.empty() || accountCountry == "00")
-                    IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is not locked to country", _login.c_str());
-                else if (!accountCountry.empty())
-                {
-                    uint32 ip = inet_addr(ip_address.c_str());
-                    EndianConvertReverse(ip);
-
-                    stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGON_COUNTRY);
-                    stmt->setUInt32(0, ip);
-                    if (PreparedQueryResult sessionCountryQuery = LoginDatabase.Query(stmt))
-                    {
-                        std::string loginCountry = (*sessionCountryQuery)[0].GetString();
-                        IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is locked to country: '%s' Player country is '%s'", _login.c_str(), accountCountry.c_str(), loginCountry.c_str());
-                        if (loginCountry != accountCountry)
-                        {
-                            IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account country differs.");
-                            pkt << uint8(WOW_FAIL_UNLOCKABLE_LOCK);
-
-                            locked = true;
-                        }
-                        else
-                            IC_LOG_DEBUG("server.authserver", "[AuthChallenge] Account country matches");
-                    }
-                    else
-                        IC_LOG_DEBUG("server.authserver", "[AuthChallenge] IP2NATION Table empty");
-                }
-            }
+void AuthSocket::_LogonChallengeCheckAccountBan()
+{
+    //set expired bans to inactive
+    LoginDatabase.Execute(LoginDatabase.GetPreparedStatement(LOGIN_UPD_EXPIRED_ACCOUNT_BANS));
 
-            if (!locked)
-            {
-                //set expired bans to inactive
-                LoginDatabase.Execute(LoginDatabase.GetPreparedStatement(LOGIN_UPD_EXPIRED_ACCOUNT_BANS));
-
-                // If the account is banned, reject the logon attempt
-                stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_ACCOUNT_BANNED);
-                stmt->setUInt32(0, fields[1].GetUInt32());
-                PreparedQueryResult banresult = LoginDatabase.Query(stmt);
-                if (banresult)
-                {
-                    if ((*banresult)[0].GetUInt32() == (*banresult)[1].GetUInt32())
-                    {
-                        pkt << uint8(WOW_FAIL_BANNED);
-                        IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] Banned account %s tried to login!", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str ());
-                    }
-                    else
-                    {
-                        pkt << uint8(WOW_FAIL_SUSPENDED);
-
-                        IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] Temporarily banned account %s tried to login!", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str ());
-                    }
-                }
-                else
-                {
-                    // Get the password from the account table, upper it, and make the SRP6 calculation
-                    std::string rI = fields[0].GetString();
-
-                    // Don't calculate (v, s) if there are already some in the database
-                    std::string databaseV = fields[6].GetString();
-                    std::string databaseS = fields[7].GetString();
-
-                    IC_LOG_DEBUG("network", "database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
-
-                    // multiply with 2 since bytes are stored as hexstring
-                    if (databaseV.size() != s_BYTE_SIZE * 2 || databaseS.size() != s_BYTE_SIZE * 2)
-                        _SetVSFields(rI);
-                    else
-                    {
-                        s.SetHexStr(databaseS.c_str());
-                        v.SetHexStr(databaseV.c_str());
-                    }
-
-                    b.SetRand(19 * 8);
-                    BigNumber gmod = g.ModExp(b, N);
-                    B = ((v * 3) + gmod) % N;
-
-                    ASSERT(gmod.GetNumBytes() <= 32);
-
-                    BigNumber unk3;
-                    unk3.SetRand(16 * 8);
-
-                    // Fill the response packet with the result
-                    if (AuthHelper::IsAcceptedClientBuild(_build))
-                        pkt << uint8(WOW_SUCCESS);
-                    else
-                        pkt << uint8(WOW_FAIL_VERSION_INVALID);
-
-
-                    // B may be calculated < 32B so we force minimal length to 32B
-                    pkt.append(B.AsByteArray(32).get(), 32);      // 32 bytes
-                    pkt << uint8(1);
-                    pkt.append(g.AsByteArray().get(), 1);
-                    pkt << uint8(32);
-                    pkt.append(N.AsByteArray(32).get(), 32);
-                    pkt.append(s.AsByteArray().get(), s.GetNumBytes());   // 32 bytes
-                    pkt.append(unk3.AsByteArray(16).get(), 16);
-                    uint8 securityFlags = 0;
-
-                    // Check if token is used
-                    _tokenKey = fields[8].GetString();
-                    if (!_tokenKey.empty())
-                        securityFlags = 4;
-
-                    pkt << uint8(securityFlags);            // security flags (0x0...0x04)
-
-                    if (securityFlags & 0x01)               // PIN input
-                    {
-                        pkt << uint32(0);
-                        pkt << uint64(0) << uint64(0);      // 16 bytes hash?
-                    }
-
-                    if (securityFlags & 0x02)               // Matrix input
-                    {
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint64(0);
-                    }
-
-                    if (securityFlags & 0x04)               // Security token input
-                        pkt << uint8(1);
-
-                    uint8 secLevel = fields[5].GetUInt8();
-                    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
-
-                    _localizationName.resize(4);
-                    for (int i = 0; i < 4; ++i)
-                        _localizationName[i] = ch->country[4-i-1];
-
-                    IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", socket().getRemoteAddress().c_str(), socket().getRemotePort(),
-                            _login.c_str (), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName)
-                        );
-                }
-            }
+    // If the account is banned, reject the logon attempt
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_ACCOUNT_BANNED);
+    stmt->setUInt32(0, (*_accountResult)[1].GetUInt32());
+    _AsyncQuery(stmt, &AuthSocket::_LogonChallengeAccountBanCallback);
+}
+
+void AuthSocket::_LogonChallengeAccountBanCallback(PreparedQueryResult result)
+{
+    PreparedQueryResult account = _accountResult;
+    _accountResult.reset();
+
+    if (result)
+    {
+        if ((*result)[0].GetUInt32() == (*result)[1].GetUInt32())
+        {
+            IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] Banned account %s tried to login!", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str ());
+            _SendLogonChallengeError(WOW_FAIL_BANNED);
         }
-        else                                                //no account
-            pkt << uint8(WOW_FAIL_UNKNOWN_ACCOUNT);
+        else
+        {
+            IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] Temporarily banned account %s tried to login!", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str ());
+            _SendLogonChallengeError(WOW_FAIL_SUSPENDED);
+        }
+        return;
+    }
+
+    Field* fields = account->Fetch();
+
+    // Get the password from the account table, upper it, and make the SRP6 calculation
+    std::string rI = fields[0].GetString();
+
+    // Don't calculate (v, s) if there are already some in the database
+    std::string databaseV = fields[6].GetString();
+    std::string databaseS = fields[7].GetString();
+
+    IC_LOG_DEBUG("network", "database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+
+    // multiply with 2 since bytes are stored as hexstring
+    if (databaseV.size() != s_BYTE_SIZE * 2 || databaseS.size() != s_BYTE_SIZE * 2)
+        _SetVSFields(rI);
+    else
+    {
+        s.SetHexStr(databaseS.c_str());
+        v.SetHexStr(databaseV.c_str());
+    }
+
+    b.SetRand(19 * 8);
+    BigNumber gmod = sSRP6ModExp->FixedBaseModExp(b);
+    B = ((v * 3) + gmod) % N;
 
+    ASSERT(gmod.GetNumBytes() <= 32);
+
+    BigNumber unk3;
+    unk3.SetRand(16 * 8);
+
+    // Fill the response packet with the result
+    ByteBuffer pkt;
+    pkt << uint8(AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
+
+    if (AuthHelper::IsAcceptedClientBuild(_build))
+        pkt << uint8(WOW_SUCCESS);
+    else
+        pkt << uint8(WOW_FAIL_VERSION_INVALID);
+
+
+    // B may be calculated < 32B so we force minimal length to 32B
+    pkt.append(B.AsByteArray(32).get(), 32);      // 32 bytes
+    pkt << uint8(1);
+    pkt.append(g.AsByteArray().get(), 1);
+    pkt << uint8(32);
+    pkt.append(N.AsByteArray(32).get(), 32);
+    pkt.append(s.AsByteArray().get(), s.GetNumBytes());   // 32 bytes
+    pkt.append(unk3.AsByteArray(16).get(), 16);
+    uint8 securityFlags = 0;
+
+    // Check if token is used
+    _tokenKey = fields[8].GetString();
+    if (!_tokenKey.empty())
+        securityFlags = 4;
+
+    pkt << uint8(securityFlags);                            // security flags (0x0...0x04)
+
+    if (securityFlags & 0x01)                               // PIN input
+    {
+        pkt << uint32(0);
+        pkt << uint64(0) << uint64(0);                      // 16 bytes hash?
+    }
+
+    if (securityFlags & 0x02)                               // Matrix input
+    {
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint64(0);
     }
 
+    if (securityFlags & 0x04)                               // Security token input
+        pkt << uint8(1);
+
+    _accountId = fields[1].GetUInt32();
+
+    uint8 secLevel = fields[5].GetUInt8();
+    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+
+    IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s is using '%s' locale (%u)", socket().getRemoteAddress().c_str(), socket().getRemotePort(),
+            _login.c_str (), _localizationName.c_str(), GetLocaleByName(_localizationName)
+        );
+
     socket().send((char const*)pkt.contents(), pkt.size());
-    return true;
 }
 
 // Logon Proof command handler
@@ -581,7 +683,7 @@ bool AuthSocket::_HandleLogonProof()
     sha.Finalize();
     BigNumber u;
     u.SetBinary(sha.GetDigest(), 20);
-    BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
+    BigNumber S = sSRP6ModExp->ModExp(A * sSRP6ModExp->ModExp(v, u), b);
 
     uint8 t[32];
     uint8 t1[16];
@@ -713,53 +815,59 @@ bool AuthSocket::_HandleLogonProof()
 
         IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s tried to login with invalid password!", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str ());
 
-        uint32 MaxWrongPassCount = sConfigMgr->GetIntDefault("WrongPass.MaxCount", 0);
-        if (MaxWrongPassCount > 0)
+        if (sConfigMgr->GetIntDefault("WrongPass.MaxCount", 0) > 0)
         {
-            //Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
-            PreparedStatement *stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_FAILEDLOGINS);
+            // The counter is read before it is incremented: the increment has to wait for the result,
+            // otherwise another worker connection might run the select first
+            PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_FAILEDLOGINS);
             stmt->setString(0, _login);
-            LoginDatabase.Execute(stmt);
+            _AsyncQuery(stmt, &AuthSocket::_LogonProofFailedLoginsCallback);
+        }
+    }
 
-            stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_FAILEDLOGINS);
-            stmt->setString(0, _login);
+    return true;
+}
 
-            if (PreparedQueryResult loginfail = LoginDatabase.Query(stmt))
-            {
-                uint32 failed_logins = (*loginfail)[1].GetUInt32();
+void AuthSocket::_LogonProofFailedLoginsCallback(PreparedQueryResult result)
+{
+    //Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_FAILEDLOGINS);
+    stmt->setString(0, _login);
+    LoginDatabase.Execute(stmt);
 
-                if (failed_logins >= MaxWrongPassCount)
-                {
-                    uint32 WrongPassBanTime = sConfigMgr->GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfigMgr->GetBoolDefault("WrongPass.BanType", false);
-
-                    if (WrongPassBanType)
-                    {
-                        uint32 acc_id = (*loginfail)[0].GetUInt32();
-                        stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_ACCOUNT_AUTO_BANNED);
-                        stmt->setUInt32(0, acc_id);
-                        stmt->setUInt32(1, WrongPassBanTime);
-                        LoginDatabase.Execute(stmt);
-
-                        IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                            socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_IP_AUTO_BANNED);
-                        stmt->setString(0, socket().getRemoteAddress());
-                        stmt->setUInt32(1, WrongPassBanTime);
-                        LoginDatabase.Execute(stmt);
-
-                        IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                            socket().getRemoteAddress().c_str(), socket().getRemotePort(), socket().getRemoteAddress().c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
-                }
-            }
-        }
+    if (!result)
+        return;
+
+    uint32 MaxWrongPassCount = sConfigMgr->GetIntDefault("WrongPass.MaxCount", 0);
+    uint32 failed_logins = (*result)[1].GetUInt32() + 1;
+
+    if (failed_logins < MaxWrongPassCount)
+        return;
+
+    uint32 WrongPassBanTime = sConfigMgr->GetIntDefault("WrongPass.BanTime", 600);
+    bool WrongPassBanType = sConfigMgr->GetBoolDefault("WrongPass.BanType", false);
+
+    if (WrongPassBanType)
+    {
+        uint32 acc_id = (*result)[0].GetUInt32();
+        stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_ACCOUNT_AUTO_BANNED);
+        stmt->setUInt32(0, acc_id);
+        stmt->setUInt32(1, WrongPassBanTime);
+        LoginDatabase.Execute(stmt);
+
+        IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+            socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str(), WrongPassBanTime, failed_logins);
     }
+    else
+    {
+        stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_IP_AUTO_BANNED);
+        stmt->setString(0, socket().getRemoteAddress());
+        stmt->setUInt32(1, WrongPassBanTime);
+        LoginDatabase.Execute(stmt);
 
-    return true;
+        IC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+            socket().getRemoteAddress().c_str(), socket().getRemotePort(), socket().getRemoteAddress().c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
+    }
 }
 
 // Reconnect Challenge command handler
@@ -797,18 +905,6 @@ bool AuthSocket::_HandleReconnectChallenge()
 
     _login = (const char*)ch->I;
 
-    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_SESSIONKEY);
-    stmt->setString(0, _login);
-    PreparedQueryResult result = LoginDatabase.Query(stmt);
-
-    // Stop if the account is not found
-    if (!result)
-    {
-        IC_LOG_ERROR("server.authserver", "'%s:%d' [ERROR] user %s tried to login and we cannot find his session key in the database.", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str());
-        socket().shutdown();
-        return false;
-    }
-
     // Reinitialize build, expansion and the account securitylevel
     _build = ch->build;
     _expversion = uint8(AuthHelper::IsPostBCAcceptedClientBuild(_build) ? POST_BC_EXP_FLAG : (AuthHelper::IsPreBCAcceptedClientBuild(_build) ? PRE_BC_EXP_FLAG : NO_VALID_EXP_FLAG));
@@ -820,7 +916,24 @@ bool AuthSocket::_HandleReconnectChallenge()
     // Restore string order as its byte order is reversed
     std::reverse(_os.begin(), _os.end());
 
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_SESSIONKEY);
+    stmt->setString(0, _login);
+    _AsyncQuery(stmt, &AuthSocket::_ReconnectChallengeCallback);
+    return true;
+}
+
+void AuthSocket::_ReconnectChallengeCallback(PreparedQueryResult result)
+{
+    // Stop if the account is not found
+    if (!result)
+    {
+        IC_LOG_ERROR("server.authserver", "'%s:%d' [ERROR] user %s tried to login and we cannot find his session key in the database.", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str());
+        socket().shutdown();
+        return;
+    }
+
     Field* fields = result->Fetch();
+    _accountId = fields[1].GetUInt32();
     uint8 secLevel = fields[2].GetUInt8();
     _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
 
@@ -834,7 +947,6 @@ bool AuthSocket::_HandleReconnectChallenge()
     pkt.append(_reconnectProof.AsByteArray(16).get(), 16);        // 16 bytes random
     pkt << uint64(0x00) << uint64(0x00);                    // 16 bytes zeros
     socket().send((char const*)pkt.contents(), pkt.size());
-    return true;
 }
 
 // Reconnect Proof command handler
@@ -908,58 +1020,62 @@ bool AuthSocket::_HandleRealmList()
 
     socket().recv_skip(5);
 
-    // Get the user id (else close the connection)
-    // No SQL injection (prepared statement)
-    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_ACCOUNT_ID_BY_NAME);
-    stmt->setString(0, _login);
-    PreparedQueryResult result = LoginDatabase.Query(stmt);
-    if (!result)
+    // Answer with the cached character counts, they are refreshed in the background once they got old
+    uint32 updateDelay = sConfigMgr->GetIntDefault("RealmCharactersUpdateDelay", 10);
+    QueryCallback callback = &AuthSocket::_RealmListCallback;
+    if (_realmCharactersTime && updateDelay)
     {
-        IC_LOG_ERROR("server.authserver", "'%s:%d' [ERROR] user %s tried to login but we cannot find him in the database.", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _login.c_str());
-        socket().shutdown();
-        return false;
+        _SendRealmList();
+        if (time(NULL) < time_t(_realmCharactersTime + updateDelay))
+            return true;
+
+        callback = &AuthSocket::_RealmCharactersCallback;
     }
 
-    Field* fields = result->Fetch();
-    uint32 id = fields[0].GetUInt32();
+    // No SQL injection (prepared statement)
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_REALM_CHARACTERS);
+    stmt->setUInt32(0, _accountId);
+    _AsyncQuery(stmt, callback);
+    return true;
+}
 
-    // Update realm list if need
-    sRealmList->UpdateIfNeed();
+void AuthSocket::_RealmListCallback(PreparedQueryResult result)
+{
+    _RealmCharactersCallback(result);
+    _SendRealmList();
+}
 
+void AuthSocket::_RealmCharactersCallback(PreparedQueryResult result)
+{
+    _realmCharacters.clear();
+    _realmCharactersTime = time(NULL);
+
+    if (!result)
+        return;
+
+    do
+    {
+        Field* fields = result->Fetch();
+        _realmCharacters[fields[0].GetUInt32()] = fields[1].GetUInt8();
+    }
+    while (result->NextRow());
+}
+
+void AuthSocket::_SendRealmList()
+{
     ACE_INET_Addr clientAddr;
     socket().peer().get_remote_addr(clientAddr);
 
     // Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
 
-    size_t RealmListSize = 0;
-    for (RealmList::RealmMap::const_iterator i = sRealmList->begin(); i != sRealmList->end(); ++i)
-    {
-        const Realm &realm = i->second;
-        // don't work with realms which not compatible with the client
-        bool okBuild = ((_expversion & POST_BC_EXP_FLAG) && realm.gamebuild == _build) || ((_expversion & PRE_BC_EXP_FLAG) && !AuthHelper::IsPreBCAcceptedClientBuild(realm.gamebuild));
-
-        // No SQL injection. id of realm is controlled by the database.
-        uint32 flag = realm.flag;
-        RealmBuildInfo const* buildInfo = AuthHelper::GetBuildInfo(realm.gamebuild);
-        if (!okBuild)
-        {
-            if (!buildInfo)
-                continue;
-
-            flag |= REALM_FLAG_OFFLINE | REALM_FLAG_SPECIFYBUILD;   // tell the client what build the realm is for
-        }
+    ACE_Thread_Mutex& realmListLock = sRealmList->GetLock();
+    ACE_GUARD(ACE_Thread_Mutex, guard, realmListLock);
 
-        if (!buildInfo)
-            flag &= ~REALM_FLAG_SPECIFYBUILD;
-
-        std::string name = i->first;
-        if (_expversion & PRE_BC_EXP_FLAG && flag & REALM_FLAG_SPECIFYBUILD)
-        {
-            std::ostringstream ss;
-            ss << name << " (" << buildInfo->MajorVersion << '.' << buildInfo->MinorVersion << '.' << buildInfo->BugfixVersion << ')';
-            name = ss.str();
-        }
+    RealmList::RealmListCache const& realms = sRealmList->GetRealmListCache(_build);
+    for (RealmList::RealmListCache::const_iterator i = realms.begin(); i != realms.end(); ++i)
+    {
+        Realm const& realm = *i->RealmInfo;
 
         // We don't need the port number from which client connects with but the realm's port
         clientAddr.set_port_number(realm.ExternalAddress.get_port_number());
@@ -967,38 +1083,23 @@ bool AuthSocket::_HandleRealmList()
         uint8 lock = (realm.allowedSecurityLevel > _accountSecurityLevel) ? 1 : 0;
 
         uint8 AmountOfCharacters = 0;
-        stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_NUM_CHARS_ON_REALM);
-        stmt->setUInt32(0, realm.m_ID);
-        stmt->setUInt32(1, id);
-        result = LoginDatabase.Query(stmt);
-        if (result)
-            AmountOfCharacters = (*result)[0].GetUInt8();
-
-        pkt << realm.icon;                                  // realm type
+        std::map<uint32, uint8>::const_iterator characters = _realmCharacters.find(realm.m_ID);
+        if (characters != _realmCharacters.end())
+            AmountOfCharacters = characters->second;
+
+        pkt.append(i->Head);
         if (_expversion & POST_BC_EXP_FLAG)                 // only 2.x and 3.x clients
             pkt << lock;                                    // if 1, then realm locked
-        pkt << uint8(flag);                                 // RealmFlags
-        pkt << name;
+        pkt.append(i->Body);
         pkt << GetAddressString(GetAddressForClient(realm, clientAddr));
         pkt << realm.populationLevel;
         pkt << AmountOfCharacters;
-        pkt << realm.timezone;                              // realm category
-        if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
-            pkt << uint8(0x2C);                             // unk, may be realm number/id?
-        else
-            pkt << uint8(0x0);                              // 1.12.1 and 1.12.2 clients
-
-        if (_expversion & POST_BC_EXP_FLAG && flag & REALM_FLAG_SPECIFYBUILD)
-        {
-            pkt << uint8(buildInfo->MajorVersion);
-            pkt << uint8(buildInfo->MinorVersion);
-            pkt << uint8(buildInfo->BugfixVersion);
-            pkt << uint16(buildInfo->Build);
-        }
-
-        ++RealmListSize;
+        pkt.append(i->Tail);
     }
 
+    size_t RealmListSize = realms.size();
+    guard.release();
+
     if (_expversion & POST_BC_EXP_FLAG)                     // 2.x and 3.x clients
     {
         pkt << uint8(0x10);
@@ -1025,8 +1126,6 @@ bool AuthSocket::_HandleRealmList()
     hdr.append(pkt);                                        // append realms in the realmlist
 
     socket().send((char const*)hdr.contents(), hdr.size());
-
-    return true;
 }
 
 // Resume patch transfer
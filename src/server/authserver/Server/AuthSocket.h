@@ -19,15 +19,23 @@
 #ifndef _AUTHSOCKET_H
 #define _AUTHSOCKET_H
 
+#include <ace/Future.h>
 #include "Common.h"
 #include "BigNumber.h"
 #include "RealmSocket.h"
+#include "Database/DatabaseEnv.h"
 
 class ACE_INET_Addr;
 struct Realm;
 
-// Handle login commands
-class AuthSocket: public RealmSocket::Session
+/**
+    Handle login commands
+
+    LoginDatabase is only queried asynchronously: a handler starts the query with _AsyncQuery
+    and returns, further input is left in the socket buffer until the result came back and the
+    callback continued the handshake in OnQueryResult.
+*/
+class AuthSocket: public RealmSocket::Session, public ACE_Future_Observer<PreparedQueryResult>
 {
 public:
     const static int s_BYTE_SIZE = 32;
@@ -38,6 +46,10 @@ public:
     virtual void OnRead(void);
     virtual void OnAccept(void);
     virtual void OnClose(void);
+    virtual void OnQueryResult(void);
+
+    /// Called by the database worker thread that completed the query
+    virtual void update(PreparedQueryResultFuture const& future);
 
     static ACE_INET_Addr const& GetAddressForClient(Realm const& realm, ACE_INET_Addr const& clientAddr);
 
@@ -58,9 +70,29 @@ public:
     ACE_Thread_Mutex patcherLock;
 
 private:
+    typedef void (AuthSocket::*QueryCallback)(PreparedQueryResult result);
+
+    void _AsyncQuery(PreparedStatement* stmt, QueryCallback callback);
+
+    void _SendLogonChallengeError(uint8 error);
+    void _LogonChallengeIpBanCallback(PreparedQueryResult result);
+    void _LogonChallengeAccountCallback(PreparedQueryResult result);
+    void _LogonChallengeCountryCallback(PreparedQueryResult result);
+    void _LogonChallengeCheckAccountBan();
+    void _LogonChallengeAccountBanCallback(PreparedQueryResult result);
+    void _LogonProofFailedLoginsCallback(PreparedQueryResult result);
+    void _ReconnectChallengeCallback(PreparedQueryResult result);
+    void _RealmListCallback(PreparedQueryResult result);
+    void _RealmCharactersCallback(PreparedQueryResult result);
+    void _SendRealmList();
+
     RealmSocket& socket_;
     RealmSocket& socket(void) { return socket_; }
 
+    PreparedQueryResultFuture _queryFuture;
+    QueryCallback _queryCallback;                           // set while a query is running
+    PreparedQueryResult _accountResult;                     // LOGIN_SEL_LOGONCHALLENGE row, kept during the logon challenge
+
     BigNumber N, s, g, v;
     BigNumber b, B;
     BigNumber K;
@@ -70,6 +102,11 @@ private:
 
     std::string _login;
     std::string _tokenKey;
+    uint32 _accountId;
+
+    // character count per realm id of the account, refreshed in the background while the client polls the realm list
+    std::map<uint32, uint8> _realmCharacters;
+    time_t _realmCharactersTime;
 
     // Since GetLocaleByName() is _NOT_ bijective, we have to store the locale as a string. Otherwise we can't differ
     // between enUS and enGB, which is important for the patch system
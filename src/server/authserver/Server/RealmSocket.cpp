@@ -19,10 +19,77 @@
 #include <ace/OS_NS_string.h>
 #include <ace/INET_Addr.h>
 #include <ace/SString.h>
+#include <ace/Reactor.h>
 
 #include "RealmSocket.h"
 #include "Log.h"
 
+namespace
+{
+    /**
+        Sockets whose query completed, waiting for Session::OnQueryResult.
+
+        At most one reactor notification is pending for the whole queue, so the notification
+        pipe can't fill up with completions and notify never has to wait for it. Should even
+        that notification fail, the sockets stay queued until RealmSocket::dispatch_completed
+        or the next completion picks them up.
+    */
+    class CompletedQueries : public ACE_Event_Handler
+    {
+    public:
+        CompletedQueries() : _notifyPending(false) { }
+
+        bool Push(RealmSocket* socket)
+        {
+            // released once the socket is dispatched
+            socket->add_reference();
+
+            {
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, false);
+                _sockets.push_back(socket);
+                if (_notifyPending)
+                    return true;
+
+                _notifyPending = true;
+            }
+
+            // never wait on the notification pipe, we may be running in the reactor thread itself
+            ACE_Time_Value timeout(ACE_Time_Value::zero);
+            if (socket->reactor()->notify(this, ACE_Event_Handler::EXCEPT_MASK, &timeout) != -1)
+                return true;
+
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, false);
+            _notifyPending = false;
+            return false;
+        }
+
+        int handle_exception(ACE_HANDLE)
+        {
+            std::vector<RealmSocket*> sockets;
+            {
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, 0);
+                sockets.swap(_sockets);
+                _notifyPending = false;
+            }
+
+            for (std::vector<RealmSocket*>::const_iterator itr = sockets.begin(); itr != sockets.end(); ++itr)
+            {
+                (*itr)->handle_exception();
+                (*itr)->remove_reference();
+            }
+
+            return 0;
+        }
+
+    private:
+        ACE_Thread_Mutex _lock;
+        std::vector<RealmSocket*> _sockets;
+        bool _notifyPending;
+    };
+
+    CompletedQueries completedQueries;
+}
+
 RealmSocket::Session::Session(void) { }
 
 RealmSocket::Session::~Session(void) { }
@@ -203,6 +270,8 @@ int RealmSocket::handle_output(ACE_HANDLE)
     if (closing_)
         return -1;
 
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, session_lock_, -1);
+
     ACE_Message_Block* mb = 0;
 
     if (msg_queue()->is_empty())
@@ -244,14 +313,18 @@ int RealmSocket::handle_output(ACE_HANDLE)
 
 int RealmSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
 {
-    // As opposed to WorldSocket::handle_close, we don't need locks here.
+    // the other handlers bail out on closing_, one may still be running in another reactor thread
     closing_ = true;
 
     if (h == ACE_INVALID_HANDLE)
         peer().close_writer();
 
-    if (session_)
-        session_->OnClose();
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, session_lock_, -1);
+
+        if (session_)
+            session_->OnClose();
+    }
 
     reactor()->remove_handler(this, ACE_Event_Handler::DONT_CALL | ACE_Event_Handler::ALL_EVENTS_MASK);
     return 0;
@@ -262,6 +335,8 @@ int RealmSocket::handle_input(ACE_HANDLE)
     if (closing_)
         return -1;
 
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, session_lock_, -1);
+
     const ssize_t space = input_buffer_.space();
 
     ssize_t n = peer().recv(input_buffer_.wr_ptr(), space);
@@ -283,6 +358,35 @@ int RealmSocket::handle_input(ACE_HANDLE)
     return n == space ? 1 : 0;
 }
 
+int RealmSocket::handle_exception(ACE_HANDLE)
+{
+    if (closing_)
+        return 0;
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, session_lock_, -1);
+
+    if (session_ != NULL)
+    {
+        session_->OnQueryResult();
+
+        // handle the input that arrived while the query was running
+        session_->OnRead();
+        input_buffer_.crunch();
+    }
+
+    return 0;
+}
+
+bool RealmSocket::notify(void)
+{
+    return completedQueries.Push(this);
+}
+
+void RealmSocket::dispatch_completed(void)
+{
+    completedQueries.handle_exception(ACE_INVALID_HANDLE);
+}
+
 void RealmSocket::set_session(Session* session)
 {
     delete session_;
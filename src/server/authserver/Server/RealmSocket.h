@@ -24,6 +24,7 @@
 #include <ace/SOCK_Stream.h>
 #include <ace/Message_Block.h>
 #include <ace/Basic_Types.h>
+#include <ace/Thread_Mutex.h>
 #include "Common.h"
 
 class RealmSocket : public ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH>
@@ -41,6 +42,8 @@ public:
         virtual void OnRead(void) = 0;
         virtual void OnAccept(void) = 0;
         virtual void OnClose(void) = 0;
+        /// Called in the reactor once a query started by the session completed, see RealmSocket::notify
+        virtual void OnQueryResult(void) = 0;
     };
 
     RealmSocket(void);
@@ -66,6 +69,16 @@ public:
 
     virtual int handle_close(ACE_HANDLE = ACE_INVALID_HANDLE, ACE_Reactor_Mask = ACE_Event_Handler::ALL_EVENTS_MASK);
 
+    /// Dispatches Session::OnQueryResult
+    virtual int handle_exception(ACE_HANDLE = ACE_INVALID_HANDLE);
+
+    /// Safe to call from any thread and never blocks, the session gets OnQueryResult in a reactor thread.
+    /// Returns false if the reactor could not be woken up, the session is then served by dispatch_completed.
+    bool notify(void);
+
+    /// Serves the sessions whose notification could not be delivered, called periodically by the reactor loop
+    static void dispatch_completed(void);
+
     void set_session(Session* session);
 
 private:
@@ -73,6 +86,8 @@ private:
 
     ACE_Message_Block input_buffer_;
     Session* session_;
+    // the reactor may run in several threads and does not serialize notifications with I/O events
+    ACE_Thread_Mutex session_lock_;
     std::string _remoteAddress;
     uint16 _remotePort;
 };
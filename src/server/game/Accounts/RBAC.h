@@ -678,6 +678,9 @@ enum RBACPermissions
     RBAC_PERM_COMMAND_WP_UNLOAD                              = 772,
     RBAC_PERM_COMMAND_WP_RELOAD                              = 773,
     RBAC_PERM_COMMAND_WP_SHOW                                = 774,
+    RBAC_PERM_COMMAND_DEBUG_OPCODESTATS                      = 775,
+    RBAC_PERM_COMMAND_DEBUG_TICKPROFILE                      = 776,
+    RBAC_PERM_COMMAND_DEBUG_DBSTATS                          = 777,
 
     // custom permissions 1000+
     RBAC_PERM_MAX
@@ -26,6 +26,9 @@
 #include "UnitEvents.h"
 #include "SpellAuras.h"
 #include "SpellMgr.h"
+#include "TickProfiler.h"
+
+#include <algorithm>
 
 //==============================================================
 //================= ThreatCalcHelper ===========================
@@ -99,6 +102,8 @@ HostileReference::HostileReference(Unit* refUnit, ThreatManager* threatManager,
     iUnitGuid = refUnit->GetGUID();
     iOnline = true;
     iAccessible = true;
+    iHeapIndex = 0;
+    iHeapSerial = 0;
 }
 
 //============================================================
@@ -259,6 +264,8 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iHeap.clear();
+    iRefsByGuid.clear();
 }
 
 //============================================================
@@ -268,15 +275,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return NULL;
 
-    uint64 const guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
-    }
-
-    return NULL;
+    UNORDERED_MAP<uint64, HostileReference*>::const_iterator itr = iRefsByGuid.find(victim->GetGUID());
+    return itr != iRefsByGuid.end() ? itr->second : NULL;
 }
 
 //============================================================
@@ -298,6 +298,142 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
         ref->addThreatPercent(percent);
 }
 
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    if (contains(hostileRef))
+        return;
+
+    hostileRef->iHeapSerial = iNextSerial++;
+    iThreatList.push_back(hostileRef);
+    iRefsByGuid[hostileRef->getUnitGuid()] = hostileRef;
+
+    iHeap.push_back(hostileRef);
+    hostileRef->iHeapIndex = iHeap.size() - 1;
+    heapSiftUp(hostileRef->iHeapIndex);
+
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    if (!contains(hostileRef))
+        return;
+
+    iThreatList.remove(hostileRef);
+
+    UNORDERED_MAP<uint64, HostileReference*>::iterator itr = iRefsByGuid.find(hostileRef->getUnitGuid());
+    if (itr != iRefsByGuid.end() && itr->second == hostileRef)
+        iRefsByGuid.erase(itr);
+
+    // move the last element into the hole and restore the heap order around it
+    HostileReference* last = iHeap.back();
+    iHeap.pop_back();
+    if (last != hostileRef)
+    {
+        heapSet(hostileRef->iHeapIndex, last);
+        heapSiftUp(last->iHeapIndex);
+        heapSiftDown(last->iHeapIndex);
+    }
+}
+
+//============================================================
+
+void ThreatContainer::threatChanged(HostileReference* hostileRef)
+{
+    if (!contains(hostileRef))
+        return;
+
+    heapSiftUp(hostileRef->iHeapIndex);
+    heapSiftDown(hostileRef->iHeapIndex);
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::heapSet(uint32 index, HostileReference* hostileRef)
+{
+    iHeap[index] = hostileRef;
+    hostileRef->iHeapIndex = index;
+}
+
+void ThreatContainer::heapSiftUp(uint32 index)
+{
+    HostileReference* ref = iHeap[index];
+    while (index > 0)
+    {
+        uint32 parent = (index - 1) / 2;
+        if (!isHigher(ref, iHeap[parent]))
+            break;
+
+        heapSet(index, iHeap[parent]);
+        index = parent;
+    }
+
+    heapSet(index, ref);
+}
+
+void ThreatContainer::heapSiftDown(uint32 index)
+{
+    HostileReference* ref = iHeap[index];
+    uint32 size = iHeap.size();
+    while (true)
+    {
+        uint32 child = 2 * index + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && isHigher(iHeap[child + 1], iHeap[child]))
+            ++child;
+
+        if (!isHigher(iHeap[child], ref))
+            break;
+
+        heapSet(index, iHeap[child]);
+        index = child;
+    }
+
+    heapSet(index, ref);
+}
+
+//============================================================
+// Orders heap positions by the threat of their references, highest on top
+
+struct ThreatContainer::WalkOrder
+{
+    explicit WalkOrder(std::vector<HostileReference*> const& heap) : Heap(heap) { }
+
+    bool operator()(uint32 left, uint32 right) const
+    {
+        return ThreatContainer::isHigher(Heap[right], Heap[left]);
+    }
+
+    std::vector<HostileReference*> const& Heap;
+};
+
+HostileReference* ThreatContainer::nextByThreat(std::vector<uint32>& walk) const
+{
+    if (walk.empty())
+        return NULL;
+
+    // the next best reference is always the best one among the children of those already yielded
+    WalkOrder order(iHeap);
+    std::pop_heap(walk.begin(), walk.end(), order);
+    uint32 index = walk.back();
+    walk.pop_back();
+
+    for (uint32 child = 2 * index + 1; child <= 2 * index + 2 && child < iHeap.size(); ++child)
+    {
+        walk.push_back(child);
+        std::push_heap(walk.begin(), walk.end(), order);
+    }
+
+    return iHeap[index];
+}
+
 //============================================================
 // Check if the list is dirty and sort if necessary
 
@@ -319,32 +455,30 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
     bool found = false;
     bool noPriorityTargetFound = false;
 
-    ThreatContainer::StorageType::const_iterator lastRef = iThreatList.end();
-    --lastRef;
+    iWalk.clear();
+    if (!iHeap.empty())
+        iWalk.push_back(0);
 
-    for (ThreatContainer::StorageType::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
+    while (!found && (currentRef = nextByThreat(iWalk)))
     {
-        currentRef = (*iter);
-
         Unit* target = currentRef->getTarget();
         ASSERT(target);                                     // if the ref has status online the target must be there !
 
         // some units are prefered in comparison to others
         if (!noPriorityTargetFound && (target->IsImmunedToDamage(attacker->GetMeleeDamageSchoolMask()) || target->HasNegativeAuraWithInterruptFlag(AURA_INTERRUPT_FLAG_TAKE_DAMAGE)))
         {
-            if (iter != lastRef)
+            if (!iWalk.empty())
             {
                 // current victim is a second choice target, so don't compare threat with it below
                 if (currentRef == currentVictim)
                     currentVictim = NULL;
-                ++iter;
                 continue;
             }
             else
             {
                 // if we reached to this point, everyone in the threatlist is a second choice target. In such a situation the target with the highest threat should be attacked.
                 noPriorityTargetFound = true;
-                iter = iThreatList.begin();
+                iWalk.push_back(0);
                 continue;
             }
         }
@@ -353,7 +487,7 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
         {
             if (currentVictim)                              // select 1.3/1.1 better target in comparison current target
             {
-                // list sorted and and we check current target, then this is best case
+                // walked in threat order and we check current target, then this is best case
                 if (currentVictim == currentRef || currentRef->getThreat() <= 1.1f * currentVictim->getThreat())
                 {
                     if (currentVictim != currentRef && attacker->CanCreatureAttack(currentVictim->getTarget()))
@@ -377,7 +511,6 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
                 break;
             }
         }
-        ++iter;
     }
     if (!found)
         currentRef = NULL;
@@ -405,6 +538,8 @@ void ThreatManager::clearReferences()
 
 void ThreatManager::addThreat(Unit* victim, float threat, SpellSchoolMask schoolMask, SpellInfo const* threatSpell)
 {
+    TickSectionTimer sectionTimer(iOwner, MAP_SECTION_THREAT);
+
     if (!ThreatCalcHelper::isValidProcess(victim, GetOwner(), threatSpell))
         return;
 
@@ -458,7 +593,8 @@ void ThreatManager::modifyThreatPercent(Unit* victim, int32 percent)
 
 Unit* ThreatManager::getHostilTarget()
 {
-    iThreatContainer.update();
+    TickSectionTimer sectionTimer(iOwner, MAP_SECTION_THREAT);
+
     HostileReference* nextVictim = iThreatContainer.selectNextVictim(GetOwner()->ToCreature(), getCurrentVictim());
     setCurrentVictim(nextVictim);
     return getCurrentVictim() != NULL ? getCurrentVictim()->getTarget() : NULL;
@@ -522,9 +658,9 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostilRef && threatRefStatusChangeEvent->getFValue()<0.0f) ||
-                (getCurrentVictim() != hostilRef && threatRefStatusChangeEvent->getFValue()>0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // the reference is in at most one of them, an offline one may just have been moved back online
+            iThreatContainer.threatChanged(hostilRef);
+            iThreatOfflineContainer.threatChanged(hostilRef);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostilRef->isOnline())
@@ -542,8 +678,8 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
             {
                 if (getCurrentVictim() && hostilRef->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
                     setDirty(true);
-                iThreatContainer.addReference(hostilRef);
                 iThreatOfflineContainer.remove(hostilRef);
+                iThreatContainer.addReference(hostilRef);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
@@ -578,12 +714,22 @@ bool ThreatManager::isNeedUpdateToClient(uint32 time)
 // Reset all aggro without modifying the threatlist.
 void ThreatManager::resetAllAggro()
 {
-    ThreatContainer::StorageType &threatList = iThreatContainer.iThreatList;
-    if (threatList.empty())
+    if (iThreatContainer.empty())
         return;
 
-    for (ThreatContainer::StorageType::iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
-        (*itr)->setThreat(0);
+    // resetting threat may move references to the offline container, walk a copy
+    std::vector<HostileReference*> refs(iThreatContainer.iHeap);
+    for (std::vector<HostileReference*>::const_iterator itr = refs.begin(); itr != refs.end(); ++itr)
+        resetThreat(*itr);
 
     setDirty(true);
 }
+
+//============================================================
+// Drop the threat of a reference and restore its heap position
+
+void ThreatManager::resetThreat(HostileReference* hostileRef)
+{
+    hostileRef->setThreat(0);
+    iThreatContainer.threatChanged(hostileRef);
+}
@@ -23,8 +23,10 @@
 #include "SharedDefines.h"
 #include "LinkedReference/Reference.h"
 #include "UnitEvents.h"
+#include "UnorderedMap.h"
 
 #include <list>
+#include <vector>
 
 //==============================================================
 
@@ -47,6 +49,8 @@ struct ThreatCalcHelper
 //==============================================================
 class HostileReference : public Reference<Unit, ThreatManager>
 {
+        friend class ThreatContainer;
+
     public:
         HostileReference(Unit* refUnit, ThreatManager* threatManager, float threat);
 
@@ -135,11 +139,24 @@ class HostileReference : public Reference<Unit, ThreatManager>
         uint64 iUnitGuid;
         bool iOnline;
         bool iAccessible;
+
+        uint32 iHeapIndex;                                  // position in the threat heap of the owning container
+        uint32 iHeapSerial;                                 // insertion order, breaks ties between equal threat
 };
 
 //==============================================================
 class ThreatManager;
 
+/**
+    Threat references of one creature, online or offline.
+
+    Besides the list handed out to scripts, references are kept in a binary max-heap
+    ordered by threat (then by insertion order), updated in O(log n) on every threat
+    change. Victim selection walks the heap in threat order and stops as soon as the
+    110%/130% rules decide, so no full sort is needed per AI update. The list itself
+    is only re-sorted when ThreatManager hands it out, to scripts or to the threat
+    update sent to clients.
+*/
 class ThreatContainer
 {
         friend class ThreatManager;
@@ -147,7 +164,7 @@ class ThreatContainer
     public:
         typedef std::list<HostileReference*> StorageType;
 
-        ThreatContainer(): iDirty(false) { }
+        ThreatContainer(): iDirty(false), iNextSerial(0) { }
 
         ~ThreatContainer() { clearReferences(); }
 
@@ -168,31 +185,52 @@ class ThreatContainer
 
         HostileReference* getMostHated() const
         {
-            return iThreatList.empty() ? NULL : iThreatList.front();
+            return iHeap.empty() ? NULL : iHeap.front();
         }
 
         HostileReference* getReferenceByTarget(Unit* victim) const;
 
+        // sorted by threat as of the last update, highest first
         StorageType const & getThreatList() const { return iThreatList; }
 
     private:
-        void remove(HostileReference* hostileRef)
+        void remove(HostileReference* hostileRef);
+
+        void addReference(HostileReference* hostileRef);
+
+        // Restore the heap order after the threat of hostileRef changed
+        void threatChanged(HostileReference* hostileRef);
+
+        void clearReferences();
+
+        // Sort the list if necessary
+        void update();
+
+        bool contains(HostileReference const* hostileRef) const
         {
-            iThreatList.remove(hostileRef);
+            return hostileRef->iHeapIndex < iHeap.size() && iHeap[hostileRef->iHeapIndex] == hostileRef;
         }
 
-        void addReference(HostileReference* hostileRef)
+        static bool isHigher(HostileReference const* a, HostileReference const* b)
         {
-            iThreatList.push_back(hostileRef);
+            return a->iThreat > b->iThreat || (a->iThreat == b->iThreat && a->iHeapSerial < b->iHeapSerial);
         }
 
-        void clearReferences();
+        void heapSet(uint32 index, HostileReference* hostileRef);
+        void heapSiftUp(uint32 index);
+        void heapSiftDown(uint32 index);
 
-        // Sort the list if necessary
-        void update();
+        // yields the references in threat order, walk is the state kept between calls
+        struct WalkOrder;
+        HostileReference* nextByThreat(std::vector<uint32>& walk) const;
 
         StorageType iThreatList;
         bool iDirty;
+
+        std::vector<HostileReference*> iHeap;
+        UNORDERED_MAP<uint64, HostileReference*> iRefsByGuid;
+        uint32 iNextSerial;
+        mutable std::vector<uint32> iWalk;                  // reused by selectNextVictim
 };
 
 //=================================================
@@ -241,31 +279,30 @@ class ThreatManager
         // Reset all aggro of unit in threadlist satisfying the predicate.
         template<class PREDICATE> void resetAggro(PREDICATE predicate)
         {
-            ThreatContainer::StorageType &threatList = iThreatContainer.iThreatList;
-            if (threatList.empty())
+            if (iThreatContainer.empty())
                 return;
 
-            for (ThreatContainer::StorageType::iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
-            {
-                HostileReference* ref = (*itr);
+            // resetting threat may move references to the offline container, walk a copy
+            std::vector<HostileReference*> refs(iThreatContainer.iHeap);
+            for (std::vector<HostileReference*>::const_iterator itr = refs.begin(); itr != refs.end(); ++itr)
+                if (predicate((*itr)->getTarget()))
+                    resetThreat(*itr);
 
-                if (predicate(ref->getTarget()))
-                {
-                    ref->setThreat(0);
-                    setDirty(true);
-                }
-            }
+            setDirty(true);
         }
 
         // methods to access the lists from the outside to do some dirty manipulation (scriping and such)
         // I hope they are used as little as possible.
-        ThreatContainer::StorageType const & getThreatList() const { return iThreatContainer.getThreatList(); }
+        // sorts the online list first if a threat changed since it was last read
+        ThreatContainer::StorageType const & getThreatList() { iThreatContainer.update(); return iThreatContainer.getThreatList(); }
         ThreatContainer::StorageType const & getOfflineThreatList() const { return iThreatOfflineContainer.getThreatList(); }
         ThreatContainer& getOnlineContainer() { return iThreatContainer; }
         ThreatContainer& getOfflineContainer() { return iThreatOfflineContainer; }
     private:
         void _addThreat(Unit* victim, float threat);
 
+        void resetThreat(HostileReference* hostileRef);
+
         HostileReference* iCurrentVictim;
         Unit* iOwner;
         uint32 iUpdateTimer;
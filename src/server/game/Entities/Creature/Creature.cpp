@@ -143,7 +143,8 @@ bool ForcedDespawnDelayEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
 Creature::Creature(bool isWorldObject): Unit(isWorldObject), MapObject(),
 lootForPickPocketed(false), lootForBody(false), m_groupLootTimer(0), lootingGroupLowGUID(0),
 m_PlayerDamageReq(0), m_lootRecipient(0), m_lootRecipientGroup(0), m_corpseRemoveTime(0), m_respawnTime(0),
-m_respawnDelay(300), m_corpseDelay(60), m_respawnradius(0.0f), m_reactState(REACT_AGGRESSIVE),
+m_respawnDelay(300), m_corpseDelay(60), m_respawnradius(0.0f), m_throttledDiff(0), m_throttleCheckTimer(0),
+m_updateInterval(1), m_skippedUpdates(0), m_reactState(REACT_AGGRESSIVE),
 m_defaultMovementType(IDLE_MOTION_TYPE), m_DBTableGuid(0), m_equipmentId(0), m_originalEquipmentId(0), m_AlreadyCallAssistance(false),
 m_AlreadySearchedAssistance(false), m_regenHealth(true), m_AI_locked(false), m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL),
 m_originalEntry(0), m_homePosition(), m_transportHomePosition(), m_creatureInfo(NULL), m_creatureData(NULL), m_waypointID(0), m_path_id(0), m_formation(NULL)
@@ -426,6 +427,9 @@ bool Creature::UpdateEntry(uint32 Entry, uint32 team, const CreatureData* data)
 
 void Creature::Update(uint32 diff)
 {
+    if (!UpdateThrottle(diff))
+        return;
+
     if (IsAIEnabled && TriggerJustRespawned)
     {
         TriggerJustRespawned = false;
@@ -573,6 +577,49 @@ void Creature::Update(uint32 diff)
     sScriptMgr->OnCreatureUpdate(this, diff);
 }
 
+bool Creature::UpdateThrottle(uint32& diff)
+{
+    if (!sWorld->getBoolConfig(CONFIG_CREATURE_UPDATE_THROTTLE_ENABLE))
+        m_updateInterval = 1;
+    // fighting, evading, controlled or scripted as active creatures stay on every tick
+    else if (IsInCombat() || IsInEvadeMode() || isActiveObject() || GetCharmerOrOwnerGUID() || m_movedPlayer)
+    {
+        m_updateInterval = 1;
+        m_throttleCheckTimer = 0;
+    }
+    else if (m_throttleCheckTimer <= diff)
+    {
+        m_updateInterval = SelectUpdateInterval();
+        m_throttleCheckTimer = sWorld->getIntConfig(CONFIG_CREATURE_UPDATE_THROTTLE_CHECK_DELAY);
+    }
+    else
+        m_throttleCheckTimer -= diff;
+
+    m_throttledDiff += diff;
+    if (++m_skippedUpdates < m_updateInterval)
+        return false;
+
+    diff = m_throttledDiff;
+    m_throttledDiff = 0;
+    m_skippedUpdates = 0;
+    return true;
+}
+
+uint8 Creature::SelectUpdateInterval() const
+{
+    float nearDist = sWorld->getFloatConfig(CONFIG_CREATURE_UPDATE_THROTTLE_NEAR_DISTANCE);
+    float farDist = sWorld->getFloatConfig(CONFIG_CREATURE_UPDATE_THROTTLE_FAR_DISTANCE);
+
+    Player* player = SelectNearestPlayer(farDist);
+    if (!player)
+        return uint8(sWorld->getIntConfig(CONFIG_CREATURE_UPDATE_THROTTLE_FAR_INTERVAL));
+
+    if (IsWithinDistInMap(player, nearDist))
+        return 1;
+
+    return uint8(sWorld->getIntConfig(CONFIG_CREATURE_UPDATE_THROTTLE_MID_INTERVAL));
+}
+
 void Creature::RegenerateMana()
 {
     uint32 curValue = GetPower(POWER_MANA);
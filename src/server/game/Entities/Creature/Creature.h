@@ -680,6 +680,10 @@ class Creature : public Unit, public GridObject<Creature>, public MapObject
 
         static float _GetHealthMod(int32 Rank);
 
+        /// Returns false if this tick's update is skipped, otherwise diff includes the skipped time
+        bool UpdateThrottle(uint32& diff);
+        uint8 SelectUpdateInterval() const;
+
         uint64 m_lootRecipient;
         uint32 m_lootRecipientGroup;
 
@@ -689,6 +693,10 @@ class Creature : public Unit, public GridObject<Creature>, public MapObject
         uint32 m_respawnDelay;                              // (secs) delay between corpse disappearance and respawning
         uint32 m_corpseDelay;                               // (secs) delay between death and corpse disappearance
         float m_respawnradius;
+        uint32 m_throttledDiff;                             // (msecs) time of the updates skipped by the update throttle
+        uint32 m_throttleCheckTimer;                        // (msecs) until the update interval is chosen again
+        uint8 m_updateInterval;                             // map ticks between two updates, 1 - every tick
+        uint8 m_skippedUpdates;
 
         ReactStates m_reactState;                           // for AI, not charmInfo
         void RegenerateMana();
@@ -20,6 +20,7 @@
 #define _PLAYER_H
 
 #include "DBCStores.h"
+#include "FlatSet.h"
 #include "GroupReference.h"
 #include "MapReference.h"
 
@@ -2054,7 +2055,7 @@ class Player : public Unit, public GridObject<Player>
         WorldLocation GetStartPosition() const;
 
         // currently visible objects at player client
-        typedef std::set<uint64> ClientGUIDs;
+        typedef FlatSet<uint64> ClientGUIDs;
         ClientGUIDs m_clientGUIDs;
 
         bool HaveAtClient(WorldObject const* u) const;
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuraModifierCache.h"
+
+AuraModifierCache::Entry const* AuraModifierCache::Find(uint32 auraType, AuraModifierCacheKind kind, uint32 misc) const
+{
+    EntryMap::const_iterator itr = _entries.find(auraType);
+    if (itr == _entries.end())
+        return NULL;
+
+    for (EntryList::const_iterator entry = itr->second.begin(); entry != itr->second.end(); ++entry)
+        if (entry->Kind == uint32(kind) && entry->Misc == misc)
+            return &*entry;
+
+    return NULL;
+}
+
+AuraModifierCache::Entry& AuraModifierCache::Insert(uint32 auraType, AuraModifierCacheKind kind, uint32 misc)
+{
+    EntryList& entries = _entries[auraType];
+    for (EntryList::iterator entry = entries.begin(); entry != entries.end(); ++entry)
+        if (entry->Kind == uint32(kind) && entry->Misc == misc)
+            return *entry;
+
+    Entry entry;
+    entry.Kind = kind;
+    entry.Misc = misc;
+    entry.Value.Int = 0;
+    entries.push_back(entry);
+    return entries.back();
+}
+
+bool AuraModifierCache::Get(uint32 auraType, AuraModifierCacheKind kind, uint32 misc, int32& value) const
+{
+    Entry const* entry = Find(auraType, kind, misc);
+    if (!entry)
+        return false;
+
+    value = entry->Value.Int;
+    return true;
+}
+
+bool AuraModifierCache::Get(uint32 auraType, AuraModifierCacheKind kind, uint32 misc, float& value) const
+{
+    Entry const* entry = Find(auraType, kind, misc);
+    if (!entry)
+        return false;
+
+    value = entry->Value.Float;
+    return true;
+}
+
+void AuraModifierCache::Set(uint32 auraType, AuraModifierCacheKind kind, uint32 misc, int32 value)
+{
+    Insert(auraType, kind, misc).Value.Int = value;
+}
+
+void AuraModifierCache::Set(uint32 auraType, AuraModifierCacheKind kind, uint32 misc, float value)
+{
+    Insert(auraType, kind, misc).Value.Float = value;
+}
+
+void AuraModifierCache::Invalidate(uint32 auraType)
+{
+    // keep the vector, the same aggregates are usually asked for again right away
+    EntryMap::iterator itr = _entries.find(auraType);
+    if (itr != _entries.end())
+        itr->second.clear();
+}
+
+void AuraModifierCache::Reset(uint32 version)
+{
+    _entries.clear();
+    _version = version;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_AURAMODIFIERCACHE_H
+#define INFINITY_AURAMODIFIERCACHE_H
+
+#include "Define.h"
+#include "UnorderedMap.h"
+#include <vector>
+
+/// Aggregates of Unit::m_modAuras[type] that can be cached, see Unit::GetTotalAuraModifier and friends
+enum AuraModifierCacheKind
+{
+    AURA_MOD_CACHE_TOTAL,
+    AURA_MOD_CACHE_MULTIPLIER,
+    AURA_MOD_CACHE_MAX_POSITIVE,
+    AURA_MOD_CACHE_MAX_NEGATIVE,
+    AURA_MOD_CACHE_TOTAL_BY_MISC_MASK,
+    AURA_MOD_CACHE_MULTIPLIER_BY_MISC_MASK,
+    AURA_MOD_CACHE_MAX_POSITIVE_BY_MISC_MASK,
+    AURA_MOD_CACHE_MAX_NEGATIVE_BY_MISC_MASK,
+    AURA_MOD_CACHE_TOTAL_BY_MISC_VALUE,
+    AURA_MOD_CACHE_MULTIPLIER_BY_MISC_VALUE,
+    AURA_MOD_CACHE_MAX_POSITIVE_BY_MISC_VALUE,
+    AURA_MOD_CACHE_MAX_NEGATIVE_BY_MISC_VALUE
+};
+
+/**
+    Lazily computed aggregates of the aura effects of one unit, keyed by (aura type, kind, misc).
+
+    Values are kept until an effect of their aura type is registered, unregistered or changes
+    its amount, Invalidate() then drops every value of that type at once. Entries of a type are
+    stored in one small vector, a lookup is a hash of the aura type plus a short linear scan.
+*/
+class AuraModifierCache
+{
+    struct Entry
+    {
+        uint32 Kind;
+        uint32 Misc;
+        union
+        {
+            int32 Int;
+            float Float;
+        } Value;
+    };
+
+    typedef std::vector<Entry> EntryList;
+    typedef UNORDERED_MAP<uint32, EntryList> EntryMap;
+
+    public:
+        AuraModifierCache() : _version(0) { }
+
+        bool Get(uint32 auraType, AuraModifierCacheKind kind, uint32 misc, int32& value) const;
+        bool Get(uint32 auraType, AuraModifierCacheKind kind, uint32 misc, float& value) const;
+        void Set(uint32 auraType, AuraModifierCacheKind kind, uint32 misc, int32 value);
+        void Set(uint32 auraType, AuraModifierCacheKind kind, uint32 misc, float value);
+
+        void Invalidate(uint32 auraType);
+
+        /// Spell group data version the values were computed with, Reset() drops all of them
+        uint32 GetVersion() const { return _version; }
+        void Reset(uint32 version);
+
+    private:
+        Entry const* Find(uint32 auraType, AuraModifierCacheKind kind, uint32 misc) const;
+        Entry& Insert(uint32 auraType, AuraModifierCacheKind kind, uint32 misc);
+
+        EntryMap _entries;
+        uint32 _version;
+};
+
+#endif
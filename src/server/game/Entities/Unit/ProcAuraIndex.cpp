@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProcAuraIndex.h"
+
+#include <algorithm>
+
+namespace
+{
+    struct ProcAuraOrder
+    {
+        bool operator()(std::pair<uint64, AuraApplication*> const& left, std::pair<uint64, AuraApplication*> const& right) const
+        {
+            return left.first < right.first;
+        }
+    };
+}
+
+void ProcAuraIndex::Add(AuraApplication* aurApp, uint32 spellId, uint32 procFlags)
+{
+    Entry entry;
+    entry.Application = aurApp;
+    entry.ProcFlags = procFlags;
+    entry.SpellId = spellId;
+    entry.Serial = _nextSerial++;
+
+    for (uint8 bit = 0; bit < MAX_PROC_FLAG_BITS; ++bit)
+    {
+        if (!(procFlags & (1 << bit)))
+            continue;
+
+        _buckets[bit].push_back(entry);
+        _procFlags |= 1 << bit;
+    }
+}
+
+void ProcAuraIndex::Remove(AuraApplication* aurApp)
+{
+    for (uint8 bit = 0; bit < MAX_PROC_FLAG_BITS; ++bit)
+    {
+        if (!(_procFlags & (1 << bit)))
+            continue;
+
+        // buckets are unordered, Collect() restores the application order
+        std::vector<Entry>& bucket = _buckets[bit];
+        for (size_t i = 0; i < bucket.size(); ++i)
+        {
+            if (bucket[i].Application != aurApp)
+                continue;
+
+            bucket[i] = bucket.back();
+            bucket.pop_back();
+            break;
+        }
+
+        if (bucket.empty())
+            _procFlags &= ~(1 << bit);
+    }
+}
+
+void ProcAuraIndex::Collect(uint32 procFlag, std::vector<AuraApplication*>& auras) const
+{
+    auras.clear();
+
+    uint32 hitFlags = procFlag & _procFlags;
+    if (!hitFlags)
+        return;
+
+    std::vector<std::pair<uint64, AuraApplication*> > found;
+    for (uint8 bit = 0; bit < MAX_PROC_FLAG_BITS; ++bit)
+    {
+        if (!(hitFlags & (1 << bit)))
+            continue;
+
+        uint32 lowerBits = hitFlags & ((1 << bit) - 1);
+        std::vector<Entry> const& bucket = _buckets[bit];
+        for (std::vector<Entry>::const_iterator itr = bucket.begin(); itr != bucket.end(); ++itr)
+        {
+            // already taken from a lower bucket
+            if (itr->ProcFlags & lowerBits)
+                continue;
+
+            found.push_back(std::make_pair((uint64(itr->SpellId) << 32) | itr->Serial, itr->Application));
+        }
+    }
+
+    std::sort(found.begin(), found.end(), ProcAuraOrder());
+
+    auras.reserve(found.size());
+    for (size_t i = 0; i < found.size(); ++i)
+        auras.push_back(found[i].second);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_PROCAURAINDEX_H
+#define INFINITY_PROCAURAINDEX_H
+
+#include "Define.h"
+#include <vector>
+
+class AuraApplication;
+
+#define MAX_PROC_FLAG_BITS 25                               // PROC_FLAG_KILLED .. PROC_FLAG_DEATH
+
+/**
+    Applied auras of a unit that can proc through spell_proc_event, bucketed by proc flag bit.
+
+    An aura reacting to several proc flags is stored in each matching bucket, Collect()
+    takes it from the lowest bucket the event hits only, so every aura is returned once.
+*/
+class ProcAuraIndex
+{
+    struct Entry
+    {
+        AuraApplication* Application;
+        uint32 ProcFlags;
+        uint32 SpellId;
+        uint32 Serial;                                      // application order, ties between equal spell ids
+    };
+
+    public:
+        ProcAuraIndex() : _procFlags(0), _nextSerial(0) { }
+
+        void Add(AuraApplication* aurApp, uint32 spellId, uint32 procFlags);
+        void Remove(AuraApplication* aurApp);
+
+        bool IsEmpty() const { return !_procFlags; }
+        uint32 GetProcFlags() const { return _procFlags; }
+
+        /// Auras whose proc flags intersect procFlag, ordered like Unit::m_appliedAuras
+        void Collect(uint32 procFlag, std::vector<AuraApplication*>& auras) const;
+
+    private:
+        std::vector<Entry> _buckets[MAX_PROC_FLAG_BITS];
+        uint32 _procFlags;                                  // bits with a non empty bucket
+        uint32 _nextSerial;
+};
+
+#endif
@@ -50,6 +50,7 @@
 #include "SpellInfo.h"
 #include "SpellMgr.h"
 #include "TemporarySummon.h"
+#include "TickProfiler.h"
 #include "Totem.h"
 #include "Transport.h"
 #include "UpdateFieldFlags.h"
@@ -162,7 +163,8 @@ Unit::Unit(bool isWorldObject) :
     IsAIEnabled(false), NeedChangeAI(false), LastCharmerGUID(0),
     m_ControlledByPlayer(false), movespline(new Movement::MoveSpline()),
     i_AI(NULL), i_disabledAI(NULL), m_AutoRepeatFirstCast(false), m_procDeep(0),
-    m_removedAurasCount(0), i_motionMaster(new MotionMaster(this)), m_regenTimer(0), m_ThreatManager(this),
+    m_removedAurasCount(0), m_procAuraIndex(NULL), m_procAuraIndexVersion(sSpellMgr->GetSpellProcDataVersion()),
+    i_motionMaster(new MotionMaster(this)), m_regenTimer(0), m_ThreatManager(this),
     m_unitTypeMask(UNIT_MASK_NONE), m_HostileRefManager(this), _lastDamagedTime(0)
 
 {
@@ -293,6 +295,7 @@ Unit::~Unit()
 
     _DeleteRemovedAuras();
 
+    delete m_procAuraIndex;
     delete i_motionMaster;
     delete m_charmInfo;
     delete movespline;
@@ -1919,6 +1922,8 @@ void Unit::CalcHealAbsorb(Unit* victim, SpellInfo const* healSpell, uint32 &heal
 
 void Unit::AttackerStateUpdate (Unit* victim, WeaponAttackType attType, bool extra)
 {
+    TickSectionTimer sectionTimer(this, MAP_SECTION_MELEE);
+
     if (HasUnitState(UNIT_STATE_CANNOT_AUTOATTACK) || HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_PACIFIED))
         return;
 
@@ -2881,6 +2886,8 @@ void Unit::_DeleteRemovedAuras()
 
 void Unit::_UpdateSpells(uint32 time)
 {
+    TickSectionTimer sectionTimer(this, MAP_SECTION_AURAS);
+
     if (m_currentSpells[CURRENT_AUTOREPEAT_SPELL])
         _UpdateAutoRepeatSpell();
 
@@ -3342,6 +3349,7 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
 
     AuraApplication * aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
+    _AddProcAura(aurApp);
 
     if (aurSpellInfo->AuraInterruptFlags)
     {
@@ -3426,6 +3434,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
+    _RemoveProcAura(aurApp);
 
     if (aura->GetSpellInfo()->AuraInterruptFlags)
     {
@@ -3538,6 +3547,8 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    m_auraModifierCache.Invalidate(aurEff->GetAuraType());
 }
 
 // All aura base removes should go threw this function!
@@ -4489,12 +4500,27 @@ uint32 Unit::GetDoTsByCaster(uint64 casterGUID) const
     return dots;
 }
 
+AuraModifierCache& Unit::GetAuraModifierCache() const
+{
+    // spell groups were reloaded, same effect stack rules may have changed
+    if (m_auraModifierCache.GetVersion() != sSpellMgr->GetSpellGroupDataVersion())
+        m_auraModifierCache.Reset(sSpellMgr->GetSpellGroupDataVersion());
+
+    return m_auraModifierCache;
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
     int32 modifier = 0;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_TOTAL, 0, modifier))
+        return modifier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    std::map<SpellGroup, int32> SameEffectSpellGroup;
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
             modifier += (*i)->GetAmount();
@@ -4502,53 +4528,80 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype) const
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
+    cache.Set(auratype, AURA_MOD_CACHE_TOTAL, 0, modifier);
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 1.0f;
+
     float multiplier = 1.0f;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_MULTIPLIER, 0, multiplier))
+        return multiplier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         AddPct(multiplier, (*i)->GetAmount());
 
+    cache.Set(auratype, AURA_MOD_CACHE_MULTIPLIER, 0, multiplier);
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
     int32 modifier = 0;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_MAX_POSITIVE, 0, modifier))
+        return modifier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetAmount() > modifier)
             modifier = (*i)->GetAmount();
     }
 
+    cache.Set(auratype, AURA_MOD_CACHE_MAX_POSITIVE, 0, modifier);
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
     int32 modifier = 0;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_MAX_NEGATIVE, 0, modifier))
+        return modifier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         if ((*i)->GetAmount() < modifier)
             modifier = (*i)->GetAmount();
 
+    cache.Set(auratype, AURA_MOD_CACHE_MAX_NEGATIVE, 0, modifier);
     return modifier;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 miscMask) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    int32 modifier = 0;
-
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    int32 modifier = 0;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_TOTAL_BY_MISC_MASK, miscMask, modifier))
+        return modifier;
 
+    std::map<SpellGroup, int32> SameEffectSpellGroup;
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         if ((*i)->GetMiscValue() & miscMask)
             if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
@@ -4557,15 +4610,22 @@ int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 miscMask) c
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
+    cache.Set(auratype, AURA_MOD_CACHE_TOTAL_BY_MISC_MASK, miscMask, modifier);
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 miscMask) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 1.0f;
+
     float multiplier = 1.0f;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_MULTIPLIER_BY_MISC_MASK, miscMask, multiplier))
+        return multiplier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    std::map<SpellGroup, int32> SameEffectSpellGroup;
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if (((*i)->GetMiscValue() & miscMask))
@@ -4580,43 +4640,66 @@ float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 miscMask)
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         AddPct(multiplier, itr->second);
 
+    cache.Set(auratype, AURA_MOD_CACHE_MULTIPLIER_BY_MISC_MASK, miscMask, multiplier);
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 miscMask, const AuraEffect* except) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    // results excluding an effect are not cached
     int32 modifier = 0;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (!except && cache.Get(auratype, AURA_MOD_CACHE_MAX_POSITIVE_BY_MISC_MASK, miscMask, modifier))
+        return modifier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if (except != (*i) && (*i)->GetMiscValue()& miscMask && (*i)->GetAmount() > modifier)
             modifier = (*i)->GetAmount();
     }
 
+    if (!except)
+        cache.Set(auratype, AURA_MOD_CACHE_MAX_POSITIVE_BY_MISC_MASK, miscMask, modifier);
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 miscMask) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
     int32 modifier = 0;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_MAX_NEGATIVE_BY_MISC_MASK, miscMask, modifier))
+        return modifier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue()& miscMask && (*i)->GetAmount() < modifier)
             modifier = (*i)->GetAmount();
     }
 
+    cache.Set(auratype, AURA_MOD_CACHE_MAX_NEGATIVE_BY_MISC_MASK, miscMask, modifier);
     return modifier;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
     int32 modifier = 0;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_TOTAL_BY_MISC_VALUE, uint32(miscValue), modifier))
+        return modifier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    std::map<SpellGroup, int32> SameEffectSpellGroup;
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue() == miscValue)
@@ -4627,15 +4710,22 @@ int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 miscValue)
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
+    cache.Set(auratype, AURA_MOD_CACHE_TOTAL_BY_MISC_VALUE, uint32(miscValue), modifier);
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 miscValue) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 1.0f;
+
     float multiplier = 1.0f;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_MULTIPLIER_BY_MISC_VALUE, uint32(miscValue), multiplier))
+        return multiplier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    std::map<SpellGroup, int32> SameEffectSpellGroup;
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue() == miscValue)
@@ -4646,34 +4736,49 @@ float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 miscValue
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         AddPct(multiplier, itr->second);
 
+    cache.Set(auratype, AURA_MOD_CACHE_MULTIPLIER_BY_MISC_VALUE, uint32(miscValue), multiplier);
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
     int32 modifier = 0;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_MAX_POSITIVE_BY_MISC_VALUE, uint32(miscValue), modifier))
+        return modifier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue() == miscValue && (*i)->GetAmount() > modifier)
             modifier = (*i)->GetAmount();
     }
 
+    cache.Set(auratype, AURA_MOD_CACHE_MAX_POSITIVE_BY_MISC_VALUE, uint32(miscValue), modifier);
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
     int32 modifier = 0;
+    AuraModifierCache& cache = GetAuraModifierCache();
+    if (cache.Get(auratype, AURA_MOD_CACHE_MAX_NEGATIVE_BY_MISC_VALUE, uint32(miscValue), modifier))
+        return modifier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetMiscValue() == miscValue && (*i)->GetAmount() < modifier)
             modifier = (*i)->GetAmount();
     }
 
+    cache.Set(auratype, AURA_MOD_CACHE_MAX_NEGATIVE_BY_MISC_VALUE, uint32(miscValue), modifier);
     return modifier;
 }
 
@@ -8249,6 +8354,14 @@ void Unit::setPowerType(Powers new_powertype)
     }
 }
 
+void Unit::setFaction(uint32 faction)
+{
+    SetUInt32Value(UNIT_FIELD_FACTIONTEMPLATE, faction);
+
+    if (IsInWorld())
+        GetMap()->UpdateCellTargetFaction(this);
+}
+
 FactionTemplateEntry const* Unit::GetFactionTemplateEntry() const
 {
     FactionTemplateEntry const* entry = sFactionTemplateStore.LookupEntry(getFaction());
@@ -13328,6 +13441,8 @@ uint32 createProcExtendMask(SpellNonMeleeDamage* damageInfo, SpellMissInfo missC
 
 void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, SpellInfo const* procSpell, uint32 damage, SpellInfo const* procAura)
 {
+    TickSectionTimer sectionTimer(this, MAP_SECTION_PROCS);
+
     // Player is loaded now - do not allow passive spell casts to proc
     if (GetTypeId() == TYPEID_PLAYER && ToPlayer()->GetSession()->PlayerLoading())
         return;
@@ -13404,20 +13519,26 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     HealInfo healInfo = HealInfo(damage);
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, 0, procExtra, NULL, &damageInfo, &healInfo);
 
+    // only auras whose proc flags intersect the event can pass IsTriggeredAtSpellProcEvent
+    std::vector<AuraApplication*> procAuras;
+    GetProcAurasForEvent(procFlag, procAuras);
+
+    if (isVictim)
+        procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+
     ProcTriggeredList procTriggered;
     // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr!= GetAppliedAuras().end(); ++itr)
+    for (std::vector<AuraApplication*>::const_iterator itr = procAuras.begin(); itr != procAuras.end(); ++itr)
     {
+        AuraApplication* aurApp = *itr;
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == aurApp->GetBase()->GetId())
             continue;
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(aurApp->GetBase());
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
-        if (isVictim)
-            procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
 
         // only auras that has triggered spell should proc from fully absorbed damage
         if (procExtra & PROC_EX_ABSORB && isVictim)
@@ -13434,7 +13555,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             continue;
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptCheckProcHandlers(itr->second, eventInfo))
+        if (!triggerData.aura->CallScriptCheckProcHandlers(aurApp, eventInfo))
             continue;
 
         // Triggered spells not triggering additional spells
@@ -13443,9 +13564,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
                     continue;
@@ -14333,6 +14454,50 @@ bool Unit::InitTamedPet(Pet* pet, uint8 level, uint32 spell_id)
     return true;
 }
 
+void Unit::_AddProcAura(AuraApplication* aurApp)
+{
+    // stale index is rebuilt as a whole on the next proc event
+    if (m_procAuraIndexVersion != sSpellMgr->GetSpellProcDataVersion())
+        return;
+
+    uint32 procFlags = sSpellMgr->GetSpellProcEventFlags(aurApp->GetBase()->GetSpellInfo());
+    if (!procFlags)
+        return;
+
+    if (!m_procAuraIndex)
+        m_procAuraIndex = new ProcAuraIndex();
+
+    m_procAuraIndex->Add(aurApp, aurApp->GetBase()->GetId(), procFlags);
+}
+
+void Unit::_RemoveProcAura(AuraApplication* aurApp)
+{
+    if (m_procAuraIndex)
+        m_procAuraIndex->Remove(aurApp);
+}
+
+void Unit::GetProcAurasForEvent(uint32 procFlag, std::vector<AuraApplication*>& auras)
+{
+    // spell_proc_event or spell_proc was reloaded, proc flags of applied auras may have changed
+    if (m_procAuraIndexVersion != sSpellMgr->GetSpellProcDataVersion())
+    {
+        delete m_procAuraIndex;
+        m_procAuraIndex = NULL;
+        m_procAuraIndexVersion = sSpellMgr->GetSpellProcDataVersion();
+
+        for (AuraApplicationMap::const_iterator itr = m_appliedAuras.begin(); itr != m_appliedAuras.end(); ++itr)
+            _AddProcAura(itr->second);
+    }
+
+    if (!m_procAuraIndex)
+    {
+        auras.clear();
+        return;
+    }
+
+    m_procAuraIndex->Collect(procFlag, auras);
+}
+
 bool Unit::IsTriggeredAtSpellProcEvent(Unit* victim, Aura* aura, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const* & spellProcEvent)
 {
     SpellInfo const* spellProto = aura->GetSpellInfo();
@@ -19,13 +19,16 @@
 #ifndef __UNIT_H
 #define __UNIT_H
 
+#include "AuraModifierCache.h"
 #include "DBCStructure.h"
 #include "EventProcessor.h"
+#include "FlatMap.h"
 #include "FollowerReference.h"
 #include "FollowerRefManager.h"
 #include "HostileRefManager.h"
 #include "MotionMaster.h"
 #include "Object.h"
+#include "ProcAuraIndex.h"
 #include "SpellAuraDefines.h"
 #include "ThreatManager.h"
 
@@ -1254,7 +1257,7 @@ class Unit : public WorldObject
         typedef std::list<DiminishingReturn> Diminishing;
         typedef std::set<uint32> ComboPointHolderSet;
 
-        typedef std::map<uint8, AuraApplication*> VisibleAuraMap;
+        typedef FlatMap<uint8, AuraApplication*> VisibleAuraMap;
 
         virtual ~Unit();
 
@@ -1381,7 +1384,7 @@ class Unit : public WorldObject
 
         // faction template id
         uint32 getFaction() const { return GetUInt32Value(UNIT_FIELD_FACTIONTEMPLATE); }
-        void setFaction(uint32 faction) { SetUInt32Value(UNIT_FIELD_FACTIONTEMPLATE, faction); }
+        void setFaction(uint32 faction);
         FactionTemplateEntry const* GetFactionTemplateEntry() const;
 
         ReputationRank GetReactionTo(Unit const* target) const;
@@ -1692,6 +1695,8 @@ class Unit : public WorldObject
         void _RemoveNoStackAurasDueToAura(Aura* aura);
         bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        // drops the cached GetTotalAuraModifier & co values of an aura type, called on effect amount changes
+        void InvalidateAuraModifierCache(AuraType auratype) { m_auraModifierCache.Invalidate(auratype); }
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
@@ -2146,6 +2151,9 @@ class Unit : public WorldObject
         AuraList m_scAuras;                        // cast singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
+        ProcAuraIndex* m_procAuraIndex;            // applied auras able to proc, allocated with the first one
+        uint32 m_procAuraIndexVersion;             // SpellMgr proc data version m_procAuraIndex was built with
+        mutable AuraModifierCache m_auraModifierCache; // aggregates of m_modAuras, see GetTotalAuraModifier & co
         uint32 m_interruptMask;
 
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
@@ -2175,6 +2183,10 @@ class Unit : public WorldObject
         void DisableSpline();
     private:
         bool IsTriggeredAtSpellProcEvent(Unit* victim, Aura* aura, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const* & spellProcEvent);
+        void _AddProcAura(AuraApplication* aurApp);
+        void _RemoveProcAura(AuraApplication* aurApp);
+        void GetProcAurasForEvent(uint32 procFlag, std::vector<AuraApplication*>& auras);
+        AuraModifierCache& GetAuraModifierCache() const;
         bool HandleDummyAuraProc(Unit* victim, uint32 damage, AuraEffect* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
         bool HandleAuraProc(Unit* victim, uint32 damage, Aura* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown, bool * handled);
         bool HandleProcTriggerSpell(Unit* victim, uint32 damage, AuraEffect* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
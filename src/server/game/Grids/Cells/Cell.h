@@ -36,6 +36,17 @@ struct CellArea
 
     bool operator!() const { return low_bound == high_bound; }
 
+    bool Contains(CellCoord const& p) const
+    {
+        return p.x_coord >= low_bound.x_coord && p.x_coord <= high_bound.x_coord &&
+            p.y_coord >= low_bound.y_coord && p.y_coord <= high_bound.y_coord;
+    }
+
+    uint32 GetCellCount() const
+    {
+        return (high_bound.x_coord - low_bound.x_coord + 1) * (high_bound.y_coord - low_bound.y_coord + 1);
+    }
+
     void ResizeBorders(CellCoord& begin_cell, CellCoord& end_cell) const
     {
         begin_cell = low_bound;
@@ -111,6 +122,8 @@ struct Cell
     template<class T, class CONTAINER> void Visit(CellCoord const&, TypeContainerVisitor<T, CONTAINER>& visitor, Map &, float, float, float) const;
 
     static CellArea CalculateCellArea(float x, float y, float radius);
+    /// True if Visit() from standing_cell over area (as returned by CalculateCellArea) reaches cell p
+    static bool IsCellVisited(CellCoord const& standing_cell, CellArea const& area, CellCoord const& p);
 
 private:
     template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER> &, Map &, CellCoord const&, CellCoord const&) const;
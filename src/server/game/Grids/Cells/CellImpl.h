@@ -60,6 +60,31 @@ inline CellArea Cell::CalculateCellArea(float x, float y, float radius)
     return CellArea(centerX, centerY);
 }
 
+inline bool Cell::IsCellVisited(CellCoord const& standing_cell, CellArea const& area, CellCoord const& p)
+{
+    if (!area)
+        return p == standing_cell;
+
+    if (!area.Contains(p))
+        return false;
+
+    // same octagon as VisitCircle()
+    if ((area.high_bound.x_coord > (area.low_bound.x_coord + 4)) && (area.high_bound.y_coord > (area.low_bound.y_coord + 4)))
+    {
+        uint32 x_shift = (uint32)ceilf((area.high_bound.x_coord - area.low_bound.x_coord) * 0.3f - 0.5f);
+        uint32 x_start = area.low_bound.x_coord + x_shift;
+        uint32 x_end = area.high_bound.x_coord - x_shift;
+        if (p.x_coord >= x_start && p.x_coord <= x_end)
+            return true;
+
+        // each step away from the central strip cuts one cell at the top and the bottom
+        uint32 step = p.x_coord < x_start ? x_start - p.x_coord : p.x_coord - x_end;
+        return p.y_coord >= area.low_bound.y_coord + step && p.y_coord + step <= area.high_bound.y_coord;
+    }
+
+    return true;
+}
+
 template<class T, class CONTAINER>
 inline void Cell::Visit(CellCoord const& standing_cell, TypeContainerVisitor<T, CONTAINER>& visitor, Map& map, float radius, float x_off, float y_off) const
 {
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CellTargetIndex.h"
+#include "Cell.h"
+#include "Creature.h"
+#include "DBCStores.h"
+#include "Player.h"
+#include "TypeContainerVisitor.h"
+
+namespace
+{
+    inline CellTarget MakeTarget(Unit* unit, uint32 typeMask)
+    {
+        FactionTemplateEntry const* entry = sFactionTemplateStore.LookupEntry(unit->getFaction());
+
+        CellTarget target;
+        target.Target = unit;
+        target.TypeMask = typeMask;
+        target.FactionMask = entry ? entry->ourMask : 0;
+        return target;
+    }
+
+    struct CellTargetCollector
+    {
+        std::vector<CellTarget>& i_targets;
+
+        CellTargetCollector(std::vector<CellTarget>& targets) : i_targets(targets) { }
+
+        void Visit(PlayerMapType& m)
+        {
+            for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+                i_targets.push_back(MakeTarget(itr->GetSource(), GRID_MAP_TYPE_MASK_PLAYER));
+        }
+
+        void Visit(CreatureMapType& m)
+        {
+            for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+                i_targets.push_back(MakeTarget(itr->GetSource(), GRID_MAP_TYPE_MASK_CREATURE));
+        }
+
+        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) { }
+    };
+}
+
+CellTargetIndex::CellTargetIndex()
+{
+    memset(_grids, 0, sizeof(_grids));
+}
+
+CellTargetList* CellTargetIndex::FindCell(uint32 cellId) const
+{
+    CellCoord p(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+    GridTargets* grid = _grids[p.x_coord / MAX_NUMBER_OF_CELLS][p.y_coord / MAX_NUMBER_OF_CELLS];
+    return grid ? &grid->Cells[p.x_coord % MAX_NUMBER_OF_CELLS][p.y_coord % MAX_NUMBER_OF_CELLS] : NULL;
+}
+
+void CellTargetIndex::UpdateMasks(CellTargetList& targets)
+{
+    targets.TypeMask = 0;
+    targets.FactionMask = 0;
+    for (std::vector<CellTarget>::const_iterator itr = targets.Targets.begin(); itr != targets.Targets.end(); ++itr)
+    {
+        targets.TypeMask |= itr->TypeMask;
+        targets.FactionMask |= itr->FactionMask;
+    }
+}
+
+CellTargetList& CellTargetIndex::GetTargets(Cell const& cell, GridType& grid)
+{
+    GridTargets*& gridTargets = _grids[cell.GridX()][cell.GridY()];
+    if (!gridTargets)
+        gridTargets = new GridTargets();
+
+    CellTargetList& targets = gridTargets->Cells[cell.CellX()][cell.CellY()];
+    if (targets.Loaded)
+        return targets;
+
+    CellTargetCollector collector(targets.Targets);
+    TypeContainerVisitor<CellTargetCollector, WorldTypeMapContainer> world_object_collector(collector);
+    grid.Visit(world_object_collector);
+    TypeContainerVisitor<CellTargetCollector, GridTypeMapContainer> grid_object_collector(collector);
+    grid.Visit(grid_object_collector);
+
+    uint32 cellId = cell.GetCellCoord().GetId();
+    for (std::vector<CellTarget>::const_iterator itr = targets.Targets.begin(); itr != targets.Targets.end(); ++itr)
+        _unitCells[itr->Target] = cellId;
+
+    UpdateMasks(targets);
+    targets.Loaded = true;
+    return targets;
+}
+
+void CellTargetIndex::Add(Unit* unit, Cell const& cell)
+{
+    GridTargets* gridTargets = _grids[cell.GridX()][cell.GridY()];
+    if (!gridTargets)
+        return;
+
+    // not searched yet, the unit is found in the containers then
+    CellTargetList& targets = gridTargets->Cells[cell.CellX()][cell.CellY()];
+    if (!targets.Loaded)
+        return;
+
+    CellTarget target = MakeTarget(unit, unit->GetTypeId() == TYPEID_PLAYER ? GRID_MAP_TYPE_MASK_PLAYER : GRID_MAP_TYPE_MASK_CREATURE);
+    targets.Targets.push_back(target);
+    targets.TypeMask |= target.TypeMask;
+    targets.FactionMask |= target.FactionMask;
+    _unitCells[unit] = cell.GetCellCoord().GetId();
+}
+
+void CellTargetIndex::Remove(Unit* unit)
+{
+    UnitCellMap::iterator itr = _unitCells.find(unit);
+    if (itr == _unitCells.end())
+        return;
+
+    if (CellTargetList* targets = FindCell(itr->second))
+    {
+        for (std::vector<CellTarget>::iterator target = targets->Targets.begin(); target != targets->Targets.end(); ++target)
+        {
+            if (target->Target != unit)
+                continue;
+
+            targets->Targets.erase(target);
+            break;
+        }
+
+        UpdateMasks(*targets);
+    }
+
+    _unitCells.erase(itr);
+}
+
+void CellTargetIndex::UpdateFaction(Unit* unit)
+{
+    UnitCellMap::const_iterator itr = _unitCells.find(unit);
+    if (itr == _unitCells.end())
+        return;
+
+    CellTargetList* targets = FindCell(itr->second);
+    if (!targets)
+        return;
+
+    for (std::vector<CellTarget>::iterator target = targets->Targets.begin(); target != targets->Targets.end(); ++target)
+        if (target->Target == unit)
+            *target = MakeTarget(unit, target->TypeMask);
+
+    UpdateMasks(*targets);
+}
+
+void CellTargetIndex::UnloadGrid(uint32 x, uint32 y)
+{
+    GridTargets*& gridTargets = _grids[x][y];
+    if (!gridTargets)
+        return;
+
+    for (uint32 cellX = 0; cellX < MAX_NUMBER_OF_CELLS; ++cellX)
+        for (uint32 cellY = 0; cellY < MAX_NUMBER_OF_CELLS; ++cellY)
+        {
+            std::vector<CellTarget> const& targets = gridTargets->Cells[cellX][cellY].Targets;
+            for (std::vector<CellTarget>::const_iterator itr = targets.begin(); itr != targets.end(); ++itr)
+                _unitCells.erase(itr->Target);
+        }
+
+    delete gridTargets;
+    gridTargets = NULL;
+}
+
+void CellTargetIndex::Clear()
+{
+    for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+        for (uint32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+        {
+            delete _grids[x][y];
+            _grids[x][y] = NULL;
+        }
+
+    _unitCells.clear();
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_CELLTARGETINDEX_H
+#define INFINITY_CELLTARGETINDEX_H
+
+#include "Define.h"
+#include "GridDefines.h"
+#include "UnorderedMap.h"
+#include <vector>
+
+struct Cell;
+class Unit;
+
+/// One unit linked into a cell with the masks searchers filter on
+struct CellTarget
+{
+    Unit* Target;
+    uint32 TypeMask;                                        // GRID_MAP_TYPE_MASK_PLAYER or GRID_MAP_TYPE_MASK_CREATURE
+    uint32 FactionMask;                                     // FactionTemplateEntry::ourMask, see FactionMasks
+};
+
+/// Units linked into one cell, in link order
+struct CellTargetList
+{
+    CellTargetList() : TypeMask(0), FactionMask(0), Loaded(false) { }
+
+    std::vector<CellTarget> Targets;
+    uint32 TypeMask;                                        // union of the masks of Targets
+    uint32 FactionMask;
+    bool Loaded;                                            // Targets were collected from the cell's containers
+};
+
+/**
+    Per map spatial index of the players and creatures standing in each cell, walked by spell
+    area, cone, chain and nearby target searches instead of the cell reference lists.
+
+    Cells are grouped by grid like the map's NGrids. A cell is collected from its containers
+    the first time it is searched and from then on the map keeps it current as units are linked
+    into and unlinked from it. The cells of a grid are evicted when the grid is loaded or unloaded.
+
+    Searchers skip cells and units by type mask. The faction mask is the union of the faction
+    template team masks, it only tells which teams are present: whether a unit is a valid target
+    also depends on reputation, PvP state and charms, so searchers still check every unit.
+*/
+class CellTargetIndex
+{
+    struct GridTargets
+    {
+        CellTargetList Cells[MAX_NUMBER_OF_CELLS][MAX_NUMBER_OF_CELLS];
+    };
+
+    typedef UNORDERED_MAP<Unit const*, uint32 /*cell id*/> UnitCellMap;
+
+    public:
+        CellTargetIndex();
+        ~CellTargetIndex() { Clear(); }
+
+        /// Units of cell, collected from grid (the cell's containers) the first time the cell is searched
+        CellTargetList& GetTargets(Cell const& cell, GridType& grid);
+
+        /// Must be called once a player or creature is linked into cell
+        void Add(Unit* unit, Cell const& cell);
+        /// Must be called before a player or creature is unlinked from its cell
+        void Remove(Unit* unit);
+        /// Must be called when the faction of a unit changed
+        void UpdateFaction(Unit* unit);
+
+        /// Evicts the cells of a grid, the objects of an unloaded grid are deleted afterwards
+        void UnloadGrid(uint32 x, uint32 y);
+        void Clear();
+
+    private:
+        CellTargetIndex(CellTargetIndex const&);
+        CellTargetIndex& operator=(CellTargetIndex const&);
+
+        CellTargetList* FindCell(uint32 cellId) const;
+        static void UpdateMasks(CellTargetList& targets);
+
+        GridTargets* _grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        UnitCellMap _unitCells;                             // cell of every unit held by a collected cell
+};
+
+#endif
@@ -28,6 +28,8 @@
 #include "CellImpl.h"
 #include "SpellInfo.h"
 
+#include <iterator>
+
 using namespace Infinity;
 
 void VisibleNotifier::SendToSelf()
@@ -48,9 +50,17 @@ void VisibleNotifier::SendToSelf()
             }
         }
 */
-    for (Player::ClientGUIDs::const_iterator it = vis_guids.begin();it != vis_guids.end(); ++it)
+    // whatever the client knew before and was not visited now went out of range,
+    // both lists are sorted so a single merge pass finds them
+    std::sort(i_visited.begin(), i_visited.end());
+
+    std::vector<uint64> outOfRange;
+    std::set_difference(vis_guids.begin(), vis_guids.end(), i_visited.begin(), i_visited.end(), std::back_inserter(outOfRange));
+
+    i_player.m_clientGUIDs.erase_sorted(outOfRange.begin(), outOfRange.end());
+
+    for (std::vector<uint64>::const_iterator it = outOfRange.begin(); it != outOfRange.end(); ++it)
     {
-        i_player.m_clientGUIDs.erase(*it);
         i_data.AddOutOfRangeGUID(*it);
 
         if (IS_PLAYER_GUID(*it))
@@ -128,7 +138,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
     {
         Player* player = iter->GetSource();
 
-        vis_guids.erase(player->GetGUID());
+        i_visited.push_back(player->GetGUID());
 
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
 
@@ -147,7 +157,7 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
     {
         Creature* c = iter->GetSource();
 
-        vis_guids.erase(c->GetGUID());
+        i_visited.push_back(c->GetGUID());
 
         i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
@@ -184,6 +194,154 @@ void CreatureRelocationNotifier::Visit(CreatureMapType &m)
     }
 }
 
+void RelocationCandidateCollector::Visit(CreatureMapType &m)
+{
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        i_creatures.push_back(RelocationCandidate(iter->GetSource(), i_cell));
+}
+
+void RelocationCandidateCollector::Visit(PlayerMapType &m)
+{
+    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        i_players.push_back(RelocationCandidate(iter->GetSource(), i_cell));
+}
+
+CreatureRelocationBatch::CreatureRelocationBatch(Map &map, float radius) : i_map(map), i_radius(radius)
+{
+    i_bucketCells = std::max(uint32(ceil(std::min(radius, SIZE_OF_GRIDS) / SIZE_OF_GRID_CELL)), uint32(1));
+}
+
+void CreatureRelocationBatch::Add(Creature* creature, CellCoord const& cell)
+{
+    uint32 bucket = (cell.x_coord / i_bucketCells) * TOTAL_NUMBER_OF_CELLS_PER_MAP + cell.y_coord / i_bucketCells;
+    i_buckets[bucket].push_back(RelocatedCreature(creature, cell, GetArea(creature)));
+}
+
+CellArea CreatureRelocationBatch::GetArea(Creature const* creature) const
+{
+    // same search area as Cell::Visit() around the creature
+    float radius = std::min(i_radius + creature->GetObjectSize(), SIZE_OF_GRIDS);
+    return Cell::CalculateCellArea(creature->GetPositionX(), creature->GetPositionY(), radius);
+}
+
+void CreatureRelocationBatch::Process()
+{
+    for (BucketMap::iterator itr = i_buckets.begin(); itr != i_buckets.end(); ++itr)
+        ProcessBucket(itr->second);
+
+    i_buckets.clear();
+}
+
+void CreatureRelocationBatch::ProcessSingle(RelocatedCreature const& relocated)
+{
+    Cell cell(relocated.i_cell);
+    cell.SetNoCreate();
+
+    CreatureRelocationNotifier relocate(*relocated.i_creature);
+    TypeContainerVisitor<CreatureRelocationNotifier, WorldTypeMapContainer > c2world_relocation(relocate);
+    TypeContainerVisitor<CreatureRelocationNotifier, GridTypeMapContainer >  c2grid_relocation(relocate);
+
+    cell.Visit(relocated.i_cell, c2world_relocation, i_map, *relocated.i_creature, i_radius);
+    cell.Visit(relocated.i_cell, c2grid_relocation, i_map, *relocated.i_creature, i_radius);
+}
+
+void CreatureRelocationBatch::ProcessBucket(CreatureList& creatures)
+{
+    // gather everything the bucket's creatures can reach with a single pass over the cells
+    CellArea bounds(creatures.front().i_cell, creatures.front().i_cell);
+    uint32 separateCells = 0;
+    for (CreatureList::const_iterator itr = creatures.begin(); itr != creatures.end(); ++itr)
+    {
+        separateCells += itr->i_area.GetCellCount();
+        bounds.low_bound.x_coord = std::min(bounds.low_bound.x_coord, std::min(itr->i_area.low_bound.x_coord, itr->i_cell.x_coord));
+        bounds.low_bound.y_coord = std::min(bounds.low_bound.y_coord, std::min(itr->i_area.low_bound.y_coord, itr->i_cell.y_coord));
+        bounds.high_bound.x_coord = std::max(bounds.high_bound.x_coord, std::max(itr->i_area.high_bound.x_coord, itr->i_cell.x_coord));
+        bounds.high_bound.y_coord = std::max(bounds.high_bound.y_coord, std::max(itr->i_area.high_bound.y_coord, itr->i_cell.y_coord));
+    }
+
+    // few or spread out creatures are cheaper to handle with their own cell visits
+    if (bounds.GetCellCount() >= separateCells)
+    {
+        for (CreatureList::const_iterator itr = creatures.begin(); itr != creatures.end(); ++itr)
+            ProcessSingle(*itr);
+        return;
+    }
+
+    i_creatures.clear();
+    i_players.clear();
+
+    RelocationCandidateCollector collector(i_creatures, i_players);
+    TypeContainerVisitor<RelocationCandidateCollector, WorldTypeMapContainer > world_collector(collector);
+    TypeContainerVisitor<RelocationCandidateCollector, GridTypeMapContainer >  grid_collector(collector);
+
+    for (uint32 x = bounds.low_bound.x_coord; x <= bounds.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = bounds.low_bound.y_coord; y <= bounds.high_bound.y_coord; ++y)
+        {
+            collector.i_cell = CellCoord(x, y);
+            Cell cell(collector.i_cell);
+            cell.SetNoCreate();
+            i_map.Visit(cell, world_collector);
+            i_map.Visit(cell, grid_collector);
+        }
+    }
+
+    // ordered by creature for the pair lookups below
+    std::sort(creatures.begin(), creatures.end());
+
+    // then run the CreatureRelocationNotifier logic for every creature against the candidates
+    // in the cells its own notifier would have visited
+    for (CreatureList::const_iterator itr = creatures.begin(); itr != creatures.end(); ++itr)
+    {
+        Creature* creature = itr->i_creature;
+
+        for (std::vector<RelocationCandidate>::const_iterator candidate = i_players.begin(); candidate != i_players.end(); ++candidate)
+        {
+            if (!Cell::IsCellVisited(itr->i_cell, itr->i_area, candidate->i_cell))
+                continue;
+
+            Player* player = candidate->i_object->ToPlayer();
+            if (!player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+                player->UpdateVisibilityOf(creature);
+
+            CreatureUnitRelocationWorker(creature, player);
+        }
+
+        if (!creature->IsAlive())
+            continue;
+
+        for (std::vector<RelocationCandidate>::const_iterator candidate = i_creatures.begin(); candidate != i_creatures.end(); ++candidate)
+        {
+            Creature* c = candidate->i_object->ToCreature();
+            bool inRange = Cell::IsCellVisited(itr->i_cell, itr->i_area, candidate->i_cell);
+
+            RelocatedCreature key(c, candidate->i_cell, itr->i_area);
+            CreatureList::const_iterator other = std::lower_bound(creatures.begin(), creatures.end(), key);
+            if (other == creatures.end() || other->i_creature != c)
+            {
+                if (!inRange)
+                    continue;
+
+                CreatureUnitRelocationWorker(creature, c);
+
+                if (!c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+                    CreatureUnitRelocationWorker(c, creature);
+                continue;
+            }
+
+            // both moved: the pair is handled once, by the first of the two, each side with its own search area
+            if (other <= itr)
+                continue;
+
+            if (inRange)
+                CreatureUnitRelocationWorker(creature, c);
+
+            if (Cell::IsCellVisited(other->i_cell, other->i_area, itr->i_cell))
+                CreatureUnitRelocationWorker(c, creature);
+        }
+    }
+}
+
 void DelayedUnitRelocation::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -192,6 +350,12 @@ void DelayedUnitRelocation::Visit(CreatureMapType &m)
         if (!unit->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
             continue;
 
+        if (i_batch)
+        {
+            i_batch->Add(unit, p);
+            continue;
+        }
+
         CreatureRelocationNotifier relocate(*unit);
 
         TypeContainerVisitor<CreatureRelocationNotifier, WorldTypeMapContainer > c2world_relocation(relocate);
@@ -20,6 +20,7 @@
 #define INFINITY_GRIDNOTIFIERS_H
 
 #include "ObjectGridLoader.h"
+#include "CellTargetIndex.h"
 #include "UpdateData.h"
 #include <iostream>
 
@@ -43,9 +44,10 @@ namespace Infinity
         Player &i_player;
         UpdateData i_data;
         std::set<Unit*> i_visibleNow;
-        Player::ClientGUIDs vis_guids;
+        Player::ClientGUIDs vis_guids;                      // client set when the visit started
+        std::vector<uint64> i_visited;                      // everything in range, diffed against vis_guids in SendToSelf
 
-        VisibleNotifier(Player &player) : i_player(player), vis_guids(player.m_clientGUIDs) { }
+        VisibleNotifier(Player &player) : i_player(player), vis_guids(player.m_clientGUIDs) { i_visited.reserve(vis_guids.size()); }
         template<class T> void Visit(GridRefManager<T> &m);
         void SendToSelf(void);
     };
@@ -79,14 +81,72 @@ namespace Infinity
         void Visit(PlayerMapType &);
     };
 
+    struct RelocationCandidate
+    {
+        RelocationCandidate(WorldObject* object, CellCoord const& cell) : i_object(object), i_cell(cell) { }
+
+        WorldObject* i_object;
+        CellCoord i_cell;                                   // cell the object is stored in
+    };
+
+    struct RelocationCandidateCollector
+    {
+        std::vector<RelocationCandidate> &i_creatures;
+        std::vector<RelocationCandidate> &i_players;
+        CellCoord i_cell;                                   // cell being visited
+        RelocationCandidateCollector(std::vector<RelocationCandidate> &creatures, std::vector<RelocationCandidate> &players) :
+            i_creatures(creatures), i_players(players) { }
+        template<class T> void Visit(GridRefManager<T> &) { }
+        void Visit(CreatureMapType &);
+        void Visit(PlayerMapType &);
+    };
+
+    // Relocated creatures bucketed by position, each bucket's neighbourhood is gathered
+    // once instead of visiting the cells around every single relocated creature
+    class CreatureRelocationBatch
+    {
+        struct RelocatedCreature
+        {
+            RelocatedCreature(Creature* creature, CellCoord const& cell, CellArea const& area) : i_creature(creature), i_cell(cell), i_area(area) { }
+
+            bool operator<(RelocatedCreature const& right) const { return i_creature < right.i_creature; }
+
+            Creature* i_creature;
+            CellCoord i_cell;                               // cell the creature is stored in
+            CellArea i_area;                                // cells its own notifier would visit
+        };
+
+        typedef std::vector<RelocatedCreature> CreatureList;
+        typedef UNORDERED_MAP<uint32, CreatureList> BucketMap;
+
+        public:
+            CreatureRelocationBatch(Map &map, float radius);
+
+            void Add(Creature* creature, CellCoord const& cell);
+            void Process();
+
+        private:
+            void ProcessSingle(RelocatedCreature const& relocated);
+            void ProcessBucket(CreatureList& creatures);
+            CellArea GetArea(Creature const* creature) const;
+
+            Map &i_map;
+            const float i_radius;
+            uint32 i_bucketCells;                           // bucket edge in cells, at least the search radius
+            BucketMap i_buckets;
+            std::vector<RelocationCandidate> i_creatures;   // reused between buckets
+            std::vector<RelocationCandidate> i_players;
+    };
+
     struct DelayedUnitRelocation
     {
         Map &i_map;
         Cell &cell;
         CellCoord &p;
         const float i_radius;
-        DelayedUnitRelocation(Cell &c, CellCoord &pair, Map &map, float radius) :
-            i_map(map), cell(c), p(pair), i_radius(radius) { }
+        CreatureRelocationBatch* i_batch;
+        DelayedUnitRelocation(Cell &c, CellCoord &pair, Map &map, float radius, CreatureRelocationBatch* batch = NULL) :
+            i_map(map), cell(c), p(pair), i_radius(radius), i_batch(batch) { }
         template<class T> void Visit(GridRefManager<T> &) { }
         void Visit(CreatureMapType &);
         void Visit(PlayerMapType   &);
@@ -204,6 +264,7 @@ namespace Infinity
         void Visit(CreatureMapType &m);
         void Visit(CorpseMapType &m);
         void Visit(DynamicObjectMapType &m);
+        void Visit(CellTargetList &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
     };
@@ -224,6 +285,7 @@ namespace Infinity
         void Visit(CorpseMapType &m);
         void Visit(GameObjectMapType &m);
         void Visit(DynamicObjectMapType &m);
+        void Visit(CellTargetList &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
     };
@@ -33,7 +33,7 @@ inline void Infinity::VisibleNotifier::Visit(GridRefManager<T> &m)
 {
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        vis_guids.erase(iter->GetSource()->GetGUID());
+        i_visited.push_back(iter->GetSource()->GetGUID());
         i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
     }
 }
@@ -208,6 +208,17 @@ void Infinity::WorldObjectLastSearcher<Check>::Visit(DynamicObjectMapType &m)
     }
 }
 
+template<class Check>
+void Infinity::WorldObjectLastSearcher<Check>::Visit(CellTargetList &m)
+{
+    if (!(m.TypeMask & i_mapTypeMask))
+        return;
+
+    for (std::vector<CellTarget>::const_iterator itr = m.Targets.begin(); itr != m.Targets.end(); ++itr)
+        if ((itr->TypeMask & i_mapTypeMask) && i_check(itr->Target))
+            i_object = itr->Target;
+}
+
 template<class Check>
 void Infinity::WorldObjectListSearcher<Check>::Visit(PlayerMapType &m)
 {
@@ -263,6 +274,17 @@ void Infinity::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType &m)
             i_objects.push_back(itr->GetSource());
 }
 
+template<class Check>
+void Infinity::WorldObjectListSearcher<Check>::Visit(CellTargetList &m)
+{
+    if (!(m.TypeMask & i_mapTypeMask))
+        return;
+
+    for (std::vector<CellTarget>::const_iterator itr = m.Targets.begin(); itr != m.Targets.end(); ++itr)
+        if ((itr->TypeMask & i_mapTypeMask) && i_check(itr->Target))
+            i_objects.push_back(itr->Target);
+}
+
 // Gameobject searchers
 
 template<class Check>
@@ -32,6 +32,7 @@
 #include "ObjectMgr.h"
 #include "Pet.h"
 #include "ScriptMgr.h"
+#include "TickProfiler.h"
 #include "Transport.h"
 #include "VMapFactory.h"
 
@@ -66,6 +67,8 @@ Map::~Map()
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
+
+    sTickProfiler->RemoveMap(GetId(), i_InstanceId);
 }
 
 bool Map::ExistMap(uint32 mapid, int gx, int gy)
@@ -222,7 +225,7 @@ m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry),
-i_scriptLock(false)
+i_scriptLock(false), _tickRecorder(NULL)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -257,6 +260,8 @@ void Map::AddToGrid(T* obj, Cell const& cell)
         grid->GetGridType(cell.CellX(), cell.CellY()).template AddWorldObject<T>(obj);
     else
         grid->GetGridType(cell.CellX(), cell.CellY()).template AddGridObject<T>(obj);
+
+    AddCellTarget(obj, cell);
 }
 
 template<>
@@ -269,6 +274,7 @@ void Map::AddToGrid(Creature* obj, Cell const& cell)
         grid->GetGridType(cell.CellX(), cell.CellY()).AddGridObject(obj);
 
     obj->SetCurrentCell(cell);
+    _cellTargets.Add(obj, cell);
 }
 
 template<>
@@ -280,6 +286,30 @@ void Map::AddToGrid(GameObject* obj, Cell const& cell)
     obj->SetCurrentCell(cell);
 }
 
+template<class T>
+void Map::AddCellTarget(T* /*obj*/, Cell const& /*cell*/) { }
+
+template<>
+void Map::AddCellTarget(Player* obj, Cell const& cell)
+{
+    _cellTargets.Add(obj, cell);
+}
+
+template<class T>
+void Map::RemoveCellTarget(T* /*obj*/) { }
+
+template<>
+void Map::RemoveCellTarget(Creature* obj)
+{
+    _cellTargets.Remove(obj);
+}
+
+template<>
+void Map::RemoveCellTarget(Player* obj)
+{
+    _cellTargets.Remove(obj);
+}
+
 template<class T>
 void Map::SwitchGridContainers(T* /*obj*/, bool /*on*/) { }
 
@@ -304,6 +334,7 @@ void Map::SwitchGridContainers(Creature* obj, bool on)
 
     GridType &grid = ngrid->GetGridType(cell.CellX(), cell.CellY());
 
+    RemoveCellTarget(obj);
     obj->RemoveFromGrid(); //This step is not really necessary but we want to do ASSERT in remove/add
 
     if (on)
@@ -317,6 +348,7 @@ void Map::SwitchGridContainers(Creature* obj, bool on)
         RemoveWorldObject(obj);
     }
 
+    _cellTargets.Add(obj, cell);
     obj->m_isTempWorldObject = on;
 }
 
@@ -432,6 +464,8 @@ bool Map::EnsureGridLoaded(const Cell &cell)
 
         ObjectGridLoader loader(*grid, this, cell);
         loader.LoadN();
+        // the loader links the objects directly, cells searched before would miss them
+        _cellTargets.UnloadGrid(cell.GridX(), cell.GridY());
 
         // Add resurrectable corpses to world object list in grid
         sObjectAccessor->AddCorpsesToGrid(GridCoord(cell.GridX(), cell.GridY()), grid->GetGridType(cell.CellX(), cell.CellY()), this);
@@ -591,7 +625,12 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Infinity::Ob
 
 void Map::Update(const uint32 t_diff)
 {
+    TickPhaseRecorder tickRecorder(GetId(), GetInstanceId(), GetMapName());
+    _tickRecorder = tickRecorder.IsEnabled() ? &tickRecorder : NULL;
+
     _dynamicTree.update(t_diff);
+    tickRecorder.Lap(MAP_TICK_OTHER);
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -604,6 +643,8 @@ void Map::Update(const uint32 t_diff)
             session->Update(t_diff, updater);
         }
     }
+    tickRecorder.Lap(MAP_TICK_SESSIONS);
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -615,6 +656,7 @@ void Map::Update(const uint32 t_diff)
 
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
+    tickRecorder.Lap(MAP_TICK_OTHER);
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* player = m_mapRefIter->GetSource();
@@ -624,8 +666,10 @@ void Map::Update(const uint32 t_diff)
 
         // update players at tick
         player->Update(t_diff);
+        tickRecorder.Lap(MAP_TICK_PLAYERS);
 
         VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        tickRecorder.Lap(MAP_TICK_CELLS);
     }
 
     // non-player active objects, increasing iterator in the loop in case of object removal
@@ -639,6 +683,7 @@ void Map::Update(const uint32 t_diff)
 
         VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
     }
+    tickRecorder.Lap(MAP_TICK_ACTIVE_OBJECTS);
 
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
@@ -650,6 +695,7 @@ void Map::Update(const uint32 t_diff)
 
         obj->Update(t_diff);
     }
+    tickRecorder.Lap(MAP_TICK_TRANSPORTS);
 
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
@@ -658,14 +704,20 @@ void Map::Update(const uint32 t_diff)
         ScriptsProcess();
         i_scriptLock = false;
     }
+    tickRecorder.Lap(MAP_TICK_SCRIPTS);
 
     MoveAllCreaturesInMoveList();
     MoveAllGameObjectsInMoveList();
+    tickRecorder.Lap(MAP_TICK_MOVE_LISTS);
 
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
         ProcessRelocationNotifies(t_diff);
+    tickRecorder.Lap(MAP_TICK_RELOCATION);
 
     sScriptMgr->OnMapUpdate(this, t_diff);
+    tickRecorder.Lap(MAP_TICK_OTHER);
+
+    _tickRecorder = NULL;
 }
 
 struct ResetNotifier
@@ -682,6 +734,8 @@ struct ResetNotifier
 
 void Map::ProcessRelocationNotifies(const uint32 diff)
 {
+    Infinity::CreatureRelocationBatch creatureRelocation(*this, MAX_VISIBILITY_DISTANCE);
+
     for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end(); ++i)
     {
         NGridType *grid = i->GetSource();
@@ -710,7 +764,7 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
                 Cell cell(pair);
                 cell.SetNoCreate();
 
-                Infinity::DelayedUnitRelocation cell_relocation(cell, pair, *this, MAX_VISIBILITY_DISTANCE);
+                Infinity::DelayedUnitRelocation cell_relocation(cell, pair, *this, MAX_VISIBILITY_DISTANCE, &creatureRelocation);
                 TypeContainerVisitor<Infinity::DelayedUnitRelocation, GridTypeMapContainer  > grid_object_relocation(cell_relocation);
                 TypeContainerVisitor<Infinity::DelayedUnitRelocation, WorldTypeMapContainer > world_object_relocation(cell_relocation);
                 Visit(cell, grid_object_relocation);
@@ -719,6 +773,9 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
         }
     }
 
+    // relocated creatures were only collected above
+    creatureRelocation.Process();
+
     ResetNotifier reset;
     TypeContainerVisitor<ResetNotifier, GridTypeMapContainer >  grid_notifier(reset);
     TypeContainerVisitor<ResetNotifier, WorldTypeMapContainer > world_notifier(reset);
@@ -766,7 +823,10 @@ void Map::RemovePlayerFromMap(Player* player, bool remove)
 
     player->UpdateObjectVisibility(true);
     if (player->IsInGrid())
+    {
+        RemoveCellTarget(player);
         player->RemoveFromGrid();
+    }
     else
         ASSERT(remove); //maybe deleted in logoutplayer when player is not in a map
 
@@ -782,6 +842,7 @@ void Map::RemoveFromMap(T *obj, bool remove)
         RemoveFromActive(obj);
 
     obj->UpdateObjectVisibility(true);
+    RemoveCellTarget(obj);
     obj->RemoveFromGrid();
 
     obj->ResetMap();
@@ -843,6 +904,7 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     {
         IC_LOG_DEBUG("maps", "Player %s relocation grid[%u, %u]cell[%u, %u]->grid[%u, %u]cell[%u, %u]", player->GetName().c_str(), old_cell.GridX(), old_cell.GridY(), old_cell.CellX(), old_cell.CellY(), new_cell.GridX(), new_cell.GridY(), new_cell.CellX(), new_cell.CellY());
 
+        RemoveCellTarget(player);
         player->RemoveFromGrid();
 
         if (old_cell.DiffGrid(new_cell))
@@ -1070,6 +1132,7 @@ bool Map::CreatureCellRelocation(Creature* c, Cell new_cell)
                 IC_LOG_DEBUG("maps", "Creature (GUID: %u Entry: %u) moved in grid[%u, %u] from cell[%u, %u] to cell[%u, %u].", c->GetGUIDLow(), c->GetEntry(), old_cell.GridX(), old_cell.GridY(), old_cell.CellX(), old_cell.CellY(), new_cell.CellX(), new_cell.CellY());
             #endif
 
+            RemoveCellTarget(c);
             c->RemoveFromGrid();
             AddToGrid(c, new_cell);
         }
@@ -1092,6 +1155,7 @@ bool Map::CreatureCellRelocation(Creature* c, Cell new_cell)
             IC_LOG_DEBUG("maps", "Active creature (GUID: %u Entry: %u) moved from grid[%u, %u]cell[%u, %u] to grid[%u, %u]cell[%u, %u].", c->GetGUIDLow(), c->GetEntry(), old_cell.GridX(), old_cell.GridY(), old_cell.CellX(), old_cell.CellY(), new_cell.GridX(), new_cell.GridY(), new_cell.CellX(), new_cell.CellY());
         #endif
 
+        RemoveCellTarget(c);
         c->RemoveFromGrid();
         AddToGrid(c, new_cell);
 
@@ -1105,6 +1169,7 @@ bool Map::CreatureCellRelocation(Creature* c, Cell new_cell)
             IC_LOG_DEBUG("maps", "Creature (GUID: %u Entry: %u) moved from grid[%u, %u]cell[%u, %u] to grid[%u, %u]cell[%u, %u].", c->GetGUIDLow(), c->GetEntry(), old_cell.GridX(), old_cell.GridY(), old_cell.CellX(), old_cell.CellY(), new_cell.GridX(), new_cell.GridY(), new_cell.CellX(), new_cell.CellY());
         #endif
 
+        RemoveCellTarget(c);
         c->RemoveFromGrid();
         EnsureGridCreated(GridCoord(new_cell.GridX(), new_cell.GridY()));
         AddToGrid(c, new_cell);
@@ -1286,6 +1351,8 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
 
         ASSERT(i_objectsToRemove.empty());
 
+        _cellTargets.UnloadGrid(x, y);
+
         delete &ngrid;
         setNGrid(NULL, x, y);
     }
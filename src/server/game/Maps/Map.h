@@ -26,6 +26,7 @@
 #include "DBCStructure.h"
 #include "GridDefines.h"
 #include "Cell.h"
+#include "CellTargetIndex.h"
 #include "Timer.h"
 #include "SharedDefines.h"
 #include "GridRefManager.h"
@@ -53,6 +54,7 @@ class Battleground;
 class MapInstanced;
 class InstanceMap;
 class Transport;
+class TickPhaseRecorder;
 namespace Infinity { struct ObjectUpdater; }
 
 struct ScriptAction
@@ -274,6 +276,9 @@ class Map : public GridRefManager<NGridType>
         virtual void Update(const uint32);
 
         float GetVisibilityRange() const { return m_VisibleDistance; }
+
+        /// Recorder of the running Map::Update while tick profiling is on, NULL otherwise
+        TickPhaseRecorder* GetTickRecorder() const { return _tickRecorder; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
 
@@ -282,6 +287,9 @@ class Map : public GridRefManager<NGridType>
         void GameObjectRelocation(GameObject* go, float x, float y, float z, float orientation, bool respawnRelocationOnFail = true);
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER> &visitor);
+        template<class T> void Visit(const Cell& cell, TypeContainerVisitor<T, CellTargetList> &visitor);
+        /// Refreshes the faction mask a unit has in the cell target index
+        void UpdateCellTargetFaction(Unit* unit) { _cellTargets.UpdateFaction(unit); }
 
         bool IsRemovalGrid(float x, float y) const
         {
@@ -429,6 +437,8 @@ class Map : public GridRefManager<NGridType>
         template<class NOTIFIER> void VisitFirstFound(const float &x, const float &y, float radius, NOTIFIER &notifier);
         template<class NOTIFIER> void VisitWorld(const float &x, const float &y, float radius, NOTIFIER &notifier);
         template<class NOTIFIER> void VisitGrid(const float &x, const float &y, float radius, NOTIFIER &notifier);
+        // players and creatures only, from the cell target snapshots
+        template<class NOTIFIER> void VisitCellTargets(const float &x, const float &y, float radius, NOTIFIER &notifier);
         CreatureGroupHolderType CreatureGroupHolder;
 
         void UpdateIteratorBack(Player* player);
@@ -588,6 +598,7 @@ class Map : public GridRefManager<NGridType>
         void ProcessRelocationNotifies(const uint32 diff);
 
         bool i_scriptLock;
+        TickPhaseRecorder* _tickRecorder;
         std::set<WorldObject*> i_objectsToRemove;
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
@@ -602,6 +613,15 @@ class Map : public GridRefManager<NGridType>
         template<class T>
         void DeleteFromWorld(T*);
 
+        // Keep the cell target index current, players and creatures only
+        template<class T>
+        void AddCellTarget(T* object, Cell const& cell);
+        // Must be called before an object is unlinked from its cell
+        template<class T>
+        void RemoveCellTarget(T* object);
+
+        CellTargetIndex _cellTargets;
+
         void AddToActiveHelper(WorldObject* obj)
         {
             m_activeNonPlayers.insert(obj);
@@ -701,6 +721,19 @@ inline void Map::Visit(Cell const& cell, TypeContainerVisitor<T, CONTAINER>& vis
     }
 }
 
+template<class T>
+inline void Map::Visit(Cell const& cell, TypeContainerVisitor<T, CellTargetList>& visitor)
+{
+    const uint32 x = cell.GridX();
+    const uint32 y = cell.GridY();
+
+    if (!cell.NoCreate() || IsGridLoaded(GridCoord(x, y)))
+    {
+        EnsureGridLoaded(cell);
+        visitor.Visit(_cellTargets.GetTargets(cell, getNGrid(x, y)->GetGridType(cell.CellX(), cell.CellY())));
+    }
+}
+
 template<class NOTIFIER>
 inline void Map::VisitAll(float const& x, float const& y, float radius, NOTIFIER& notifier)
 {
@@ -752,4 +785,15 @@ inline void Map::VisitGrid(const float &x, const float &y, float radius, NOTIFIE
     TypeContainerVisitor<NOTIFIER, GridTypeMapContainer >  grid_object_notifier(notifier);
     cell.Visit(p, grid_object_notifier, *this, radius, x, y);
 }
+
+template<class NOTIFIER>
+inline void Map::VisitCellTargets(const float &x, const float &y, float radius, NOTIFIER &notifier)
+{
+    CellCoord p(Infinity::ComputeCellCoord(x, y));
+    Cell cell(p);
+    cell.SetNoCreate();
+
+    TypeContainerVisitor<NOTIFIER, CellTargetList> cell_target_notifier(notifier);
+    cell.Visit(p, cell_target_notifier, *this, radius, x, y);
+}
 #endif
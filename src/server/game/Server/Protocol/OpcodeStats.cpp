@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeStats.h"
+#include "Log.h"
+
+#include <algorithm>
+
+namespace
+{
+    struct OpcodeStatsEntrySorter
+    {
+        explicit OpcodeStatsEntrySorter(OpcodeStatsSortOrder order) : _order(order) { }
+
+        bool operator()(OpcodeStatsEntry const& left, OpcodeStatsEntry const& right) const
+        {
+            switch (_order)
+            {
+                case OPCODE_STATS_SORT_CALLS:
+                    return left.Counters.Calls > right.Counters.Calls;
+                case OPCODE_STATS_SORT_P99:
+                    return left.Counters.Histogram.GetPercentile(99.0f) > right.Counters.Histogram.GetPercentile(99.0f);
+                case OPCODE_STATS_SORT_BYTES:
+                    return left.Counters.BytesIn + left.Counters.BytesOut > right.Counters.BytesIn + right.Counters.BytesOut;
+                case OPCODE_STATS_SORT_TOTAL_TIME:
+                default:
+                    return left.Counters.TotalTime > right.Counters.TotalTime;
+            }
+        }
+
+        OpcodeStatsSortOrder _order;
+    };
+}
+
+void OpcodeStatsCounters::Merge(OpcodeStatsCounters const& other)
+{
+    Calls += other.Calls;
+    TotalTime += other.TotalTime;
+    MaxTime = std::max(MaxTime, other.MaxTime);
+    BytesIn += other.BytesIn;
+    PacketsOut += other.PacketsOut;
+    BytesOut += other.BytesOut;
+    Histogram.Merge(other.Histogram);
+}
+
+OpcodeStats::OpcodeStats() : _enabled(false), _generation(1)
+{
+}
+
+OpcodeStats::~OpcodeStats()
+{
+    for (std::vector<ThreadBlock*>::iterator itr = _blocks.begin(); itr != _blocks.end(); ++itr)
+        delete *itr;
+}
+
+OpcodeStats::ThreadBlock* OpcodeStats::GetThreadBlock()
+{
+    ThreadBlock* block = _slot->Block;
+    if (!block)
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _blocksLock, NULL);
+
+        block = new ThreadBlock();
+        block->Generation = _generation.value();
+        _blocks.push_back(block);
+        _slot->Block = block;
+    }
+    else if (block->Generation != _generation.value())
+    {
+        // Reset() was requested since this thread last wrote, clear our own counters
+        for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+            block->Counters[i] = OpcodeStatsCounters();
+        block->Generation = _generation.value();
+    }
+
+    return block;
+}
+
+void OpcodeStats::RecordHandler(uint16 opcode, uint32 size, uint64 elapsed)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    ThreadBlock* block = GetThreadBlock();
+    if (!block)
+        return;
+
+    OpcodeStatsCounters& counters = block->Counters[opcode];
+    ++counters.Calls;
+    counters.TotalTime += elapsed;
+    if (elapsed > counters.MaxTime)
+        counters.MaxTime = elapsed;
+    counters.BytesIn += size;
+    counters.Histogram.Add(elapsed);
+}
+
+void OpcodeStats::RecordSend(uint16 opcode, uint32 size)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    ThreadBlock* block = GetThreadBlock();
+    if (!block)
+        return;
+
+    OpcodeStatsCounters& counters = block->Counters[opcode];
+    ++counters.PacketsOut;
+    counters.BytesOut += size;
+}
+
+void OpcodeStats::Reset()
+{
+    ++_generation;
+}
+
+uint32 OpcodeStats::GetThreadCount() const
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _blocksLock, 0);
+    return uint32(_blocks.size());
+}
+
+void OpcodeStats::GetSnapshot(OpcodeStatsSnapshot& snapshot, OpcodeStatsSortOrder order) const
+{
+    snapshot.clear();
+
+    std::vector<OpcodeStatsCounters> totals(NUM_MSG_TYPES);
+    long generation = _generation.value();
+
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, _blocksLock);
+        for (std::vector<ThreadBlock*>::const_iterator itr = _blocks.begin(); itr != _blocks.end(); ++itr)
+        {
+            // blocks of an older generation have not been cleared by their writer yet
+            if ((*itr)->Generation != generation)
+                continue;
+
+            for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+                totals[i].Merge((*itr)->Counters[i]);
+        }
+    }
+
+    for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+    {
+        if (!totals[i].Calls && !totals[i].PacketsOut)
+            continue;
+
+        OpcodeStatsEntry entry;
+        entry.Opcode = uint16(i);
+        entry.Counters = totals[i];
+        snapshot.push_back(entry);
+    }
+
+    std::sort(snapshot.begin(), snapshot.end(), OpcodeStatsEntrySorter(order));
+}
+
+std::string OpcodeStats::FormatEntry(OpcodeStatsEntry const& entry)
+{
+    OpcodeStatsCounters const& counters = entry.Counters;
+    uint64 average = counters.Calls ? counters.TotalTime / counters.Calls : 0;
+
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%-36s calls: " UI64FMTD " total: " UI64FMTD " ms avg: " UI64FMTD " us p99: <" UI64FMTD " us max: " UI64FMTD " us in: " UI64FMTD " B out: " UI64FMTD " pkts/" UI64FMTD " B",
+        LookupOpcodeName(entry.Opcode), counters.Calls, counters.TotalTime / IN_MILLISECONDS, average,
+        counters.Histogram.GetPercentile(99.0f), counters.MaxTime, counters.BytesIn, counters.PacketsOut, counters.BytesOut);
+
+    return buffer;
+}
+
+void OpcodeStats::LogSnapshot(uint32 limit, OpcodeStatsSortOrder order) const
+{
+    static LogSite logSite = { "network.opcode.stats", NULL, 0 };
+    if (!sLog->ShouldLog(logSite, LOG_LEVEL_INFO))
+        return;
+
+    OpcodeStatsSnapshot snapshot;
+    GetSnapshot(snapshot, order);
+
+    IC_LOG_INFO("network.opcode.stats", "Opcode statistics: %u opcodes seen by %u threads", uint32(snapshot.size()), GetThreadCount());
+    for (uint32 i = 0; i < snapshot.size() && i < limit; ++i)
+        IC_LOG_INFO("network.opcode.stats", "%s", FormatEntry(snapshot[i]).c_str());
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_OPCODESTATS_H
+#define INFINITY_OPCODESTATS_H
+
+#include "Common.h"
+#include "Opcodes.h"
+#include "LatencyHistogram.h"
+#include <ace/Singleton.h>
+#include <ace/TSS_T.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+
+struct OpcodeStatsCounters
+{
+    OpcodeStatsCounters() : Calls(0), TotalTime(0), MaxTime(0), BytesIn(0), PacketsOut(0), BytesOut(0) { }
+
+    void Merge(OpcodeStatsCounters const& other);
+
+    uint64 Calls;                                           // handler invocations
+    uint64 TotalTime;                                       // handler time, microseconds
+    uint64 MaxTime;                                         // slowest handler call, microseconds
+    uint64 BytesIn;                                         // payload handed to the handler
+    uint64 PacketsOut;                                      // packets sent with this opcode
+    uint64 BytesOut;                                        // payload sent with this opcode
+    LatencyHistogram Histogram;                             // handler time distribution
+};
+
+struct OpcodeStatsEntry
+{
+    uint16 Opcode;
+    OpcodeStatsCounters Counters;
+};
+
+enum OpcodeStatsSortOrder
+{
+    OPCODE_STATS_SORT_TOTAL_TIME,
+    OPCODE_STATS_SORT_CALLS,
+    OPCODE_STATS_SORT_P99,
+    OPCODE_STATS_SORT_BYTES
+};
+
+typedef std::vector<OpcodeStatsEntry> OpcodeStatsSnapshot;
+
+/**
+    Per-opcode handler profiler.
+
+    Every thread that handles or sends packets owns a private counter block, so the
+    hot path never takes a lock or issues an atomic instruction. Readers aggregate
+    all blocks on demand, so a report may lag the writers by a few packets.
+    Reset() bumps a generation number and each writer clears its own block lazily.
+*/
+class OpcodeStats
+{
+    friend class ACE_Singleton<OpcodeStats, ACE_Thread_Mutex>;
+
+    struct ThreadBlock
+    {
+        ThreadBlock() : Generation(0) { }
+
+        long Generation;
+        OpcodeStatsCounters Counters[NUM_MSG_TYPES];
+    };
+
+    struct ThreadSlot
+    {
+        ThreadSlot() : Block(NULL) { }
+
+        ThreadBlock* Block;                                 // owned by OpcodeStats, outlives the thread
+    };
+
+    private:
+        OpcodeStats();
+        ~OpcodeStats();
+
+    public:
+        bool IsEnabled() const { return _enabled; }
+        void SetEnabled(bool enabled) { _enabled = enabled; }
+
+        /// Records one handler call, only called by the thread running the handler
+        void RecordHandler(uint16 opcode, uint32 size, uint64 elapsed);
+        /// Records one outgoing packet on the calling thread
+        void RecordSend(uint16 opcode, uint32 size);
+
+        void Reset();
+        void GetSnapshot(OpcodeStatsSnapshot& snapshot, OpcodeStatsSortOrder order) const;
+        uint32 GetThreadCount() const;
+
+        /// Writes the top entries to the "network.opcode.stats" logger
+        void LogSnapshot(uint32 limit, OpcodeStatsSortOrder order) const;
+
+        static std::string FormatEntry(OpcodeStatsEntry const& entry);
+
+    private:
+        ThreadBlock* GetThreadBlock();
+
+        volatile bool _enabled;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> _generation;
+
+        ACE_TSS<ThreadSlot> _slot;
+        std::vector<ThreadBlock*> _blocks;
+        mutable ACE_Thread_Mutex _blocksLock;               // guards _blocks, taken once per thread by writers
+};
+
+#define sOpcodeStats ACE_Singleton<OpcodeStats, ACE_Thread_Mutex>::instance()
+
+#endif
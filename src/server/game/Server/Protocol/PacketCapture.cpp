@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PacketCapture.h"
+#include "WorldPacket.h"
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_unistd.h>
+
+PacketCapture::PacketCapture() : _dropped(0), _stop(false), _header(NULL), _data(NULL) { }
+
+PacketCapture::~PacketCapture()
+{
+    if (_header)
+    {
+        _stop = true;
+        wait();
+    }
+
+    for (std::vector<LogRingBuffer*>::iterator itr = _buffers.begin(); itr != _buffers.end(); ++itr)
+        delete *itr;
+
+    _map.close();
+}
+
+bool PacketCapture::Open(std::string const& fileName, uint64 capacity)
+{
+    capacity &= ~uint64(7);
+    if (capacity < PACKET_CAPTURE_THREAD_BUFFER)
+        return false;
+
+    size_t length = size_t(sizeof(PacketCaptureHeader) + capacity);
+    if (_map.map(fileName.c_str(), length, O_RDWR | O_CREAT | O_TRUNC, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_SHARED) == -1 ||
+        _map.size() < length)
+        return false;
+
+    _header = static_cast<PacketCaptureHeader*>(_map.addr());
+    _data = static_cast<char*>(_map.addr()) + sizeof(PacketCaptureHeader);
+
+    memset(_header, 0, sizeof(PacketCaptureHeader));
+    _header->Version = PACKET_CAPTURE_VERSION;
+    _header->HeaderSize = sizeof(PacketCaptureHeader);
+    _header->Capacity = capacity;
+    _header->StartTime = uint64(time(NULL));
+    // readers check the magic last
+    _header->Magic = PACKET_CAPTURE_MAGIC;
+
+    ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1);
+    return true;
+}
+
+LogRingBuffer* PacketCapture::GetThreadBuffer()
+{
+    ThreadSlot* slot = _slot.ts_object();
+    if (!slot)
+    {
+        slot = new ThreadSlot();
+        _slot.ts_object(slot);
+    }
+
+    if (!slot->Buffer)
+    {
+        slot->Buffer = new LogRingBuffer(PACKET_CAPTURE_THREAD_BUFFER);
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, slot->Buffer);
+        _buffers.push_back(slot->Buffer);
+    }
+
+    return slot->Buffer;
+}
+
+void PacketCapture::Write(WorldPacket const& packet, Direction direction, uint32 connectionId, uint32 accountId)
+{
+    LogRingBuffer* buffer = GetThreadBuffer();
+
+    uint32 length = uint32(packet.size());
+    uint32 size = GetPacketCaptureRecordSize(length);
+    if (size > buffer->GetMaxRecordSize())
+    {
+        ++_dropped;
+        return;
+    }
+
+    char* data = buffer->Reserve(size);
+
+    PacketCaptureRecord* record = reinterpret_cast<PacketCaptureRecord*>(data);
+    record->Size = size;
+    record->Opcode = packet.GetOpcode();
+    record->Length = length;
+    record->ConnectionId = connectionId;
+    record->AccountId = accountId;
+    record->Direction = uint8(direction);
+    memset(record->Reserved, 0, sizeof(record->Reserved));
+
+    ACE_Time_Value now = ACE_OS::gettimeofday();
+    record->Time = uint64(now.sec()) * 1000000 + uint64(now.usec());
+
+    if (length)
+        memcpy(data + sizeof(PacketCaptureRecord), packet.contents(), length);
+
+    buffer->Commit();
+}
+
+int PacketCapture::svc()
+{
+    while (true)
+    {
+        bool stop = _stop;
+        uint32 written = Drain();
+
+        if (stop)
+            break;
+
+        if (!written)
+            ACE_OS::sleep(ACE_Time_Value(0, 5000));
+    }
+
+    return 0;
+}
+
+uint32 PacketCapture::Drain()
+{
+    std::vector<LogRingBuffer*> buffers;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, 0);
+        buffers = _buffers;
+    }
+
+    uint32 written = 0;
+    for (std::vector<LogRingBuffer*>::const_iterator itr = buffers.begin(); itr != buffers.end(); ++itr)
+    {
+        while (char const* record = (*itr)->Next())
+        {
+            WriteRecord(record);
+            ++written;
+        }
+
+        (*itr)->EndRead();
+    }
+
+    _header->Dropped = _dropped.value();
+
+    // rings of exited threads
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, written);
+    for (std::vector<LogRingBuffer*>::iterator itr = _buffers.begin(); itr != _buffers.end();)
+    {
+        if ((*itr)->IsReleased() && (*itr)->IsEmpty())
+        {
+            delete *itr;
+            itr = _buffers.erase(itr);
+        }
+        else
+            ++itr;
+    }
+
+    return written;
+}
+
+void PacketCapture::Reclaim(uint64 head, uint64 size)
+{
+    uint64 capacity = _header->Capacity;
+    uint64 tail = _header->Tail;
+
+    // drop the oldest records first, the header never points at a partly overwritten one
+    while (head + size - tail > capacity && tail < head)
+    {
+        uint64 tailOffset = tail % capacity;
+        uint32 tailSize = *reinterpret_cast<uint32 const*>(_data + tailOffset);
+        tail += tailSize ? tailSize : capacity - tailOffset;
+    }
+
+    _header->Tail = tail;
+}
+
+void PacketCapture::WriteRecord(char const* data)
+{
+    uint32 size = reinterpret_cast<PacketCaptureRecord const*>(data)->Size;
+    uint64 head = _header->Head;
+    uint64 offset = head % _header->Capacity;
+    uint64 contiguous = _header->Capacity - offset;
+
+    if (size > contiguous)
+    {
+        // too close to the end, the record starts over at the beginning of the ring
+        Reclaim(head, contiguous);
+        *reinterpret_cast<uint32*>(_data + offset) = 0;
+        head += contiguous;
+        offset = 0;
+        _header->Head = head;
+    }
+
+    Reclaim(head, size);
+    memcpy(_data + offset, data, size);
+    _header->Head = head + size;
+    ++_header->Records;
+}
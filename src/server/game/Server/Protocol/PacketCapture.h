@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_PACKETCAPTURE_H
+#define INFINITY_PACKETCAPTURE_H
+
+#include "Common.h"
+#include "LogWriter.h"
+#include "PacketCaptureFormat.h"
+#include "PacketLog.h"
+#include <ace/Mem_Map.h>
+
+#define PACKET_CAPTURE_THREAD_BUFFER    (1024 * 1024)      // per network thread, bytes
+
+/**
+    High throughput packet capture (PacketLog.Capture.Size).
+
+    Sending and receiving threads copy each packet into their own LogRingBuffer without
+    taking a lock. A background thread moves the records into a memory mapped file used as
+    a ring, see PacketCaptureFormat.h, so the capture keeps the newest packets and its size
+    never grows. The mapping is shared, a crash of the server doesn't lose what was drained.
+*/
+class PacketCapture : protected ACE_Task_Base
+{
+    struct ThreadSlot
+    {
+        ThreadSlot() : Buffer(NULL) { }
+        ~ThreadSlot() { if (Buffer) Buffer->Release(); }
+
+        LogRingBuffer* Buffer;                              // owned by PacketCapture, outlives the thread
+    };
+
+    public:
+        PacketCapture();
+        ~PacketCapture();
+
+        /// Creates the capture file of the given ring capacity and starts the writer; false if it can't be mapped
+        bool Open(std::string const& fileName, uint64 capacity);
+
+        void Write(WorldPacket const& packet, Direction direction, uint32 connectionId, uint32 accountId);
+
+    private:
+        int svc();
+
+        LogRingBuffer* GetThreadBuffer();
+        uint32 Drain();
+        /// Advances the file tail until size bytes at head are free
+        void Reclaim(uint64 head, uint64 size);
+        void WriteRecord(char const* record);
+
+        ACE_TSS<ThreadSlot> _slot;
+        std::vector<LogRingBuffer*> _buffers;
+        ACE_Thread_Mutex _lock;                             // guards _buffers, taken once per thread by writers
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint64> _dropped;
+
+        volatile bool _stop;
+
+        // writer thread only
+        ACE_Mem_Map _map;
+        PacketCaptureHeader* _header;
+        char* _data;
+};
+
+#endif
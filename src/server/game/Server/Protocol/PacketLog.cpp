@@ -16,11 +16,13 @@
  */
 
 #include "PacketLog.h"
+#include "PacketCapture.h"
 #include "Config.h"
+#include "Log.h"
 #include "ByteBuffer.h"
 #include "WorldPacket.h"
 
-PacketLog::PacketLog() : _file(NULL)
+PacketLog::PacketLog() : _file(NULL), _capture(NULL), _connectionId(0)
 {
     Initialize();
 }
@@ -31,6 +33,10 @@ PacketLog::~PacketLog()
         fclose(_file);
 
     _file = NULL;
+
+    // writes out the remaining packets
+    delete _capture;
+    _capture = NULL;
 }
 
 void PacketLog::Initialize()
@@ -42,12 +48,31 @@ void PacketLog::Initialize()
             logsDir.push_back('/');
 
     std::string logname = sConfigMgr->GetStringDefault("PacketLogFile", "");
-    if (!logname.empty())
-        _file = fopen((logsDir + logname).c_str(), "wb");
+    if (logname.empty())
+        return;
+
+    if (uint32 captureSize = sConfigMgr->GetIntDefault("PacketLog.Capture.Size", 0))
+    {
+        _capture = new PacketCapture();
+        if (_capture->Open(logsDir + logname, uint64(captureSize) * 1024 * 1024))
+            return;
+
+        IC_LOG_ERROR("network", "PacketLog: could not create the %u MB capture file %s, falling back to the plain packet log", captureSize, (logsDir + logname).c_str());
+        delete _capture;
+        _capture = NULL;
+    }
+
+    _file = fopen((logsDir + logname).c_str(), "wb");
 }
 
-void PacketLog::LogPacket(WorldPacket const& packet, Direction direction)
+void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, uint32 connectionId /*= 0*/, uint32 accountId /*= 0*/)
 {
+    if (_capture)
+    {
+        _capture->Write(packet, direction, connectionId, accountId);
+        return;
+    }
+
     ByteBuffer data(4+4+4+1+packet.size());
     data << int32(packet.GetOpcode());
     data << int32(packet.size());
@@ -19,6 +19,7 @@
 #define INFINITY_PACKETLOG_H
 
 #include "Common.h"
+#include <ace/Atomic_Op.h>
 #include <ace/Singleton.h>
 
 enum Direction
@@ -27,6 +28,7 @@ enum Direction
     SERVER_TO_CLIENT
 };
 
+class PacketCapture;
 class WorldPacket;
 
 class PacketLog
@@ -39,11 +41,16 @@ class PacketLog
 
     public:
         void Initialize();
-        bool CanLogPacket() const { return (_file != NULL); }
-        void LogPacket(WorldPacket const& packet, Direction direction);
+        bool CanLogPacket() const { return (_file != NULL || _capture != NULL); }
+        void LogPacket(WorldPacket const& packet, Direction direction, uint32 connectionId = 0, uint32 accountId = 0);
+
+        /// Identifies a world socket in captures
+        uint32 GenerateConnectionId() { return ++_connectionId; }
 
     private:
         FILE* _file;
+        PacketCapture* _capture;                            // PacketLog.Capture.Size, replaces _file
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> _connectionId;
 };
 
 #define sPacketLog ACE_Singleton<PacketLog, ACE_Thread_Mutex>::instance()
@@ -27,6 +27,7 @@
 #include "AccountMgr.h"
 #include "Log.h"
 #include "Opcodes.h"
+#include "OpcodeStats.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
@@ -141,6 +142,9 @@ WorldSession::~WorldSession()
     while (_recvQueue.next(packet))
         delete packet;
 
+    for (std::deque<WorldPacket*>::const_iterator itr = _delayedPackets.begin(); itr != _delayedPackets.end(); ++itr)
+        delete *itr;
+
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
 }
 
@@ -206,11 +210,14 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     }
 #endif                                                      // !INFINITY_DEBUG
 
+    if (sOpcodeStats->IsEnabled())
+        sOpcodeStats->RecordSend(packet->GetOpcode(), uint32(packet->size()));
+
     if (m_Socket->SendPacket(*packet) == -1)
         m_Socket->CloseSocket();
 }
 
-/// Add an incoming packet to the queue
+/// Add an incoming packet to the queue, called from the network threads
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
     _recvQueue.add(new_packet);
@@ -226,7 +233,8 @@ void WorldSession::LogUnexpectedOpcode(WorldPacket* packet, const char* status,
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnprocessedTail(WorldPacket* packet)
 {
-    if (!sLog->ShouldLog("network.opcode", LOG_LEVEL_TRACE) || packet->rpos() >= packet->wpos())
+    static LogSite logSite = { "network.opcode", NULL, 0 };
+    if (!sLog->ShouldLog(logSite, LOG_LEVEL_TRACE) || packet->rpos() >= packet->wpos())
         return;
 
     IC_LOG_TRACE("network.opcode", "Unprocessed tail data (read stop at %u from %u) Opcode %s from %s",
@@ -234,6 +242,29 @@ void WorldSession::LogUnprocessedTail(WorldPacket* packet)
     packet->print_storage();
 }
 
+/// Call the opcode handler, timing it if opcode statistics are enabled
+void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* packet)
+{
+    sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
+
+    if (!sOpcodeStats->IsEnabled())
+    {
+        (this->*opHandle.handler)(*packet);
+        LogUnprocessedTail(packet);
+        return;
+    }
+
+    // the handler may consume or resize the packet, remember what we were given
+    uint16 opcode = packet->GetOpcode();
+    uint32 size = uint32(packet->size());
+    uint64 startTime = getUSTime();
+
+    (this->*opHandle.handler)(*packet);
+
+    sOpcodeStats->RecordHandler(opcode, size, GetUSTimeDiffToNow(startTime));
+    LogUnprocessedTail(packet);
+}
+
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 {
@@ -250,19 +281,24 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     WorldPacket* packet = NULL;
     //! Delete packet after processing by default
     bool deletePacket = true;
-    //! To prevent infinite loop
-    WorldPacket* firstDelayedPacket = NULL;
-    //! If _recvQueue.peek() == firstDelayedPacket it means that in this Update call, we've processed all
-    //! *properly timed* packets, and we're now at the part of the queue where we find
-    //! delayed packets that were re-enqueued due to improper timing. To prevent an infinite
-    //! loop caused by re-enqueueing the same packets over and over again, we stop updating this session
-    //! and continue updating others. The re-enqueued packets will be handled in the next Update call for this session.
+    //! Packets delayed by an earlier call arrived before anything still in _recvQueue,
+    //! retry them first once the player they were waiting for is known.
+    bool retryDelayed = !_delayedPackets.empty() && (_player || m_playerRecentlyLogout);
     uint32 processedPackets = 0;
 
-    while (m_Socket && !m_Socket->IsClosed() &&
-            !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket &&
-            _recvQueue.next(packet, updater))
+    while (m_Socket && !m_Socket->IsClosed())
     {
+        if (retryDelayed && !_delayedPackets.empty())
+        {
+            if (!updater.Process(_delayedPackets.front()))
+                break;
+
+            packet = _delayedPackets.front();
+            _delayedPackets.pop_front();
+        }
+        else if (!_recvQueue.next(packet, updater))
+            break;
+
         if (!AntiDOS.EvaluateOpcode(*packet))
         {
             KickPlayer();
@@ -285,26 +321,19 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         {
                             // skip STATUS_LOGGEDIN opcode unexpected errors if player logout sometime ago - this can be network lag delayed packets
                             //! If player didn't log out a while ago, it means packets are being sent while the server does not recognize
-                            //! the client to be in world yet. We will re-add the packets to the bottom of the queue and process them later.
+                            //! the client to be in world yet. We keep them aside and process them once the player is loaded.
                             if (!m_playerRecentlyLogout)
                             {
-                                //! Prevent infinite loop
-                                if (!firstDelayedPacket)
-                                    firstDelayedPacket = packet;
                                 //! Because checking a bool is faster than reallocating memory
                                 deletePacket = false;
-                                QueuePacket(packet);
+                                _delayedPackets.push_back(packet);
                                 //! Log
-                                IC_LOG_DEBUG("network", "Re-enqueueing packet with opcode %s with with status STATUS_LOGGEDIN. "
+                                IC_LOG_DEBUG("network", "Delaying packet with opcode %s with with status STATUS_LOGGEDIN. "
                                     "Player is currently not in world yet.", GetOpcodeNameForLogging(packet->GetOpcode()).c_str());
                             }
                         }
                         else if (_player->IsInWorld())
-                        {
-                            sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                            (this->*opHandle.handler)(*packet);
-                            LogUnprocessedTail(packet);
-                        }
+                            ExecuteOpcode(opHandle, packet);
                         // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
                         break;
                     case STATUS_AUTHED:
@@ -320,9 +349,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         if (packet->GetOpcode() == CMSG_CHAR_ENUM)
                             m_playerRecentlyLogout = false;
 
-                        sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                        (this->*opHandle.handler)(*packet);
-                        LogUnprocessedTail(packet);
+                        ExecuteOpcode(opHandle, packet);
                         break;
                     case STATUS_NEVER:
                         IC_LOG_ERROR("network.opcode", "Received not allowed opcode %s from %s", GetOpcodeNameForLogging(packet->GetOpcode()).c_str()
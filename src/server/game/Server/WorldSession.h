@@ -30,6 +30,7 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "Cryptography/BigNumber.h"
+#include "Threading/MPSCQueue.h"
 #include "AccountMgr.h"
 
 class Creature;
@@ -51,6 +52,7 @@ struct AuctionEntry;
 struct DeclinedName;
 struct ItemTemplate;
 struct MovementInfo;
+struct OpcodeHandler;
 
 enum AccountDataType
 {
@@ -830,6 +832,9 @@ class WorldSession
         void LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
 
+        // runs the opcode handler and feeds OpcodeStats when enabled
+        void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* packet);
+
         // EnumData helpers
         bool IsLegitCharacterForAccount(uint32 lowGUID)
         {
@@ -870,7 +875,10 @@ class WorldSession
         AddonsList m_addonsList;
         uint32 recruiterId;
         bool isRecruiter;
-        ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+        // filled by the network threads, consumed by whichever of World/Map currently updates the session
+        MPSCQueue<WorldPacket*> _recvQueue;
+        // STATUS_LOGGEDIN packets received before the player was loaded, consumer only
+        std::deque<WorldPacket*> _delayedPackets;
         time_t timeLastWhoCommand;
         rbac::RBACData* _RBACData;
 };
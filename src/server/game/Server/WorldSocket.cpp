@@ -103,7 +103,7 @@ WorldSocket::WorldSocket (void): WorldHandler(),
 m_LastPingTime(ACE_Time_Value::zero), m_OverSpeedPings(0), m_Session(0),
 m_RecvWPct(0), m_RecvPct(), m_Header(sizeof (ClientPktHeader)),
 m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false),
-m_Seed(static_cast<uint32> (rand32()))
+m_Seed(static_cast<uint32> (rand32())), m_ConnectionId(sPacketLog->GenerateConnectionId())
 {
     reference_counting_policy().value (ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
 
@@ -161,7 +161,7 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
 
     // Dump outgoing packet
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(pct, SERVER_TO_CLIENT);
+        sPacketLog->LogPacket(pct, SERVER_TO_CLIENT, m_ConnectionId, m_Session ? m_Session->GetAccountId() : 0);
 
     WorldPacket const* pkt = &pct;
 
@@ -670,7 +670,7 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
 
     // Dump received packet.
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(*new_pct, CLIENT_TO_SERVER);
+        sPacketLog->LogPacket(*new_pct, CLIENT_TO_SERVER, m_ConnectionId, m_Session ? m_Session->GetAccountId() : 0);
 
     std::string opcodeName = GetOpcodeNameForLogging(opcode);
     if (m_Session)
@@ -208,6 +208,9 @@ class WorldSocket : public WorldHandler
 
         uint32 m_Seed;
 
+        /// Identifies the socket in packet captures
+        uint32 m_ConnectionId;
+
 };
 
 #endif  /* _WORLDSOCKET_H */
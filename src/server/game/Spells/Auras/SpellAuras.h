@@ -19,6 +19,7 @@
 #ifndef INFINITY_SPELLAURAS_H
 #define INFINITY_SPELLAURAS_H
 
+#include "FreeListPool.h"
 #include "SpellAuraDefines.h"
 #include "SpellInfo.h"
 #include "Unit.h"
@@ -60,6 +61,8 @@ class AuraApplication
         void _InitFlags(Unit* caster, uint8 effMask);
         void _HandleEffect(uint8 effIndex, bool apply);
     public:
+        static void* operator new(size_t size) { return FreeListPool<AuraApplication>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { FreeListPool<AuraApplication>::Deallocate(ptr, size); }
 
         Unit* GetTarget() const { return _target; }
         Aura* GetBase() const { return _base; }
@@ -272,6 +275,9 @@ class UnitAura : public Aura
     protected:
         explicit UnitAura(SpellInfo const* spellproto, uint8 effMask, WorldObject* owner, Unit* caster, int32 *baseAmount, Item* castItem, uint64 casterGUID);
     public:
+        static void* operator new(size_t size) { return FreeListPool<UnitAura>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { FreeListPool<UnitAura>::Deallocate(ptr, size); }
+
         void _ApplyForTarget(Unit* target, Unit* caster, AuraApplication * aurApp);
         void _UnapplyForTarget(Unit* target, Unit* caster, AuraApplication * aurApp);
 
@@ -293,6 +299,9 @@ class DynObjAura : public Aura
     protected:
         explicit DynObjAura(SpellInfo const* spellproto, uint8 effMask, WorldObject* owner, Unit* caster, int32 *baseAmount, Item* castItem, uint64 casterGUID);
     public:
+        static void* operator new(size_t size) { return FreeListPool<DynObjAura>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { FreeListPool<DynObjAura>::Deallocate(ptr, size); }
+
         void Remove(AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
 
         void FillTargetMap(std::map<Unit*, uint8> & targets, Unit* caster);
@@ -838,6 +838,11 @@ SpellInfo::SpellInfo(SpellEntry const* spellEntry)
     for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         Effects[i] = SpellEffectInfo(spellEntry, this, i);
 
+    ExplicitTargetMask = 0;
+    InfoFlags = 0;
+    AllEffectsMechanicMask = 0;
+    SpellSpecific = SPELL_SPECIFIC_NORMAL;
+    AuraState = AURA_STATE_NONE;
     ChainEntry = NULL;
 }
 
@@ -864,10 +869,7 @@ bool SpellInfo::HasAura(AuraType aura) const
 
 bool SpellInfo::HasAreaAuraEffect() const
 {
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].IsAreaAuraEffect())
-            return true;
-    return false;
+    return InfoFlags & SPELL_INFO_FLAG_AREA_AURA_EFFECT;
 }
 
 bool SpellInfo::IsExplicitDiscovery() const
@@ -971,19 +973,13 @@ bool SpellInfo::IsAbilityOfSkillType(uint32 skillType) const
 
 bool SpellInfo::IsAffectingArea() const
 {
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].IsEffect() && (Effects[i].IsTargetingArea() || Effects[i].IsEffect(SPELL_EFFECT_PERSISTENT_AREA_AURA) || Effects[i].IsAreaAuraEffect()))
-            return true;
-    return false;
+    return InfoFlags & SPELL_INFO_FLAG_AFFECTING_AREA;
 }
 
 // checks if spell targets are selected from area, doesn't include spell effects in check (like area wide auras for example)
 bool SpellInfo::IsTargetingArea() const
 {
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].IsEffect() && Effects[i].IsTargetingArea())
-            return true;
-    return false;
+    return InfoFlags & SPELL_INFO_FLAG_TARGETING_AREA;
 }
 
 bool SpellInfo::NeedsExplicitUnitTarget() const
@@ -1043,40 +1039,12 @@ bool SpellInfo::IsAutocastable() const
 
 bool SpellInfo::IsStackableWithRanks() const
 {
-    if (IsPassive())
-        return false;
-    if (PowerType != POWER_MANA && PowerType != POWER_HEALTH)
-        return false;
-    if (IsProfessionOrRiding())
-        return false;
-
-    if (IsAbilityLearnedWithProfession())
-        return false;
-
-    // All stance spells. if any better way, change it.
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-    {
-        switch (SpellFamilyName)
-        {
-            case SPELLFAMILY_PALADIN:
-                // Paladin aura Spell
-                if (Effects[i].Effect == SPELL_EFFECT_APPLY_AREA_AURA_RAID)
-                    return false;
-                break;
-            case SPELLFAMILY_DRUID:
-                // Druid form Spell
-                if (Effects[i].Effect == SPELL_EFFECT_APPLY_AURA &&
-                    Effects[i].ApplyAuraName == SPELL_AURA_MOD_SHAPESHIFT)
-                    return false;
-                break;
-        }
-    }
-    return true;
+    return InfoFlags & SPELL_INFO_FLAG_STACKABLE_WITH_RANKS;
 }
 
 bool SpellInfo::IsPassiveStackableWithRanks() const
 {
-    return IsPassive() && !HasEffect(SPELL_EFFECT_APPLY_AURA);
+    return InfoFlags & SPELL_INFO_FLAG_PASSIVE_STACKABLE_WITH_RANKS;
 }
 
 bool SpellInfo::IsMultiSlotAura() const
@@ -1211,19 +1179,7 @@ bool SpellInfo::CanDispelAura(SpellInfo const* aura) const
 
 bool SpellInfo::IsSingleTarget() const
 {
-    // all other single target spells have if it has AttributesEx5
-    if (AttributesEx5 & SPELL_ATTR5_SINGLE_TARGET_SPELL)
-        return true;
-
-    switch (GetSpellSpecific())
-    {
-        case SPELL_SPECIFIC_JUDGEMENT:
-            return true;
-        default:
-            break;
-    }
-
-    return false;
+    return InfoFlags & SPELL_INFO_FLAG_SINGLE_TARGET;
 }
 
 bool SpellInfo::IsAuraExclusiveBySpecificWith(SpellInfo const* spellInfo) const
@@ -1651,13 +1607,7 @@ SpellSchoolMask SpellInfo::GetSchoolMask() const
 
 uint32 SpellInfo::GetAllEffectsMechanicMask() const
 {
-    uint32 mask = 0;
-    if (Mechanic)
-        mask |= 1 << Mechanic;
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].IsEffect() && Effects[i].Mechanic)
-            mask |= 1 << Effects[i].Mechanic;
-    return mask;
+    return AllEffectsMechanicMask;
 }
 
 uint32 SpellInfo::GetEffectMechanicMask(uint8 effIndex) const
@@ -1692,10 +1642,7 @@ Mechanics SpellInfo::GetEffectMechanic(uint8 effIndex) const
 
 bool SpellInfo::HasAnyEffectMechanic() const
 {
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].Mechanic)
-            return true;
-    return false;
+    return InfoFlags & SPELL_INFO_FLAG_ANY_EFFECT_MECHANIC;
 }
 
 uint32 SpellInfo::GetDispelMask() const
@@ -1718,9 +1665,19 @@ uint32 SpellInfo::GetExplicitTargetMask() const
 }
 
 AuraStateType SpellInfo::GetAuraState() const
+{
+    return AuraState;
+}
+
+SpellSpecificType SpellInfo::GetSpellSpecific() const
+{
+    return SpellSpecific;
+}
+
+AuraStateType SpellInfo::_ComputeAuraState() const
 {
     // Seals
-    if (GetSpellSpecific() == SPELL_SPECIFIC_SEAL)
+    if (SpellSpecific == SPELL_SPECIFIC_SEAL)
         return AURA_STATE_JUDGEMENT;
 
     // Conflagrate aura state on Immolate and Shadowflame
@@ -1756,7 +1713,7 @@ AuraStateType SpellInfo::GetAuraState() const
         return AURA_STATE_ENRAGE;
 
     // Bleeding aura state
-    if (GetAllEffectsMechanicMask() & 1<<MECHANIC_BLEED)
+    if (AllEffectsMechanicMask & 1<<MECHANIC_BLEED)
         return AURA_STATE_BLEEDING;
 
     if (GetSchoolMask() & SPELL_SCHOOL_MASK_FROST)
@@ -1777,7 +1734,7 @@ AuraStateType SpellInfo::GetAuraState() const
     return AURA_STATE_NONE;
 }
 
-SpellSpecificType SpellInfo::GetSpellSpecific() const
+SpellSpecificType SpellInfo::_ComputeSpellSpecific() const
 {
     switch (SpellFamilyName)
     {
@@ -2242,6 +2199,72 @@ void SpellInfo::_InitializeExplicitTargetMask()
     ExplicitTargetMask = targetMask;
 }
 
+void SpellInfo::_InitializePrecomputedData()
+{
+    uint32 flags = 0;
+    uint32 mechanicMask = 0;
+    if (Mechanic)
+        mechanicMask |= 1 << Mechanic;
+
+    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+    {
+        if (Effects[i].Mechanic)
+            flags |= SPELL_INFO_FLAG_ANY_EFFECT_MECHANIC;
+
+        if (Effects[i].IsAreaAuraEffect())
+            flags |= SPELL_INFO_FLAG_AREA_AURA_EFFECT;
+
+        if (!Effects[i].IsEffect())
+            continue;
+
+        if (Effects[i].Mechanic)
+            mechanicMask |= 1 << Effects[i].Mechanic;
+
+        if (Effects[i].IsTargetingArea())
+            flags |= SPELL_INFO_FLAG_TARGETING_AREA | SPELL_INFO_FLAG_AFFECTING_AREA;
+        else if (Effects[i].IsEffect(SPELL_EFFECT_PERSISTENT_AREA_AURA) || Effects[i].IsAreaAuraEffect())
+            flags |= SPELL_INFO_FLAG_AFFECTING_AREA;
+    }
+
+    AllEffectsMechanicMask = mechanicMask;
+    SpellSpecific = _ComputeSpellSpecific();
+    AuraState = _ComputeAuraState();
+
+    // all other single target spells have if it has AttributesEx5
+    if (AttributesEx5 & SPELL_ATTR5_SINGLE_TARGET_SPELL || SpellSpecific == SPELL_SPECIFIC_JUDGEMENT)
+        flags |= SPELL_INFO_FLAG_SINGLE_TARGET;
+
+    if (IsPassive() && !HasEffect(SPELL_EFFECT_APPLY_AURA))
+        flags |= SPELL_INFO_FLAG_PASSIVE_STACKABLE_WITH_RANKS;
+
+    bool stackableWithRanks = !IsPassive() && (PowerType == POWER_MANA || PowerType == POWER_HEALTH)
+        && !IsProfessionOrRiding() && !IsAbilityLearnedWithProfession();
+
+    // All stance spells. if any better way, change it.
+    for (uint8 i = 0; i < MAX_SPELL_EFFECTS && stackableWithRanks; ++i)
+    {
+        switch (SpellFamilyName)
+        {
+            case SPELLFAMILY_PALADIN:
+                // Paladin aura Spell
+                if (Effects[i].Effect == SPELL_EFFECT_APPLY_AREA_AURA_RAID)
+                    stackableWithRanks = false;
+                break;
+            case SPELLFAMILY_DRUID:
+                // Druid form Spell
+                if (Effects[i].Effect == SPELL_EFFECT_APPLY_AURA &&
+                    Effects[i].ApplyAuraName == SPELL_AURA_MOD_SHAPESHIFT)
+                    stackableWithRanks = false;
+                break;
+        }
+    }
+
+    if (stackableWithRanks)
+        flags |= SPELL_INFO_FLAG_STACKABLE_WITH_RANKS;
+
+    InfoFlags = flags;
+}
+
 bool SpellInfo::_IsPositiveEffect(uint8 effIndex, bool deep) const
 {
     // not found a single positive spell with this attribute
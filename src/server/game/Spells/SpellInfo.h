@@ -188,6 +188,18 @@ enum SpellCustomAttributes
     SPELL_ATTR0_CU_NEGATIVE                      = SPELL_ATTR0_CU_NEGATIVE_EFF0 | SPELL_ATTR0_CU_NEGATIVE_EFF1 | SPELL_ATTR0_CU_NEGATIVE_EFF2
 };
 
+// Properties derived from effects and attributes, filled by SpellMgr::LoadSpellInfoPrecomputedData
+enum SpellInfoFlags
+{
+    SPELL_INFO_FLAG_AFFECTING_AREA               = 0x00000001,
+    SPELL_INFO_FLAG_TARGETING_AREA               = 0x00000002,
+    SPELL_INFO_FLAG_AREA_AURA_EFFECT             = 0x00000004,
+    SPELL_INFO_FLAG_ANY_EFFECT_MECHANIC          = 0x00000008,
+    SPELL_INFO_FLAG_SINGLE_TARGET                = 0x00000010,
+    SPELL_INFO_FLAG_STACKABLE_WITH_RANKS         = 0x00000020,
+    SPELL_INFO_FLAG_PASSIVE_STACKABLE_WITH_RANKS = 0x00000040
+};
+
 uint32 GetTargetFlagMask(SpellTargetObjectTypes objType);
 
 class SpellImplicitTargetInfo
@@ -364,6 +376,10 @@ public:
     uint32 SchoolMask;
     SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
     uint32 ExplicitTargetMask;
+    uint32 InfoFlags;
+    uint32 AllEffectsMechanicMask;
+    SpellSpecificType SpellSpecific;
+    AuraStateType AuraState;
     SpellChainNode const* ChainEntry;
 
     SpellInfo(SpellEntry const* spellEntry);
@@ -463,6 +479,9 @@ public:
 
     // loading helpers
     void _InitializeExplicitTargetMask();
+    void _InitializePrecomputedData();
+    SpellSpecificType _ComputeSpellSpecific() const;
+    AuraStateType _ComputeAuraState() const;
     bool _IsPositiveEffect(uint8 effIndex, bool deep) const;
     bool _IsPositiveSpell() const;
     static bool _IsPositiveTarget(uint32 targetA, uint32 targetB);
@@ -335,7 +335,7 @@ bool IsDiminishingReturnsGroupDurationLimited(DiminishingGroup group)
     }
 }
 
-SpellMgr::SpellMgr() { }
+SpellMgr::SpellMgr() : mSpellGroupDataVersion(0), mSpellProcDataVersion(0) { }
 
 SpellMgr::~SpellMgr()
 {
@@ -507,11 +507,11 @@ SpellInfo const* SpellMgr::GetSpellForDifficultyFromSpell(SpellInfo const* spell
 
 SpellChainNode const* SpellMgr::GetSpellChainNode(uint32 spell_id) const
 {
-    SpellChainMap::const_iterator itr = mSpellChains.find(spell_id);
-    if (itr == mSpellChains.end())
-        return NULL;
+    // every node of mSpellChains is linked from its SpellInfo
+    if (SpellInfo const* spellInfo = GetSpellInfo(spell_id))
+        return spellInfo->ChainEntry;
 
-    return &itr->second;
+    return NULL;
 }
 
 uint32 SpellMgr::GetFirstSpellInChain(uint32 spell_id) const
@@ -753,10 +753,20 @@ SpellGroupStackRule SpellMgr::CheckSpellGroupStackRules(SpellInfo const* spellIn
 
 SpellProcEventEntry const* SpellMgr::GetSpellProcEvent(uint32 spellId) const
 {
-    SpellProcEventMap::const_iterator itr = mSpellProcEventMap.find(spellId);
-    if (itr != mSpellProcEventMap.end())
-        return &itr->second;
-    return NULL;
+    return mSpellProcEventMap.find(spellId);
+}
+
+uint32 SpellMgr::GetSpellProcEventFlags(SpellInfo const* spellInfo) const
+{
+    // handled by the spell_proc system
+    if (GetSpellProcEntry(spellInfo->Id))
+        return 0;
+
+    SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellInfo->Id);
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+
+    return spellInfo->ProcFlags;
 }
 
 bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active) const
@@ -890,10 +900,7 @@ bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellPr
 
 SpellProcEntry const* SpellMgr::GetSpellProcEntry(uint32 spellId) const
 {
-    SpellProcMap::const_iterator itr = mSpellProcMap.find(spellId);
-    if (itr != mSpellProcMap.end())
-        return &itr->second;
-    return NULL;
+    return mSpellProcMap.find(spellId);
 }
 
 bool SpellMgr::CanSpellTriggerProcOnEvent(SpellProcEntry const& procEntry, ProcEventInfo& eventInfo) const
@@ -964,32 +971,21 @@ bool SpellMgr::CanSpellTriggerProcOnEvent(SpellProcEntry const& procEntry, ProcE
 SpellBonusEntry const* SpellMgr::GetSpellBonusData(uint32 spellId) const
 {
     // Lookup data
-    SpellBonusMap::const_iterator itr = mSpellBonusMap.find(spellId);
-    if (itr != mSpellBonusMap.end())
-        return &itr->second;
+    if (SpellBonusEntry const* bonus = mSpellBonusMap.find(spellId))
+        return bonus;
     // Not found, try lookup for 1 spell rank if exist
     if (uint32 rank_1 = GetFirstSpellInChain(spellId))
-    {
-        SpellBonusMap::const_iterator itr2 = mSpellBonusMap.find(rank_1);
-        if (itr2 != mSpellBonusMap.end())
-            return &itr2->second;
-    }
+        return mSpellBonusMap.find(rank_1);
     return NULL;
 }
 
 SpellThreatEntry const* SpellMgr::GetSpellThreatEntry(uint32 spellID) const
 {
-    SpellThreatMap::const_iterator itr = mSpellThreatMap.find(spellID);
-    if (itr != mSpellThreatMap.end())
-        return &itr->second;
-    else
-    {
-        uint32 firstSpell = GetFirstSpellInChain(spellID);
-        itr = mSpellThreatMap.find(firstSpell);
-        if (itr != mSpellThreatMap.end())
-            return &itr->second;
-    }
-    return NULL;
+    if (SpellThreatEntry const* threat = mSpellThreatMap.find(spellID))
+        return threat;
+
+    uint32 firstSpell = GetFirstSpellInChain(spellID);
+    return mSpellThreatMap.find(firstSpell);
 }
 
 SkillLineAbilityMapBounds SpellMgr::GetSkillLineAbilityMapBounds(uint32 spell_id) const
@@ -1593,6 +1589,7 @@ void SpellMgr::LoadSpellGroups()
 
     mSpellSpellGroup.clear();                                  // need for reload case
     mSpellGroupSpell.clear();
+    ++mSpellGroupDataVersion;                                  // units drop their cached aura modifiers
 
     //                                                0     1
     QueryResult result = WorldDatabase.Query("SELECT id, spell_id FROM spell_group");
@@ -1672,6 +1669,7 @@ void SpellMgr::LoadSpellGroupStackRules()
     uint32 oldMSTime = getMSTime();
 
     mSpellGroupStack.clear();                                  // need for reload case
+    ++mSpellGroupDataVersion;                                  // units drop their cached aura modifiers
 
     //                                                       0         1
     QueryResult result = WorldDatabase.Query("SELECT group_id, stack_rule FROM spell_group_stack_rules");
@@ -1715,6 +1713,7 @@ void SpellMgr::LoadSpellProcEvents()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcEventMap.clear();                             // need for reload case
+    ++mSpellProcDataVersion;                                // units rebuild their proc aura index
 
     //                                                0      1           2                3                 4                 5                 6          7       8        9             10
     QueryResult result = WorldDatabase.Query("SELECT entry, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, procFlags, procEx, ppmRate, CustomChance, Cooldown FROM spell_proc_event");
@@ -1773,7 +1772,7 @@ void SpellMgr::LoadSpellProcEvents()
 
         while (spellInfo)
         {
-            if (mSpellProcEventMap.find(spellInfo->Id) != mSpellProcEventMap.end())
+            if (mSpellProcEventMap.count(spellInfo->Id))
             {
                 IC_LOG_ERROR("sql.sql", "Spell %u listed in `spell_proc_event` already has its first rank in table.", spellInfo->Id);
                 break;
@@ -1802,6 +1801,7 @@ void SpellMgr::LoadSpellProcs()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcMap.clear();                             // need for reload case
+    ++mSpellProcDataVersion;                           // units rebuild their proc aura index
 
     //                                                 0        1           2                3                 4                 5                 6         7              8               9        10              11             12      13        14
     QueryResult result = WorldDatabase.Query("SELECT spellId, schoolMask, spellFamilyName, spellFamilyMask0, spellFamilyMask1, spellFamilyMask2, typeMask, spellTypeMask, spellPhaseMask, hitMask, attributesMask, ratePerMinute, chance, cooldown, charges FROM spell_proc");
@@ -1864,7 +1864,7 @@ void SpellMgr::LoadSpellProcs()
 
         while (spellInfo)
         {
-            if (mSpellProcMap.find(spellInfo->Id) != mSpellProcMap.end())
+            if (mSpellProcMap.count(spellInfo->Id))
             {
                 IC_LOG_ERROR("sql.sql", "Spell %u listed in `spell_proc` already has its first rank in table.", spellInfo->Id);
                 break;
@@ -2925,6 +2925,18 @@ void SpellMgr::LoadSpellInfoCustomAttributes()
     IC_LOG_INFO("server.loading", ">> Loaded SpellInfo custom attributes in %u ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
+void SpellMgr::LoadSpellInfoPrecomputedData()
+{
+    uint32 oldMSTime = getMSTime();
+
+    // must be after LoadSpellRanks, spell specifics of generic spells depend on the first rank
+    for (uint32 i = 0; i < GetSpellInfoStoreSize(); ++i)
+        if (SpellInfo* spellInfo = mSpellInfoMap[i])
+            spellInfo->_InitializePrecomputedData();
+
+    IC_LOG_INFO("server.loading", ">> Loaded SpellInfo precomputed data in %u ms", GetMSTimeDiffToNow(oldMSTime));
+}
+
 void SpellMgr::LoadSpellInfoCorrections()
 {
     uint32 oldMSTime = getMSTime();
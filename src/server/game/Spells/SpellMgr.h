@@ -24,6 +24,7 @@
 #include <ace/Singleton.h>
 
 #include "DBCStructure.h"
+#include "DenseIdMap.h"
 #include "SharedDefines.h"
 #include "UnorderedMap.h"
 #include "Util.h"
@@ -282,7 +283,7 @@ struct SpellProcEventEntry
     uint32      cooldown;                                   // hidden cooldown used for some spell proc events, applied to _triggered_spell_
 };
 
-typedef UNORDERED_MAP<uint32, SpellProcEventEntry> SpellProcEventMap;
+typedef DenseIdMap<SpellProcEventEntry> SpellProcEventMap;
 
 struct SpellProcEntry
 {
@@ -300,7 +301,7 @@ struct SpellProcEntry
     uint32      charges;                                    // if nonzero - owerwrite procCharges field for given Spell.dbc entry, defines how many times proc can occur before aura remove, 0 - infinite
 };
 
-typedef UNORDERED_MAP<uint32, SpellProcEntry> SpellProcMap;
+typedef DenseIdMap<SpellProcEntry> SpellProcMap;
 
 struct SpellEnchantProcEntry
 {
@@ -319,7 +320,7 @@ struct SpellBonusEntry
     float  ap_dot_bonus;
 };
 
-typedef UNORDERED_MAP<uint32, SpellBonusEntry>     SpellBonusMap;
+typedef DenseIdMap<SpellBonusEntry> SpellBonusMap;
 
 enum SpellGroup
 {
@@ -360,7 +361,7 @@ struct SpellThreatEntry
     float       apPctMod;                                   // Pct of AP that is added as Threat - default: 0.0f
 };
 
-typedef std::map<uint32, SpellThreatEntry> SpellThreatMap;
+typedef DenseIdMap<SpellThreatEntry> SpellThreatMap;
 
 // coordinates for spells (accessed using SpellMgr functions)
 struct SpellTargetPosition
@@ -572,7 +573,7 @@ typedef std::vector<bool> EnchantCustomAttribute;
 
 typedef std::vector<SpellInfo*> SpellInfoMap;
 
-typedef std::map<int32, std::vector<int32> > SpellLinkedMap;
+typedef UNORDERED_MAP<int32, std::vector<int32> > SpellLinkedMap;
 
 bool IsPrimaryProfessionSkill(uint32 skill);
 
@@ -649,10 +650,16 @@ class SpellMgr
         // Spell Group Stack Rules table
         bool AddSameEffectStackRuleSpellGroups(SpellInfo const* spellInfo, int32 amount, std::map<SpellGroup, int32>& groups) const;
         SpellGroupStackRule CheckSpellGroupStackRules(SpellInfo const* spellInfo1, SpellInfo const* spellInfo2) const;
+        // changes whenever spell_group or spell_group_stack_rules is (re)loaded
+        uint32 GetSpellGroupDataVersion() const { return mSpellGroupDataVersion; }
 
         // Spell proc event table
         SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const;
         bool IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active) const;
+        // proc flags an aura of this spell reacts to in the spell_proc_event system, 0 if it never procs there
+        uint32 GetSpellProcEventFlags(SpellInfo const* spellInfo) const;
+        // changes whenever spell_proc_event or spell_proc is (re)loaded
+        uint32 GetSpellProcDataVersion() const { return mSpellProcDataVersion; }
 
         // Spell proc table
         SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const;
@@ -720,6 +727,7 @@ class SpellMgr
         void UnloadSpellInfoImplicitTargetConditionLists();
         void LoadSpellInfoCustomAttributes();
         void LoadSpellInfoCorrections();
+        void LoadSpellInfoPrecomputedData();
 
     private:
         SpellDifficultySearcherMap mSpellDifficultySearcherMap;
@@ -732,8 +740,10 @@ class SpellMgr
         SpellSpellGroupMap         mSpellSpellGroup;
         SpellGroupSpellMap         mSpellGroupSpell;
         SpellGroupStackMap         mSpellGroupStack;
+        uint32                     mSpellGroupDataVersion;
         SpellProcEventMap          mSpellProcEventMap;
         SpellProcMap               mSpellProcMap;
+        uint32                     mSpellProcDataVersion;
         SpellBonusMap              mSpellBonusMap;
         SpellThreatMap             mSpellThreatMap;
         SpellPetAuraMap            mSpellPetAuraMap;
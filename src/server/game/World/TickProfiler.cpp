@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TickProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    char const* const WorldTickPhaseNames[MAX_WORLD_TICK_PHASES] =
+    {
+        "Auctions",
+        "Sessions",
+        "Weather",
+        "LoginDatabase",
+        "Maps",
+        "Battlegrounds",
+        "OutdoorPvP",
+        "QueryCallbacks",
+        "GameEvents",
+        "InstanceResets",
+        "CliCommands",
+        "Other"
+    };
+
+    char const* const MapTickPhaseNames[MAX_MAP_TICK_PHASES] =
+    {
+        "Sessions",
+        "Players",
+        "Cells",
+        "ActiveObjects",
+        "Transports",
+        "Scripts",
+        "MoveLists",
+        "Relocation",
+        "Other"
+    };
+
+    char const* const MapTickSectionNames[MAX_MAP_TICK_SECTIONS] =
+    {
+        "SpellCasts",
+        "TargetSearch",
+        "Auras",
+        "Melee",
+        "Procs",
+        "Threat"
+    };
+
+    uint32 GetPercentile(std::vector<uint32>& values, float percentile)
+    {
+        if (values.empty())
+            return 0;
+
+        size_t index = size_t(values.size() * percentile / 100.0f);
+        if (index >= values.size())
+            index = values.size() - 1;
+
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    TickPhaseStats GetStats(std::vector<uint32>& values)
+    {
+        TickPhaseStats stats;
+        if (values.empty())
+            return stats;
+
+        uint64 total = 0;
+        for (std::vector<uint32>::const_iterator itr = values.begin(); itr != values.end(); ++itr)
+        {
+            total += *itr;
+            stats.Max = std::max(stats.Max, *itr);
+        }
+
+        stats.Average = uint32(total / values.size());
+        stats.P50 = GetPercentile(values, 50.0f);
+        stats.P99 = GetPercentile(values, 99.0f);
+        return stats;
+    }
+
+    std::string GetProfileName(TickProfile const& profile)
+    {
+        if (profile.GetType() == TICK_PROFILE_WORLD)
+            return "World";
+
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "%s (map %u instance %u)", profile.GetName() ? profile.GetName() : "", profile.GetMapId(), profile.GetInstanceId());
+        return buffer;
+    }
+}
+
+TickProfile::TickProfile(TickProfileType type, uint32 mapId, uint32 instanceId, char const* name) :
+    _type(type), _mapId(mapId), _instanceId(instanceId), _name(name), _next(0), _count(0), _totalTicks(0)
+{
+}
+
+void TickProfile::Add(TickSample const& sample)
+{
+    // memory is only spent on profiles that actually receive ticks
+    if (_samples.empty())
+        _samples.resize(TICK_PROFILER_WINDOW);
+
+    _samples[_next] = sample;
+    _next = (_next + 1) % TICK_PROFILER_WINDOW;
+    if (_count < TICK_PROFILER_WINDOW)
+        ++_count;
+
+    ++_totalTicks;
+}
+
+TickPhaseStats TickProfile::GetPhaseStats(uint8 phase) const
+{
+    std::vector<uint32> values;
+    values.reserve(_count);
+    for (uint32 i = 0; i < _count; ++i)
+        values.push_back(phase < MAX_TICK_PHASES ? _samples[i].Phases[phase] : _samples[i].Duration);
+
+    return GetStats(values);
+}
+
+TickPhaseStats TickProfile::GetSectionStats(uint8 section) const
+{
+    std::vector<uint32> values;
+    values.reserve(_count);
+    for (uint32 i = 0; i < _count; ++i)
+        values.push_back(_samples[i].Sections[section]);
+
+    return GetStats(values);
+}
+
+void TickProfile::GetSamples(std::vector<TickSample>& samples) const
+{
+    samples.clear();
+    samples.reserve(_count);
+
+    uint32 first = _count < TICK_PROFILER_WINDOW ? 0 : _next;
+    for (uint32 i = 0; i < _count; ++i)
+        samples.push_back(_samples[(first + i) % TICK_PROFILER_WINDOW]);
+}
+
+TickProfiler::TickProfiler() : _enabled(false), _world(TICK_PROFILE_WORLD, 0, 0, "World")
+{
+}
+
+TickProfiler::~TickProfiler()
+{
+    for (MapProfileContainer::iterator itr = _maps.begin(); itr != _maps.end(); ++itr)
+        delete itr->second;
+}
+
+void TickProfiler::Reset()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+
+    _world = TickProfile(TICK_PROFILE_WORLD, 0, 0, "World");
+    for (MapProfileContainer::iterator itr = _maps.begin(); itr != _maps.end(); ++itr)
+        delete itr->second;
+    _maps.clear();
+}
+
+void TickProfiler::SubmitWorldTick(TickSample const& sample)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    _world.Add(sample);
+}
+
+void TickProfiler::SubmitMapTick(uint32 mapId, uint32 instanceId, char const* name, TickSample const& sample)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+
+    TickProfile*& profile = _maps[MapKey(mapId, instanceId)];
+    if (!profile)
+        profile = new TickProfile(TICK_PROFILE_MAP, mapId, instanceId, name);
+
+    profile->Add(sample);
+}
+
+void TickProfiler::RemoveMap(uint32 mapId, uint32 instanceId)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+
+    MapProfileContainer::iterator itr = _maps.find(MapKey(mapId, instanceId));
+    if (itr == _maps.end())
+        return;
+
+    delete itr->second;
+    _maps.erase(itr);
+}
+
+TickProfile TickProfiler::GetWorldProfile() const
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, TickProfile(TICK_PROFILE_WORLD, 0, 0, "World"));
+    return _world;
+}
+
+void TickProfiler::GetMapProfiles(std::vector<TickProfile>& profiles) const
+{
+    profiles.clear();
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    for (MapProfileContainer::const_iterator itr = _maps.begin(); itr != _maps.end(); ++itr)
+        profiles.push_back(*itr->second);
+}
+
+bool TickProfiler::GetMapProfile(uint32 mapId, uint32 instanceId, TickProfile& profile) const
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, false);
+
+    MapProfileContainer::const_iterator itr = _maps.find(MapKey(mapId, instanceId));
+    if (itr == _maps.end())
+        return false;
+
+    profile = *itr->second;
+    return true;
+}
+
+bool TickProfiler::WriteCSV(std::string const& fileName) const
+{
+    std::vector<TickProfile> profiles;
+    profiles.push_back(GetWorldProfile());
+
+    std::vector<TickProfile> maps;
+    GetMapProfiles(maps);
+    profiles.insert(profiles.end(), maps.begin(), maps.end());
+
+    FILE* file = fopen(fileName.c_str(), "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "profile,map,instance,phase,ticks,p50_us,p99_us,max_us,avg_us\n");
+    for (std::vector<TickProfile>::const_iterator itr = profiles.begin(); itr != profiles.end(); ++itr)
+    {
+        for (uint8 phase = 0; phase <= itr->GetPhaseCount(); ++phase)
+        {
+            bool total = phase == itr->GetPhaseCount();
+            TickPhaseStats stats = itr->GetPhaseStats(total ? MAX_TICK_PHASES : phase);
+            fprintf(file, "\"%s\",%u,%u,%s,%u,%u,%u,%u,%u\n", itr->GetName() ? itr->GetName() : "", itr->GetMapId(), itr->GetInstanceId(),
+                total ? "Tick" : GetPhaseName(itr->GetType(), phase), itr->GetSampleCount(), stats.P50, stats.P99, stats.Max, stats.Average);
+        }
+
+        if (itr->GetType() != TICK_PROFILE_MAP)
+            continue;
+
+        for (uint8 section = 0; section < MAX_MAP_TICK_SECTIONS; ++section)
+        {
+            TickPhaseStats stats = itr->GetSectionStats(section);
+            fprintf(file, "\"%s\",%u,%u,Section:%s,%u,%u,%u,%u,%u\n", itr->GetName() ? itr->GetName() : "", itr->GetMapId(), itr->GetInstanceId(),
+                GetSectionName(section), itr->GetSampleCount(), stats.P50, stats.P99, stats.Max, stats.Average);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+bool TickProfiler::WriteChromeTrace(std::string const& fileName) const
+{
+    std::vector<TickProfile> profiles;
+    profiles.push_back(GetWorldProfile());
+
+    std::vector<TickProfile> maps;
+    GetMapProfiles(maps);
+    profiles.insert(profiles.end(), maps.begin(), maps.end());
+
+    FILE* file = fopen(fileName.c_str(), "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "{\"traceEvents\":[\n");
+
+    bool first = true;
+    std::vector<TickSample> samples;
+    for (uint32 tid = 0; tid < profiles.size(); ++tid)
+    {
+        TickProfile const& profile = profiles[tid];
+
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", tid, GetProfileName(profile).c_str());
+        first = false;
+
+        // phases are laid out back to back, interleaved phases (players/cells) appear merged
+        profile.GetSamples(samples);
+        for (std::vector<TickSample>::const_iterator itr = samples.begin(); itr != samples.end(); ++itr)
+        {
+            fprintf(file, ",\n{\"name\":\"Tick\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":" UI64FMTD ",\"dur\":%u}", tid, itr->Start, itr->Duration);
+
+            uint64 start = itr->Start;
+            for (uint8 phase = 0; phase < profile.GetPhaseCount(); ++phase)
+            {
+                if (!itr->Phases[phase])
+                    continue;
+
+                fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":" UI64FMTD ",\"dur\":%u}",
+                    GetPhaseName(profile.GetType(), phase), tid, start, itr->Phases[phase]);
+                start += itr->Phases[phase];
+            }
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    return true;
+}
+
+char const* TickProfiler::GetPhaseName(TickProfileType type, uint8 phase)
+{
+    if (type == TICK_PROFILE_WORLD)
+        return phase < MAX_WORLD_TICK_PHASES ? WorldTickPhaseNames[phase] : "Tick";
+
+    return phase < MAX_MAP_TICK_PHASES ? MapTickPhaseNames[phase] : "Tick";
+}
+
+char const* TickProfiler::GetSectionName(uint8 section)
+{
+    return section < MAX_MAP_TICK_SECTIONS ? MapTickSectionNames[section] : "";
+}
+
+TickPhaseRecorder::TickPhaseRecorder() : _enabled(sTickProfiler->IsEnabled()), _type(TICK_PROFILE_WORLD),
+    _mapId(0), _instanceId(0), _name(NULL), _lastLap(0)
+{
+    memset(_sectionDepth, 0, sizeof(_sectionDepth));
+    if (_enabled)
+        _sample.Start = _lastLap = getUSTime();
+}
+
+TickPhaseRecorder::TickPhaseRecorder(uint32 mapId, uint32 instanceId, char const* name) : _enabled(sTickProfiler->IsEnabled()),
+    _type(TICK_PROFILE_MAP), _mapId(mapId), _instanceId(instanceId), _name(name), _lastLap(0)
+{
+    memset(_sectionDepth, 0, sizeof(_sectionDepth));
+    if (_enabled)
+        _sample.Start = _lastLap = getUSTime();
+}
+
+TickPhaseRecorder::~TickPhaseRecorder()
+{
+    if (!_enabled)
+        return;
+
+    _sample.Duration = uint32(GetUSTimeDiffToNow(_sample.Start));
+
+    if (_type == TICK_PROFILE_WORLD)
+        sTickProfiler->SubmitWorldTick(_sample);
+    else
+        sTickProfiler->SubmitMapTick(_mapId, _instanceId, _name, _sample);
+}
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_TICKPROFILER_H
+#define INFINITY_TICKPROFILER_H
+
+#include "Common.h"
+#include "Timer.h"
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+
+/// Phases of World::Update, in execution order
+enum WorldTickPhase
+{
+    WORLD_TICK_AUCTIONS,
+    WORLD_TICK_SESSIONS,
+    WORLD_TICK_WEATHER,
+    WORLD_TICK_LOGIN_DATABASE,
+    WORLD_TICK_MAPS,
+    WORLD_TICK_BATTLEGROUNDS,
+    WORLD_TICK_OUTDOORPVP,
+    WORLD_TICK_QUERY_CALLBACKS,
+    WORLD_TICK_GAME_EVENTS,
+    WORLD_TICK_INSTANCE_RESETS,
+    WORLD_TICK_CLI_COMMANDS,
+    WORLD_TICK_OTHER,
+    MAX_WORLD_TICK_PHASES
+};
+
+/// Phases of Map::Update, in execution order
+enum MapTickPhase
+{
+    MAP_TICK_SESSIONS,
+    MAP_TICK_PLAYERS,
+    MAP_TICK_CELLS,
+    MAP_TICK_ACTIVE_OBJECTS,
+    MAP_TICK_TRANSPORTS,
+    MAP_TICK_SCRIPTS,
+    MAP_TICK_MOVE_LISTS,
+    MAP_TICK_RELOCATION,
+    MAP_TICK_OTHER,
+    MAX_MAP_TICK_PHASES
+};
+
+/**
+    Combat code paths timed inside Map::Update. Sections overlap the phases and each other
+    (a proc inside a spell cast counts for both), recursion into the same section counts once.
+*/
+enum MapTickSection
+{
+    MAP_SECTION_SPELL_CASTS,
+    MAP_SECTION_TARGET_SEARCH,
+    MAP_SECTION_AURAS,
+    MAP_SECTION_MELEE,
+    MAP_SECTION_PROCS,
+    MAP_SECTION_THREAT,
+    MAX_MAP_TICK_SECTIONS
+};
+
+#define MAX_TICK_PHASES         16
+#define TICK_PROFILER_WINDOW    256                         // ticks kept per profile
+
+enum TickProfileType
+{
+    TICK_PROFILE_WORLD,
+    TICK_PROFILE_MAP
+};
+
+struct TickSample
+{
+    TickSample() : Start(0), Duration(0)
+    {
+        memset(Phases, 0, sizeof(Phases));
+        memset(Sections, 0, sizeof(Sections));
+    }
+
+    uint64 Start;                                           // getUSTime() at tick start
+    uint32 Duration;                                        // whole tick, microseconds
+    uint32 Phases[MAX_TICK_PHASES];                         // time spent per phase, microseconds
+    uint32 Sections[MAX_MAP_TICK_SECTIONS];                 // time spent per MapTickSection, microseconds
+};
+
+struct TickPhaseStats
+{
+    TickPhaseStats() : P50(0), P99(0), Max(0), Average(0) { }
+
+    uint32 P50;
+    uint32 P99;
+    uint32 Max;
+    uint32 Average;
+};
+
+/// Rolling window of the last TICK_PROFILER_WINDOW ticks of one world or map
+class TickProfile
+{
+    public:
+        TickProfile(TickProfileType type, uint32 mapId, uint32 instanceId, char const* name);
+
+        void Add(TickSample const& sample);
+
+        TickProfileType GetType() const { return _type; }
+        uint32 GetMapId() const { return _mapId; }
+        uint32 GetInstanceId() const { return _instanceId; }
+        char const* GetName() const { return _name; }
+        uint8 GetPhaseCount() const { return _type == TICK_PROFILE_WORLD ? MAX_WORLD_TICK_PHASES : MAX_MAP_TICK_PHASES; }
+        uint32 GetSampleCount() const { return _count; }
+        uint64 GetTotalTicks() const { return _totalTicks; }
+
+        /// phase == MAX_TICK_PHASES returns the statistics of the whole tick
+        TickPhaseStats GetPhaseStats(uint8 phase) const;
+        TickPhaseStats GetSectionStats(uint8 section) const;
+        /// Samples ordered from oldest to newest
+        void GetSamples(std::vector<TickSample>& samples) const;
+
+    private:
+        TickProfileType _type;
+        uint32 _mapId;
+        uint32 _instanceId;
+        char const* _name;
+
+        std::vector<TickSample> _samples;                   // ring buffer
+        uint32 _next;
+        uint32 _count;
+        uint64 _totalTicks;
+};
+
+/**
+    Collects per-phase tick timings of World::Update and every Map::Update.
+
+    Timings are accumulated on the stack by TickPhaseRecorder and handed over once per
+    tick, so the profiler lock is taken once per world or map tick, never per phase.
+*/
+class TickProfiler
+{
+    friend class ACE_Singleton<TickProfiler, ACE_Thread_Mutex>;
+
+    typedef std::pair<uint32, uint32> MapKey;
+    typedef std::map<MapKey, TickProfile*> MapProfileContainer;
+
+    private:
+        TickProfiler();
+        ~TickProfiler();
+
+    public:
+        bool IsEnabled() const { return _enabled; }
+        void SetEnabled(bool enabled) { _enabled = enabled; }
+        void Reset();
+
+        void SubmitWorldTick(TickSample const& sample);
+        void SubmitMapTick(uint32 mapId, uint32 instanceId, char const* name, TickSample const& sample);
+        void RemoveMap(uint32 mapId, uint32 instanceId);
+
+        /// Copies of the current profiles, safe to inspect without holding the profiler lock
+        TickProfile GetWorldProfile() const;
+        void GetMapProfiles(std::vector<TickProfile>& profiles) const;
+        bool GetMapProfile(uint32 mapId, uint32 instanceId, TickProfile& profile) const;
+
+        /// Writes one line per profile and phase with p50/p99/max/avg; returns false if the file could not be opened
+        bool WriteCSV(std::string const& fileName) const;
+        /// Writes all ticks in the window as Chrome trace events (chrome://tracing, Perfetto)
+        bool WriteChromeTrace(std::string const& fileName) const;
+
+        static char const* GetPhaseName(TickProfileType type, uint8 phase);
+        static char const* GetSectionName(uint8 section);
+
+    private:
+        volatile bool _enabled;
+
+        TickProfile _world;
+        MapProfileContainer _maps;
+        mutable ACE_Thread_Mutex _lock;
+};
+
+#define sTickProfiler ACE_Singleton<TickProfiler, ACE_Thread_Mutex>::instance()
+
+/**
+    Measures one tick split into sequential phases.
+
+    Lap(phase) charges the time since the previous lap (or since construction) to the
+    given phase; repeated laps of the same phase add up. The tick is submitted when the
+    recorder goes out of scope. Does nothing beyond one flag check if profiling is off.
+*/
+class TickPhaseRecorder
+{
+    public:
+        /// World tick
+        TickPhaseRecorder();
+        /// Map tick
+        TickPhaseRecorder(uint32 mapId, uint32 instanceId, char const* name);
+        ~TickPhaseRecorder();
+
+        void Lap(uint8 phase)
+        {
+            if (!_enabled)
+                return;
+
+            // getUSTime follows the wall clock, a step back counts as no time
+            uint64 now = getUSTime();
+            if (now > _lastLap)
+                _sample.Phases[phase] += uint32(now - _lastLap);
+
+            _lastLap = now;
+        }
+
+        bool IsEnabled() const { return _enabled; }
+
+        void EnterSection(uint8 section)
+        {
+            if (!_enabled || _sectionDepth[section]++)
+                return;
+
+            _sectionStart[section] = getUSTime();
+        }
+
+        void LeaveSection(uint8 section)
+        {
+            if (!_enabled || --_sectionDepth[section])
+                return;
+
+            _sample.Sections[section] += uint32(GetUSTimeDiffToNow(_sectionStart[section]));
+        }
+
+    private:
+        TickPhaseRecorder(TickPhaseRecorder const&);
+        TickPhaseRecorder& operator=(TickPhaseRecorder const&);
+
+        bool _enabled;
+        TickProfileType _type;
+        uint32 _mapId;
+        uint32 _instanceId;
+        char const* _name;
+        uint64 _lastLap;
+        TickSample _sample;
+        uint64 _sectionStart[MAX_MAP_TICK_SECTIONS];
+        uint32 _sectionDepth[MAX_MAP_TICK_SECTIONS];
+};
+
+/**
+    Charges its lifetime to a MapTickSection of the map tick currently updating the object.
+    Nothing is measured outside Map::Update or while profiling is off.
+*/
+class TickSectionTimer
+{
+    public:
+        template<class T>
+        TickSectionTimer(T const* object, uint8 section) : _recorder(NULL), _section(section)
+        {
+            if (object->FindMap())
+                _recorder = object->FindMap()->GetTickRecorder();
+
+            if (_recorder)
+                _recorder->EnterSection(_section);
+        }
+
+        ~TickSectionTimer()
+        {
+            if (_recorder)
+                _recorder->LeaveSection(_section);
+        }
+
+    private:
+        TickSectionTimer(TickSectionTimer const&);
+        TickSectionTimer& operator=(TickSectionTimer const&);
+
+        TickPhaseRecorder* _recorder;
+        uint8 _section;
+};
+
+#endif
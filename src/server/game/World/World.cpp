@@ -27,6 +27,8 @@
 #include "SystemConfig.h"
 #include "Log.h"
 #include "Opcodes.h"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
 #include "WorldSession.h"
 #include "WorldPacket.h"
 #include "Player.h"
@@ -87,6 +89,21 @@ int32 World::m_visibility_notify_periodOnContinents = DEFAULT_VISIBILITY_NOTIFY_
 int32 World::m_visibility_notify_periodInInstances  = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
 int32 World::m_visibility_notify_periodInBGArenas   = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
 
+WorldConfigSnapshot::WorldConfigSnapshot() : Version(0),
+    MaxVisibleDistanceOnContinents(DEFAULT_VISIBILITY_DISTANCE), MaxVisibleDistanceInInstances(DEFAULT_VISIBILITY_INSTANCE),
+    MaxVisibleDistanceInBGArenas(DEFAULT_VISIBILITY_BGARENAS), VisibilityNotifyPeriodOnContinents(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
+    VisibilityNotifyPeriodInInstances(DEFAULT_VISIBILITY_NOTIFY_PERIOD), VisibilityNotifyPeriodInBGArenas(DEFAULT_VISIBILITY_NOTIFY_PERIOD)
+{
+    memset(Rates, 0, sizeof(Rates));
+    memset(IntConfigs, 0, sizeof(IntConfigs));
+    memset(BoolConfigs, 0, sizeof(BoolConfigs));
+    memset(FloatConfigs, 0, sizeof(FloatConfigs));
+}
+
+// used until the World constructor publishes the first snapshot
+static WorldConfigSnapshot const DefaultWorldConfig;
+World::ConfigPtr World::m_config(&DefaultWorldConfig);
+
 /// World constructor
 World::World()
 {
@@ -125,6 +142,8 @@ World::World()
     memset(m_int_configs, 0, sizeof(m_int_configs));
     memset(m_bool_configs, 0, sizeof(m_bool_configs));
     memset(m_float_configs, 0, sizeof(m_float_configs));
+
+    PublishConfig();
 }
 
 /// World destructor
@@ -145,9 +164,49 @@ World::~World()
     VMAP::VMapFactory::clear();
     MMAP::MMapFactory::clear();
 
+    for (RetiredConfigQueue::const_iterator itr = m_retiredConfigs.begin(); itr != m_retiredConfigs.end(); ++itr)
+        delete itr->second;
+
+    WorldConfigSnapshot const* config = LoadConfig();
+    StoreConfig(&DefaultWorldConfig);
+    delete config;
+
     /// @todo free addSessQueue
 }
 
+void World::PublishConfig()
+{
+    WorldConfigSnapshot* config = new WorldConfigSnapshot();
+    config->Version = LoadConfig()->Version + 1;
+    memcpy(config->Rates, rate_values, sizeof(config->Rates));
+    memcpy(config->IntConfigs, m_int_configs, sizeof(config->IntConfigs));
+    memcpy(config->BoolConfigs, m_bool_configs, sizeof(config->BoolConfigs));
+    memcpy(config->FloatConfigs, m_float_configs, sizeof(config->FloatConfigs));
+
+    config->MaxVisibleDistanceOnContinents = m_MaxVisibleDistanceOnContinents;
+    config->MaxVisibleDistanceInInstances = m_MaxVisibleDistanceInInstances;
+    config->MaxVisibleDistanceInBGArenas = m_MaxVisibleDistanceInBGArenas;
+    config->VisibilityNotifyPeriodOnContinents = m_visibility_notify_periodOnContinents;
+    config->VisibilityNotifyPeriodInInstances = m_visibility_notify_periodInInstances;
+    config->VisibilityNotifyPeriodInBGArenas = m_visibility_notify_periodInBGArenas;
+
+    WorldConfigSnapshot const* previous = LoadConfig();
+    StoreConfig(config);
+
+    // readers may still hold the previous snapshot
+    if (previous != &DefaultWorldConfig)
+        m_retiredConfigs.push_back(std::make_pair(getMSTime(), previous));
+}
+
+void World::ReleaseRetiredConfigs()
+{
+    while (!m_retiredConfigs.empty() && GetMSTimeDiffToNow(m_retiredConfigs.front().first) > CONFIG_SNAPSHOT_RETIRE_DELAY)
+    {
+        delete m_retiredConfigs.front().second;
+        m_retiredConfigs.pop_front();
+    }
+}
+
 /// Find a player in a specified zone
 Player* World::FindPlayerInZone(uint32 zone)
 {
@@ -958,6 +1017,30 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_CREATURE_FAMILY_ASSISTANCE_DELAY]  = sConfigMgr->GetIntDefault("CreatureFamilyAssistanceDelay", 1500);
     m_int_configs[CONFIG_CREATURE_FAMILY_FLEE_DELAY]        = sConfigMgr->GetIntDefault("CreatureFamilyFleeDelay", 7000);
 
+    m_bool_configs[CONFIG_CREATURE_UPDATE_THROTTLE_ENABLE] = sConfigMgr->GetBoolDefault("Creature.UpdateThrottle.Enable", false);
+    m_float_configs[CONFIG_CREATURE_UPDATE_THROTTLE_NEAR_DISTANCE] = sConfigMgr->GetFloatDefault("Creature.UpdateThrottle.NearDistance", 60.0f);
+    m_float_configs[CONFIG_CREATURE_UPDATE_THROTTLE_FAR_DISTANCE] = sConfigMgr->GetFloatDefault("Creature.UpdateThrottle.FarDistance", 120.0f);
+    if (m_float_configs[CONFIG_CREATURE_UPDATE_THROTTLE_FAR_DISTANCE] < m_float_configs[CONFIG_CREATURE_UPDATE_THROTTLE_NEAR_DISTANCE])
+    {
+        IC_LOG_ERROR("server.loading", "Creature.UpdateThrottle.FarDistance (%f) can't be less than Creature.UpdateThrottle.NearDistance (%f). Set to %f.",
+            m_float_configs[CONFIG_CREATURE_UPDATE_THROTTLE_FAR_DISTANCE], m_float_configs[CONFIG_CREATURE_UPDATE_THROTTLE_NEAR_DISTANCE],
+            m_float_configs[CONFIG_CREATURE_UPDATE_THROTTLE_NEAR_DISTANCE]);
+        m_float_configs[CONFIG_CREATURE_UPDATE_THROTTLE_FAR_DISTANCE] = m_float_configs[CONFIG_CREATURE_UPDATE_THROTTLE_NEAR_DISTANCE];
+    }
+    m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_MID_INTERVAL] = sConfigMgr->GetIntDefault("Creature.UpdateThrottle.MidInterval", 2);
+    if (m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_MID_INTERVAL] < 1 || m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_MID_INTERVAL] > 16)
+    {
+        IC_LOG_ERROR("server.loading", "Creature.UpdateThrottle.MidInterval (%u) must be in range 1..16. Using default value (2).", m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_MID_INTERVAL]);
+        m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_MID_INTERVAL] = 2;
+    }
+    m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_FAR_INTERVAL] = sConfigMgr->GetIntDefault("Creature.UpdateThrottle.FarInterval", 4);
+    if (m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_FAR_INTERVAL] < 1 || m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_FAR_INTERVAL] > 16)
+    {
+        IC_LOG_ERROR("server.loading", "Creature.UpdateThrottle.FarInterval (%u) must be in range 1..16. Using default value (4).", m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_FAR_INTERVAL]);
+        m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_FAR_INTERVAL] = 4;
+    }
+    m_int_configs[CONFIG_CREATURE_UPDATE_THROTTLE_CHECK_DELAY] = sConfigMgr->GetIntDefault("Creature.UpdateThrottle.CheckDelay", 1000);
+
     m_int_configs[CONFIG_WORLD_BOSS_LEVEL_DIFF] = sConfigMgr->GetIntDefault("WorldBossLevelDiff", 3);
 
     // note: disable value (-1) will assigned as 0xFFFFFFF, to prevent overflow at calculations limit it to max possible player level MAX_LEVEL(100)
@@ -1060,10 +1143,10 @@ void World::LoadConfigSettings(bool reload)
 
     //visibility on continents
     m_MaxVisibleDistanceOnContinents = sConfigMgr->GetFloatDefault("Visibility.Distance.Continents", DEFAULT_VISIBILITY_DISTANCE);
-    if (m_MaxVisibleDistanceOnContinents < 45*sWorld->getRate(RATE_CREATURE_AGGRO))
+    if (m_MaxVisibleDistanceOnContinents < 45*rate_values[RATE_CREATURE_AGGRO])
     {
-        IC_LOG_ERROR("server.loading", "Visibility.Distance.Continents can't be less max aggro radius %f", 45*sWorld->getRate(RATE_CREATURE_AGGRO));
-        m_MaxVisibleDistanceOnContinents = 45*sWorld->getRate(RATE_CREATURE_AGGRO);
+        IC_LOG_ERROR("server.loading", "Visibility.Distance.Continents can't be less max aggro radius %f", 45*rate_values[RATE_CREATURE_AGGRO]);
+        m_MaxVisibleDistanceOnContinents = 45*rate_values[RATE_CREATURE_AGGRO];
     }
     else if (m_MaxVisibleDistanceOnContinents > MAX_VISIBILITY_DISTANCE)
     {
@@ -1073,10 +1156,10 @@ void World::LoadConfigSettings(bool reload)
 
     //visibility in instances
     m_MaxVisibleDistanceInInstances = sConfigMgr->GetFloatDefault("Visibility.Distance.Instances", DEFAULT_VISIBILITY_INSTANCE);
-    if (m_MaxVisibleDistanceInInstances < 45*sWorld->getRate(RATE_CREATURE_AGGRO))
+    if (m_MaxVisibleDistanceInInstances < 45*rate_values[RATE_CREATURE_AGGRO])
     {
-        IC_LOG_ERROR("server.loading", "Visibility.Distance.Instances can't be less max aggro radius %f", 45*sWorld->getRate(RATE_CREATURE_AGGRO));
-        m_MaxVisibleDistanceInInstances = 45*sWorld->getRate(RATE_CREATURE_AGGRO);
+        IC_LOG_ERROR("server.loading", "Visibility.Distance.Instances can't be less max aggro radius %f", 45*rate_values[RATE_CREATURE_AGGRO]);
+        m_MaxVisibleDistanceInInstances = 45*rate_values[RATE_CREATURE_AGGRO];
     }
     else if (m_MaxVisibleDistanceInInstances > MAX_VISIBILITY_DISTANCE)
     {
@@ -1086,10 +1169,10 @@ void World::LoadConfigSettings(bool reload)
 
     //visibility in BG/Arenas
     m_MaxVisibleDistanceInBGArenas = sConfigMgr->GetFloatDefault("Visibility.Distance.BGArenas", DEFAULT_VISIBILITY_BGARENAS);
-    if (m_MaxVisibleDistanceInBGArenas < 45*sWorld->getRate(RATE_CREATURE_AGGRO))
+    if (m_MaxVisibleDistanceInBGArenas < 45*rate_values[RATE_CREATURE_AGGRO])
     {
-        IC_LOG_ERROR("server.loading", "Visibility.Distance.BGArenas can't be less max aggro radius %f", 45*sWorld->getRate(RATE_CREATURE_AGGRO));
-        m_MaxVisibleDistanceInBGArenas = 45*sWorld->getRate(RATE_CREATURE_AGGRO);
+        IC_LOG_ERROR("server.loading", "Visibility.Distance.BGArenas can't be less max aggro radius %f", 45*rate_values[RATE_CREATURE_AGGRO]);
+        m_MaxVisibleDistanceInBGArenas = 45*rate_values[RATE_CREATURE_AGGRO];
     }
     else if (m_MaxVisibleDistanceInBGArenas > MAX_VISIBILITY_DISTANCE)
     {
@@ -1243,6 +1326,47 @@ void World::LoadConfigSettings(bool reload)
 
     m_int_configs[CONFIG_PACKET_SPOOF_BANDURATION] = sConfigMgr->GetIntDefault("PacketSpoof.BanDuration", 86400);
 
+    // Opcode handler statistics
+    bool opcodeStats = sConfigMgr->GetBoolDefault("Debug.OpcodeStats.Enable", false);
+    // a reload keeps .debug opcodestats on|off unless the setting itself was changed
+    if (!reload || opcodeStats != m_bool_configs[CONFIG_OPCODE_STATS_ENABLE])
+        sOpcodeStats->SetEnabled(opcodeStats);
+    m_bool_configs[CONFIG_OPCODE_STATS_ENABLE] = opcodeStats;
+    m_int_configs[CONFIG_OPCODE_STATS_LOG_INTERVAL] = sConfigMgr->GetIntDefault("Debug.OpcodeStats.LogInterval", 0);
+    m_int_configs[CONFIG_OPCODE_STATS_LOG_COUNT] = sConfigMgr->GetIntDefault("Debug.OpcodeStats.LogCount", 20);
+    if (reload)
+    {
+        m_timers[WUPDATE_OPCODESTATS].SetInterval(m_int_configs[CONFIG_OPCODE_STATS_LOG_INTERVAL] * IN_MILLISECONDS);
+        m_timers[WUPDATE_OPCODESTATS].Reset();
+    }
+
+    // World and map tick profiling
+    bool tickProfiler = sConfigMgr->GetBoolDefault("Debug.TickProfiler.Enable", false);
+    if (!reload || tickProfiler != m_bool_configs[CONFIG_TICK_PROFILER_ENABLE])
+        sTickProfiler->SetEnabled(tickProfiler);
+    m_bool_configs[CONFIG_TICK_PROFILER_ENABLE] = tickProfiler;
+
+    // Database pool statistics
+    bool databaseStats = sConfigMgr->GetBoolDefault("Debug.DatabaseStats.Enable", false);
+    // a reload keeps .debug dbstats on|off unless the setting itself was changed
+    if (!reload || databaseStats != m_bool_configs[CONFIG_DATABASE_STATS_ENABLE])
+    {
+        CharacterDatabase.GetStats().SetEnabled(databaseStats);
+        LoginDatabase.GetStats().SetEnabled(databaseStats);
+        WorldDatabase.GetStats().SetEnabled(databaseStats);
+    }
+    m_bool_configs[CONFIG_DATABASE_STATS_ENABLE] = databaseStats;
+    m_int_configs[CONFIG_DATABASE_STATS_LOG_INTERVAL] = sConfigMgr->GetIntDefault("Debug.DatabaseStats.LogInterval", 0);
+    m_int_configs[CONFIG_DATABASE_STATS_LOG_COUNT] = sConfigMgr->GetIntDefault("Debug.DatabaseStats.LogCount", 10);
+    if (reload)
+    {
+        m_timers[WUPDATE_DATABASESTATS].SetInterval(m_int_configs[CONFIG_DATABASE_STATS_LOG_INTERVAL] * IN_MILLISECONDS);
+        m_timers[WUPDATE_DATABASESTATS].Reset();
+    }
+
+    // all settings at once, readers never see a half reloaded configuration
+    PublishConfig();
+
     // call ScriptMgr if we're reloading the configuration
     if (reload)
         sScriptMgr->OnConfigLoad(reload);
@@ -1369,6 +1493,9 @@ void World::SetInitialWorldSettings()
     IC_LOG_INFO("server.loading", "Loading Spell Rank Data...");
     sSpellMgr->LoadSpellRanks();
 
+    IC_LOG_INFO("server.loading", "Loading SpellInfo precomputed data...");
+    sSpellMgr->LoadSpellInfoPrecomputedData();                   // must be after LoadSpellRanks
+
     IC_LOG_INFO("server.loading", "Loading Spell Required Data...");
     sSpellMgr->LoadSpellRequired();
 
@@ -1691,6 +1818,8 @@ void World::SetInitialWorldSettings()
     m_timers[WUPDATE_DELETECHARS].SetInterval(DAY*IN_MILLISECONDS); // check for chars to delete every day
 
     m_timers[WUPDATE_PINGDB].SetInterval(getIntConfig(CONFIG_DB_PING_INTERVAL)*MINUTE*IN_MILLISECONDS);    // Mysql ping time in minutes
+    m_timers[WUPDATE_OPCODESTATS].SetInterval(getIntConfig(CONFIG_OPCODE_STATS_LOG_INTERVAL)*IN_MILLISECONDS); // Opcode statistics dump in seconds
+    m_timers[WUPDATE_DATABASESTATS].SetInterval(getIntConfig(CONFIG_DATABASE_STATS_LOG_INTERVAL)*IN_MILLISECONDS); // Database statistics dump in seconds
 
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
@@ -1875,8 +2004,12 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    TickPhaseRecorder tickRecorder;
+
     m_updateTime = diff;
 
+    ReleaseRetiredConfigs();
+
     if (m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] && diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
     {
         if (m_updateTimeSum > m_int_configs[CONFIG_INTERVAL_LOG_UPDATE])
@@ -1925,6 +2058,8 @@ void World::Update(uint32 diff)
     if (m_gameTime > m_NextGuildReset)
         ResetGuildCap();
 
+    tickRecorder.Lap(WORLD_TICK_OTHER);
+
     /// <ul><li> Handle auctions when the timer has passed
     if (m_timers[WUPDATE_AUCTIONS].Passed())
     {
@@ -1942,10 +2077,13 @@ void World::Update(uint32 diff)
         sAuctionMgr->Update();
     }
 
+    tickRecorder.Lap(WORLD_TICK_AUCTIONS);
+
     /// <li> Handle session updates when the timer has passed
     RecordTimeDiff(NULL);
     UpdateSessions(diff);
     RecordTimeDiff("UpdateSessions");
+    tickRecorder.Lap(WORLD_TICK_SESSIONS);
 
     /// <li> Handle weather updates when the timer has passed
     if (m_timers[WUPDATE_WEATHERS].Passed())
@@ -1954,6 +2092,8 @@ void World::Update(uint32 diff)
         WeatherMgr::Update(uint32(m_timers[WUPDATE_WEATHERS].GetInterval()));
     }
 
+    tickRecorder.Lap(WORLD_TICK_WEATHER);
+
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
     {
@@ -1988,11 +2128,14 @@ void World::Update(uint32 diff)
         }
     }
 
+    tickRecorder.Lap(WORLD_TICK_LOGIN_DATABASE);
+
     /// <li> Handle all other objects
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
     RecordTimeDiff(NULL);
     sMapMgr->Update(diff);
     RecordTimeDiff("UpdateMapMgr");
+    tickRecorder.Lap(WORLD_TICK_MAPS);
 
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
@@ -2003,11 +2146,15 @@ void World::Update(uint32 diff)
         }
     }
 
+    tickRecorder.Lap(WORLD_TICK_OTHER);
+
     sBattlegroundMgr->Update(diff);
     RecordTimeDiff("UpdateBattlegroundMgr");
+    tickRecorder.Lap(WORLD_TICK_BATTLEGROUNDS);
 
     sOutdoorPvPMgr->Update(diff);
     RecordTimeDiff("UpdateOutdoorPvPMgr");
+    tickRecorder.Lap(WORLD_TICK_OUTDOORPVP);
 
     ///- Delete all characters which have been deleted X days before
     if (m_timers[WUPDATE_DELETECHARS].Passed())
@@ -2016,9 +2163,12 @@ void World::Update(uint32 diff)
         Player::DeleteOldCharacters();
     }
 
+    tickRecorder.Lap(WORLD_TICK_OTHER);
+
     // execute callbacks from sql queries that were queued recently
     ProcessQueryCallbacks();
     RecordTimeDiff("ProcessQueryCallbacks");
+    tickRecorder.Lap(WORLD_TICK_QUERY_CALLBACKS);
 
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
@@ -2027,6 +2177,8 @@ void World::Update(uint32 diff)
         sObjectAccessor->RemoveOldCorpses();
     }
 
+    tickRecorder.Lap(WORLD_TICK_OTHER);
+
     ///- Process Game events when necessary
     if (m_timers[WUPDATE_EVENTS].Passed())
     {
@@ -2036,6 +2188,8 @@ void World::Update(uint32 diff)
         m_timers[WUPDATE_EVENTS].Reset();
     }
 
+    tickRecorder.Lap(WORLD_TICK_GAME_EVENTS);
+
     ///- Ping to keep MySQL connections alive
     if (m_timers[WUPDATE_PINGDB].Passed())
     {
@@ -2046,13 +2200,44 @@ void World::Update(uint32 diff)
         WorldDatabase.KeepAlive();
     }
 
+    ///- Send character writes batched for longer than CharacterDatabase.WriteBatch.Delay
+    CharacterDatabase.UpdateWriteBatch();
+
+    ///- Dump opcode handler statistics to the log
+    if (getIntConfig(CONFIG_OPCODE_STATS_LOG_INTERVAL) && sOpcodeStats->IsEnabled())
+    {
+        if (m_timers[WUPDATE_OPCODESTATS].Passed())
+        {
+            m_timers[WUPDATE_OPCODESTATS].Reset();
+            sOpcodeStats->LogSnapshot(getIntConfig(CONFIG_OPCODE_STATS_LOG_COUNT), OPCODE_STATS_SORT_TOTAL_TIME);
+        }
+    }
+
+    ///- Dump database pool statistics to the log
+    if (getIntConfig(CONFIG_DATABASE_STATS_LOG_INTERVAL) && m_timers[WUPDATE_DATABASESTATS].Passed())
+    {
+        m_timers[WUPDATE_DATABASESTATS].Reset();
+        uint32 count = getIntConfig(CONFIG_DATABASE_STATS_LOG_COUNT);
+        if (CharacterDatabase.GetStats().IsEnabled())
+            CharacterDatabase.LogStats(count);
+        if (LoginDatabase.GetStats().IsEnabled())
+            LoginDatabase.LogStats(count);
+        if (WorldDatabase.GetStats().IsEnabled())
+            WorldDatabase.LogStats(count);
+    }
+
+    tickRecorder.Lap(WORLD_TICK_OTHER);
+
     // update the instance reset times
     sInstanceSaveMgr->Update();
+    tickRecorder.Lap(WORLD_TICK_INSTANCE_RESETS);
 
     // And last, but not least handle the issued cli commands
     ProcessCliCommands();
+    tickRecorder.Lap(WORLD_TICK_CLI_COMMANDS);
 
     sScriptMgr->OnWorldUpdate(diff);
+    tickRecorder.Lap(WORLD_TICK_OTHER);
 }
 
 void World::ForceGameEventUpdate()
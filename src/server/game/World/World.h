@@ -34,6 +34,14 @@
 #include <map>
 #include <set>
 #include <list>
+#include <deque>
+
+#if COMPILER_HAS_CPP11_SUPPORT
+#  include <atomic>
+#elif COMPILER == COMPILER_MICROSOFT
+#  include <intrin.h>
+#  pragma intrinsic(_ReadWriteBarrier)
+#endif
 
 class Object;
 class WorldPacket;
@@ -78,6 +86,8 @@ enum WorldTimers
     WUPDATE_MAILBOXQUEUE,
     WUPDATE_DELETECHARS,
     WUPDATE_PINGDB,
+    WUPDATE_OPCODESTATS,
+    WUPDATE_DATABASESTATS,
     WUPDATE_COUNT
 };
 
@@ -161,6 +171,10 @@ enum WorldBoolConfigs
     CONFIG_EVENT_ANNOUNCE,
     CONFIG_STATS_LIMITS_ENABLE,
     CONFIG_INSTANCES_RESET_ANNOUNCE,
+    CONFIG_OPCODE_STATS_ENABLE,
+    CONFIG_TICK_PROFILER_ENABLE,
+    CONFIG_DATABASE_STATS_ENABLE,
+    CONFIG_CREATURE_UPDATE_THROTTLE_ENABLE,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -181,6 +195,8 @@ enum WorldFloatConfigs
     CONFIG_STATS_LIMITS_PARRY,
     CONFIG_STATS_LIMITS_BLOCK,
     CONFIG_STATS_LIMITS_CRIT,
+    CONFIG_CREATURE_UPDATE_THROTTLE_NEAR_DISTANCE,
+    CONFIG_CREATURE_UPDATE_THROTTLE_FAR_DISTANCE,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -336,6 +352,13 @@ enum WorldIntConfigs
     CONFIG_BG_REWARD_WINNER_ARENA_LAST,
     CONFIG_BG_REWARD_LOSER_HONOR_FIRST,
     CONFIG_BG_REWARD_LOSER_HONOR_LAST,
+    CONFIG_OPCODE_STATS_LOG_INTERVAL,
+    CONFIG_OPCODE_STATS_LOG_COUNT,
+    CONFIG_DATABASE_STATS_LOG_INTERVAL,
+    CONFIG_DATABASE_STATS_LOG_COUNT,
+    CONFIG_CREATURE_UPDATE_THROTTLE_MID_INTERVAL,
+    CONFIG_CREATURE_UPDATE_THROTTLE_FAR_INTERVAL,
+    CONFIG_CREATURE_UPDATE_THROTTLE_CHECK_DELAY,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -508,6 +531,35 @@ struct CliCommandHolder
 
 typedef UNORDERED_MAP<uint32, WorldSession*> SessionMap;
 
+#define CONFIG_SNAPSHOT_RETIRE_DELAY    (60 * IN_MILLISECONDS)  // replaced snapshots are kept this long for late readers
+
+/**
+    Immutable copy of the world configuration.
+
+    LoadConfigSettings fills the staging arrays of World and publishes them as a new snapshot
+    with a single pointer store, so readers on map and network threads see either all old or
+    all new values without taking a lock. Values derived from several settings are computed
+    once when the snapshot is built.
+*/
+struct WorldConfigSnapshot
+{
+    WorldConfigSnapshot();
+
+    uint32 Version;                                         // increased by every publication
+    float Rates[MAX_RATES];
+    uint32 IntConfigs[INT_CONFIG_VALUE_COUNT];
+    bool BoolConfigs[BOOL_CONFIG_VALUE_COUNT];
+    float FloatConfigs[FLOAT_CONFIG_VALUE_COUNT];
+
+    float MaxVisibleDistanceOnContinents;                   // clamped to the aggro radius and MAX_VISIBILITY_DISTANCE
+    float MaxVisibleDistanceInInstances;
+    float MaxVisibleDistanceInBGArenas;
+
+    int32 VisibilityNotifyPeriodOnContinents;
+    int32 VisibilityNotifyPeriodInInstances;
+    int32 VisibilityNotifyPeriodInBGArenas;
+};
+
 struct CharacterNameData
 {
     std::string m_name;
@@ -603,7 +655,7 @@ class World
         uint32 GetUptime() const { return uint32(m_gameTime - m_startTime); }
         /// Update time
         uint32 GetUpdateTime() const { return m_updateTime; }
-        void SetRecordDiffInterval(int32 t) { if (t >= 0) m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = (uint32)t; }
+        void SetRecordDiffInterval(int32 t) { if (t >= 0) setIntConfig(CONFIG_INTERVAL_LOG_UPDATE, uint32(t)); }
 
         /// Next daily quests and random bg reset time
         time_t GetNextDailyQuestsResetTime() const { return m_NextDailyQuestReset; }
@@ -642,50 +694,69 @@ class World
         void Update(uint32 diff);
 
         void UpdateSessions(uint32 diff);
-        /// Set a server rate (see #Rates)
-        void setRate(Rates rate, float value) { rate_values[rate]=value; }
+        /// Set a server rate (see #Rates), publishes a new configuration snapshot
+        void setRate(Rates rate, float value)
+        {
+            rate_values[rate] = value;
+            PublishConfig();
+        }
+
         /// Get a server rate (see #Rates)
-        float getRate(Rates rate) const { return rate_values[rate]; }
+        float getRate(Rates rate) const { return LoadConfig()->Rates[rate]; }
 
-        /// Set a server configuration element (see #WorldConfigs)
+        /// Set a server configuration element (see #WorldConfigs), publishes a new configuration snapshot
         void setBoolConfig(WorldBoolConfigs index, bool value)
         {
             if (index < BOOL_CONFIG_VALUE_COUNT)
+            {
                 m_bool_configs[index] = value;
+                PublishConfig();
+            }
         }
 
         /// Get a server configuration element (see #WorldConfigs)
         bool getBoolConfig(WorldBoolConfigs index) const
         {
-            return index < BOOL_CONFIG_VALUE_COUNT ? m_bool_configs[index] : 0;
+            return index < BOOL_CONFIG_VALUE_COUNT ? LoadConfig()->BoolConfigs[index] : 0;
         }
 
-        /// Set a server configuration element (see #WorldConfigs)
+        /// Set a server configuration element (see #WorldConfigs), publishes a new configuration snapshot
         void setFloatConfig(WorldFloatConfigs index, float value)
         {
             if (index < FLOAT_CONFIG_VALUE_COUNT)
+            {
                 m_float_configs[index] = value;
+                PublishConfig();
+            }
         }
 
         /// Get a server configuration element (see #WorldConfigs)
         float getFloatConfig(WorldFloatConfigs index) const
         {
-            return index < FLOAT_CONFIG_VALUE_COUNT ? m_float_configs[index] : 0;
+            return index < FLOAT_CONFIG_VALUE_COUNT ? LoadConfig()->FloatConfigs[index] : 0;
         }
 
-        /// Set a server configuration element (see #WorldConfigs)
+        /// Set a server configuration element (see #WorldConfigs), publishes a new configuration snapshot
         void setIntConfig(WorldIntConfigs index, uint32 value)
         {
             if (index < INT_CONFIG_VALUE_COUNT)
+            {
                 m_int_configs[index] = value;
+                PublishConfig();
+            }
         }
 
         /// Get a server configuration element (see #WorldConfigs)
         uint32 getIntConfig(WorldIntConfigs index) const
         {
-            return index < INT_CONFIG_VALUE_COUNT ? m_int_configs[index] : 0;
+            return index < INT_CONFIG_VALUE_COUNT ? LoadConfig()->IntConfigs[index] : 0;
         }
 
+        /// Current configuration snapshot, stays valid for at least CONFIG_SNAPSHOT_RETIRE_DELAY after a reload
+        static WorldConfigSnapshot const* GetConfig() { return LoadConfig(); }
+        /// Changes whenever the configuration is reloaded or changed, caches of config derived values compare it
+        uint32 GetConfigVersion() const { return LoadConfig()->Version; }
+
         void setWorldState(uint32 index, uint64 value);
         uint64 getWorldState(uint32 index) const;
         void LoadWorldStates();
@@ -703,13 +774,13 @@ class World
         bool RemoveBanCharacter(std::string const& name);
 
         // for max speed access
-        static float GetMaxVisibleDistanceOnContinents()    { return m_MaxVisibleDistanceOnContinents; }
-        static float GetMaxVisibleDistanceInInstances()     { return m_MaxVisibleDistanceInInstances;  }
-        static float GetMaxVisibleDistanceInBGArenas()      { return m_MaxVisibleDistanceInBGArenas;   }
+        static float GetMaxVisibleDistanceOnContinents()    { return LoadConfig()->MaxVisibleDistanceOnContinents; }
+        static float GetMaxVisibleDistanceInInstances()     { return LoadConfig()->MaxVisibleDistanceInInstances;  }
+        static float GetMaxVisibleDistanceInBGArenas()      { return LoadConfig()->MaxVisibleDistanceInBGArenas;   }
 
-        static int32 GetVisibilityNotifyPeriodOnContinents(){ return m_visibility_notify_periodOnContinents; }
-        static int32 GetVisibilityNotifyPeriodInInstances() { return m_visibility_notify_periodInInstances;  }
-        static int32 GetVisibilityNotifyPeriodInBGArenas()  { return m_visibility_notify_periodInBGArenas;   }
+        static int32 GetVisibilityNotifyPeriodOnContinents(){ return LoadConfig()->VisibilityNotifyPeriodOnContinents; }
+        static int32 GetVisibilityNotifyPeriodInInstances() { return LoadConfig()->VisibilityNotifyPeriodInInstances;  }
+        static int32 GetVisibilityNotifyPeriodInBGArenas()  { return LoadConfig()->VisibilityNotifyPeriodInBGArenas;   }
 
         void ProcessCliCommands();
         void QueueCliCommand(CliCommandHolder* commandHolder) { cliCmdQueue.add(commandHolder); }
@@ -787,10 +858,31 @@ class World
 
         std::string m_newCharString;
 
+        // staging values written by LoadConfigSettings and the setters, readers use m_config
         float rate_values[MAX_RATES];
         uint32 m_int_configs[INT_CONFIG_VALUE_COUNT];
         bool m_bool_configs[BOOL_CONFIG_VALUE_COUNT];
         float m_float_configs[FLOAT_CONFIG_VALUE_COUNT];
+
+        /// Builds a snapshot of the staging values and makes it the current one
+        void PublishConfig();
+        /// Frees snapshots replaced more than CONFIG_SNAPSHOT_RETIRE_DELAY ago
+        void ReleaseRetiredConfigs();
+
+        // written by the world thread only, read by any thread
+#if COMPILER_HAS_CPP11_SUPPORT
+        typedef std::atomic<WorldConfigSnapshot const*> ConfigPtr;
+#else
+        typedef WorldConfigSnapshot const* volatile ConfigPtr;
+#endif
+        static ConfigPtr m_config;
+
+        /// Load of the current snapshot with acquire semantics, pairs with StoreConfig
+        static WorldConfigSnapshot const* LoadConfig();
+        /// Store of a fully built snapshot with release semantics
+        static void StoreConfig(WorldConfigSnapshot const* config);
+        typedef std::deque<std::pair<uint32, WorldConfigSnapshot const*> > RetiredConfigQueue;
+        RetiredConfigQueue m_retiredConfigs;                    // getMSTime() of the replacement, snapshot
         typedef std::map<uint32, uint64> WorldStatesMap;
         WorldStatesMap m_worldstates;
         uint32 m_playerLimit;
@@ -844,6 +936,56 @@ class World
         ACE_Future_Set<PreparedQueryResult> m_realmCharCallbacks;
 };
 
+#if COMPILER_HAS_CPP11_SUPPORT
+inline WorldConfigSnapshot const* World::LoadConfig()
+{
+    return m_config.load(std::memory_order_acquire);
+}
+
+inline void World::StoreConfig(WorldConfigSnapshot const* config)
+{
+    m_config.store(config, std::memory_order_release);
+}
+#elif COMPILER == COMPILER_MICROSOFT
+// volatile accesses have acquire/release semantics with MSVC
+inline WorldConfigSnapshot const* World::LoadConfig()
+{
+    WorldConfigSnapshot const* config = m_config;
+    _ReadWriteBarrier();
+    return config;
+}
+
+inline void World::StoreConfig(WorldConfigSnapshot const* config)
+{
+    _ReadWriteBarrier();
+    m_config = config;
+}
+#elif COMPILER == COMPILER_GNU && GCC_VERSION >= 40700
+// the builtins of std::atomic, for builds without -std=c++11 (GCC and clang)
+inline WorldConfigSnapshot const* World::LoadConfig()
+{
+    return __atomic_load_n(&m_config, __ATOMIC_ACQUIRE);
+}
+
+inline void World::StoreConfig(WorldConfigSnapshot const* config)
+{
+    __atomic_store_n(&m_config, config, __ATOMIC_RELEASE);
+}
+#else
+inline WorldConfigSnapshot const* World::LoadConfig()
+{
+    WorldConfigSnapshot const* config = m_config;
+    __sync_synchronize();
+    return config;
+}
+
+inline void World::StoreConfig(WorldConfigSnapshot const* config)
+{
+    __sync_synchronize();
+    m_config = config;
+}
+#endif
+
 extern uint32 realmID;
 
 #define sWorld ACE_Singleton<World, ACE_Null_Mutex>::instance()
@@ -32,6 +32,9 @@ EndScriptData */
 #include "GridNotifiersImpl.h"
 #include "GossipDef.h"
 #include "Language.h"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
+#include "Config.h"
 
 #include <fstream>
 
@@ -87,6 +90,9 @@ public:
             { "areatriggers",  rbac::RBAC_PERM_COMMAND_DEBUG_AREATRIGGERS,  false, &HandleDebugAreaTriggersCommand,     "", NULL },
             { "los",           rbac::RBAC_PERM_COMMAND_DEBUG_LOS,           false, &HandleDebugLoSCommand,              "", NULL },
             { "moveflags",     rbac::RBAC_PERM_COMMAND_DEBUG_MOVEFLAGS,     false, &HandleDebugMoveflagsCommand,        "", NULL },
+            { "opcodestats",   rbac::RBAC_PERM_COMMAND_DEBUG_OPCODESTATS,   true,  &HandleDebugOpcodeStatsCommand,      "", NULL },
+            { "tickprofile",   rbac::RBAC_PERM_COMMAND_DEBUG_TICKPROFILE,   true,  &HandleDebugTickProfileCommand,      "", NULL },
+            { "dbstats",       rbac::RBAC_PERM_COMMAND_DEBUG_DBSTATS,       true,  &HandleDebugDatabaseStatsCommand,    "", NULL },
             { NULL,            0,                                     false, NULL,                                "", NULL }
         };
         static ChatCommand commandTable[] =
@@ -1240,6 +1246,238 @@ public:
         return true;
     }
 
+    static bool HandleDebugOpcodeStatsCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug opcodestats [on|off|reset|time|calls|p99|bytes] [#count]
+        char* modeStr = strtok((char*)args, " ");
+        char* countStr = strtok(NULL, " ");
+
+        OpcodeStatsSortOrder order = OPCODE_STATS_SORT_TOTAL_TIME;
+        if (modeStr)
+        {
+            std::string mode = modeStr;
+            if (mode == "on" || mode == "off")
+            {
+                sOpcodeStats->SetEnabled(mode == "on");
+                handler->PSendSysMessage("Opcode statistics collection %s.", mode == "on" ? "enabled" : "disabled");
+                return true;
+            }
+
+            if (mode == "reset")
+            {
+                sOpcodeStats->Reset();
+                handler->SendSysMessage("Opcode statistics reset.");
+                return true;
+            }
+
+            if (mode == "calls")
+                order = OPCODE_STATS_SORT_CALLS;
+            else if (mode == "p99")
+                order = OPCODE_STATS_SORT_P99;
+            else if (mode == "bytes")
+                order = OPCODE_STATS_SORT_BYTES;
+            else if (mode != "time")
+                countStr = modeStr;
+        }
+
+        uint32 count = countStr ? uint32(atoi(countStr)) : 10;
+        if (!count)
+        {
+            handler->SendSysMessage(LANG_BAD_VALUE);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (!sOpcodeStats->IsEnabled())
+            handler->SendSysMessage("Opcode statistics collection is disabled, use .debug opcodestats on");
+
+        OpcodeStatsSnapshot snapshot;
+        sOpcodeStats->GetSnapshot(snapshot, order);
+
+        handler->PSendSysMessage("Opcode statistics: %u opcodes seen by %u threads", uint32(snapshot.size()), sOpcodeStats->GetThreadCount());
+        for (uint32 i = 0; i < snapshot.size() && i < count; ++i)
+            handler->PSendSysMessage("%s", OpcodeStats::FormatEntry(snapshot[i]).c_str());
+
+        return true;
+    }
+
+    static bool HandleDebugDatabaseStatsCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug dbstats [on|off|reset] | [character|login|world] [#count]
+        char* modeStr = strtok((char*)args, " ");
+        char* countStr = strtok(NULL, " ");
+
+        bool showCharacter = true, showLogin = true, showWorld = true;
+        if (modeStr)
+        {
+            std::string mode = modeStr;
+            if (mode == "on" || mode == "off")
+            {
+                CharacterDatabase.GetStats().SetEnabled(mode == "on");
+                LoginDatabase.GetStats().SetEnabled(mode == "on");
+                WorldDatabase.GetStats().SetEnabled(mode == "on");
+                handler->PSendSysMessage("Database statistics collection %s.", mode == "on" ? "enabled" : "disabled");
+                return true;
+            }
+
+            if (mode == "reset")
+            {
+                CharacterDatabase.GetStats().Reset();
+                LoginDatabase.GetStats().Reset();
+                WorldDatabase.GetStats().Reset();
+                handler->SendSysMessage("Database statistics reset.");
+                return true;
+            }
+
+            if (mode == "character" || mode == "login" || mode == "world")
+            {
+                showCharacter = mode == "character";
+                showLogin = mode == "login";
+                showWorld = mode == "world";
+            }
+            else
+                countStr = modeStr;
+        }
+
+        uint32 count = countStr ? uint32(atoi(countStr)) : 5;
+        if (!count)
+        {
+            handler->SendSysMessage(LANG_BAD_VALUE);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (!CharacterDatabase.GetStats().IsEnabled())
+            handler->SendSysMessage("Database statistics collection is disabled, use .debug dbstats on");
+
+        std::vector<std::string> lines;
+        if (showCharacter)
+            CharacterDatabase.GetStatsReport(lines, count);
+        if (showLogin)
+            LoginDatabase.GetStatsReport(lines, count);
+        if (showWorld)
+            WorldDatabase.GetStatsReport(lines, count);
+
+        for (std::vector<std::string>::const_iterator itr = lines.begin(); itr != lines.end(); ++itr)
+            handler->PSendSysMessage("%s", itr->c_str());
+
+        return true;
+    }
+
+    static void SendTickProfile(ChatHandler* handler, TickProfile const& profile, bool sections = false)
+    {
+        TickPhaseStats tick = profile.GetPhaseStats(MAX_TICK_PHASES);
+        handler->PSendSysMessage("%s: " UI64FMTD " ticks, last %u: p50 %u us p99 %u us max %u us avg %u us", profile.GetName(), profile.GetTotalTicks(),
+            profile.GetSampleCount(), tick.P50, tick.P99, tick.Max, tick.Average);
+
+        for (uint8 phase = 0; phase < profile.GetPhaseCount(); ++phase)
+        {
+            TickPhaseStats stats = profile.GetPhaseStats(phase);
+            handler->PSendSysMessage("  %-16s p50 %u us p99 %u us max %u us avg %u us", TickProfiler::GetPhaseName(profile.GetType(), phase),
+                stats.P50, stats.P99, stats.Max, stats.Average);
+        }
+
+        if (!sections || profile.GetType() != TICK_PROFILE_MAP)
+            return;
+
+        handler->SendSysMessage("  Combat sections (overlapping):");
+        for (uint8 section = 0; section < MAX_MAP_TICK_SECTIONS; ++section)
+        {
+            TickPhaseStats stats = profile.GetSectionStats(section);
+            handler->PSendSysMessage("  %-16s p50 %u us p99 %u us max %u us avg %u us", TickProfiler::GetSectionName(section),
+                stats.P50, stats.P99, stats.Max, stats.Average);
+        }
+    }
+
+    static bool HandleDebugTickProfileCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug tickprofile [on|off|reset|csv|trace|map #mapid [#instanceid]]
+        char* modeStr = strtok((char*)args, " ");
+        if (modeStr)
+        {
+            std::string mode = modeStr;
+            if (mode == "on" || mode == "off")
+            {
+                sTickProfiler->SetEnabled(mode == "on");
+                handler->PSendSysMessage("Tick profiling %s.", mode == "on" ? "enabled" : "disabled");
+                return true;
+            }
+
+            if (mode == "reset")
+            {
+                sTickProfiler->Reset();
+                handler->SendSysMessage("Tick profiles reset.");
+                return true;
+            }
+
+            if (mode == "csv" || mode == "trace")
+            {
+                std::string fileName = sConfigMgr->GetStringDefault("LogsDir", "");
+                if (!fileName.empty() && fileName.at(fileName.length() - 1) != '/' && fileName.at(fileName.length() - 1) != '\\')
+                    fileName.push_back('/');
+
+                fileName += "tickprofile_" + TimeToTimestampStr(time(NULL)) + (mode == "csv" ? ".csv" : ".json");
+
+                bool written = mode == "csv" ? sTickProfiler->WriteCSV(fileName) : sTickProfiler->WriteChromeTrace(fileName);
+                if (!written)
+                {
+                    handler->PSendSysMessage("Could not open %s for writing.", fileName.c_str());
+                    handler->SetSentErrorMessage(true);
+                    return false;
+                }
+
+                handler->PSendSysMessage("Tick profiles written to %s.", fileName.c_str());
+                return true;
+            }
+
+            if (mode == "map")
+            {
+                char* mapIdStr = strtok(NULL, " ");
+                char* instanceIdStr = strtok(NULL, " ");
+                if (!mapIdStr)
+                    return false;
+
+                TickProfile profile(TICK_PROFILE_MAP, 0, 0, NULL);
+                if (!sTickProfiler->GetMapProfile(uint32(atoi(mapIdStr)), instanceIdStr ? uint32(atoi(instanceIdStr)) : 0, profile))
+                {
+                    handler->SendSysMessage("No ticks recorded for this map.");
+                    handler->SetSentErrorMessage(true);
+                    return false;
+                }
+
+                SendTickProfile(handler, profile, true);
+                return true;
+            }
+
+            return false;
+        }
+
+        if (!sTickProfiler->IsEnabled())
+            handler->SendSysMessage("Tick profiling is disabled, use .debug tickprofile on");
+
+        SendTickProfile(handler, sTickProfiler->GetWorldProfile());
+
+        // slowest maps first
+        std::vector<TickProfile> maps;
+        sTickProfiler->GetMapProfiles(maps);
+
+        std::vector<std::pair<uint32, uint32> > order;
+        for (uint32 i = 0; i < maps.size(); ++i)
+            order.push_back(std::make_pair(maps[i].GetPhaseStats(MAX_TICK_PHASES).P99, i));
+        std::sort(order.rbegin(), order.rend());
+
+        handler->PSendSysMessage("Maps: %u profiled", uint32(maps.size()));
+        for (uint32 i = 0; i < order.size() && i < 10; ++i)
+        {
+            TickProfile const& profile = maps[order[i].second];
+            TickPhaseStats tick = profile.GetPhaseStats(MAX_TICK_PHASES);
+            handler->PSendSysMessage("  %s (map %u instance %u): p50 %u us p99 %u us max %u us", profile.GetName(), profile.GetMapId(),
+                profile.GetInstanceId(), tick.P50, tick.P99, tick.Max);
+        }
+
+        return true;
+    }
+
     static bool HandleWPGPSCommand(ChatHandler* handler, char const* /*args*/)
     {
         Player* player = handler->GetSession()->GetPlayer();
@@ -86,7 +86,7 @@ public:
         creatureTarget->SetHealth(0); // just for nice GM-mode view
 
         pet->SetUInt64Value(UNIT_FIELD_CREATEDBY, player->GetGUID());
-        pet->SetUInt32Value(UNIT_FIELD_FACTIONTEMPLATE, player->getFaction());
+        pet->setFaction(player->getFaction());
 
         if (!pet->InitStatsForLevel(creatureTarget->getLevel()))
         {
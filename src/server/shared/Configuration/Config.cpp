@@ -47,16 +47,16 @@ bool ConfigMgr::LoadInitial(char const* file)
 {
     ASSERT(file);
 
+    // parsed without holding the lock, a file that fails to load leaves the current settings in place
+    Config config(new ACE_Configuration_Heap());
+    if (config->open() != 0 || !LoadData(config, file))
+        return false;
+
     GuardType guard(_configLock);
 
     _filename = file;
-    _config.reset(new ACE_Configuration_Heap());
-    if (_config->open() == 0)
-        if (LoadData(_filename.c_str()))
-            return true;
-
-    _config.reset();
-    return false;
+    _config = config;
+    return true;
 }
 
 bool ConfigMgr::LoadMore(char const* file)
@@ -66,17 +66,18 @@ bool ConfigMgr::LoadMore(char const* file)
 
     GuardType guard(_configLock);
 
-    return LoadData(file);
+    return LoadData(_config, file);
 }
 
 bool ConfigMgr::Reload()
 {
-    return LoadInitial(_filename.c_str());
+    std::string filename = GetFilename();
+    return LoadInitial(filename.c_str());
 }
 
-bool ConfigMgr::LoadData(char const* file)
+bool ConfigMgr::LoadData(Config& config, char const* file)
 {
-    ACE_Ini_ImpExp config_importer(*_config.get());
+    ACE_Ini_ImpExp config_importer(*config.get());
     if (config_importer.import_config(file) == 0)
         return true;
 
@@ -60,7 +60,7 @@ public:
 
 private:
     bool GetValueHelper(const char* name, ACE_TString &result);
-    bool LoadData(char const* file);
+    bool LoadData(Config& config, char const* file);
 
     typedef ACE_Thread_Mutex LockType;
     typedef ACE_Guard<LockType> GuardType;
@@ -23,6 +23,29 @@
 #include <openssl/crypto.h>
 #include <algorithm>
 #include <ace/Auto_Ptr.h>
+#include <ace/TSS_T.h>
+
+#define MODEXP_WINDOW_BITS 4                               // FixedBaseModExp reads two digits per exponent byte
+#define MODEXP_WINDOW_SIZE (1 << MODEXP_WINDOW_BITS)        // digits per window, 0 included
+
+namespace
+{
+    /// Scratch BN_CTX of one thread, an operation only borrows temporaries from it
+    struct BigNumberContext
+    {
+        BigNumberContext() : Ctx(BN_CTX_new()) { }
+        ~BigNumberContext() { BN_CTX_free(Ctx); }
+
+        BN_CTX* Ctx;
+    };
+
+    ACE_TSS<BigNumberContext> threadContext;
+
+    BN_CTX* GetThreadContext()
+    {
+        return threadContext->Ctx;
+    }
+}
 
 BigNumber::BigNumber()
     : _bn(BN_new())
@@ -100,58 +123,33 @@ BigNumber BigNumber::operator-=(BigNumber const& bn)
 
 BigNumber BigNumber::operator*=(BigNumber const& bn)
 {
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mul(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_mul(_bn, _bn, bn._bn, GetThreadContext());
     return *this;
 }
 
 BigNumber BigNumber::operator/=(BigNumber const& bn)
 {
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_div(_bn, NULL, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_div(_bn, NULL, _bn, bn._bn, GetThreadContext());
     return *this;
 }
 
 BigNumber BigNumber::operator%=(BigNumber const& bn)
 {
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mod(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_mod(_bn, _bn, bn._bn, GetThreadContext());
     return *this;
 }
 
 BigNumber BigNumber::Exp(BigNumber const& bn)
 {
     BigNumber ret;
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_exp(ret._bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_exp(ret._bn, _bn, bn._bn, GetThreadContext());
     return ret;
 }
 
 BigNumber BigNumber::ModExp(BigNumber const& bn1, BigNumber const& bn2)
 {
     BigNumber ret;
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, bnctx);
-    BN_CTX_free(bnctx);
-
+    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, GetThreadContext());
     return ret;
 }
 
@@ -200,3 +198,113 @@ char * BigNumber::AsDecStr() const
     return BN_bn2dec(_bn);
 }
 
+ModExpContext::ModExpContext(BigNumber const& modulus)
+    : _modulus(BN_dup(modulus._bn)), _mont(BN_MONT_CTX_new()), _one(BN_new()), _maxExponentBits(0),
+    _entryWords((BN_num_bytes(modulus._bn) + 7) / 8)
+{
+    BN_MONT_CTX_set(_mont, _modulus, GetThreadContext());
+    BN_to_montgomery(_one, BN_value_one(), _mont, GetThreadContext());
+}
+
+ModExpContext::~ModExpContext()
+{
+    BN_free(_one);
+    BN_MONT_CTX_free(_mont);
+    BN_free(_modulus);
+}
+
+void ModExpContext::SetFixedBase(BigNumber const& base, int32 maxExponentBits)
+{
+    BN_CTX* ctx = GetThreadContext();
+
+    int32 windows = (maxExponentBits + MODEXP_WINDOW_BITS - 1) / MODEXP_WINDOW_BITS;
+    _table.assign(windows * MODEXP_WINDOW_SIZE * _entryWords, 0);
+    _base = base;
+    _maxExponentBits = windows * MODEXP_WINDOW_BITS;
+
+    std::vector<BIGNUM*> digits(MODEXP_WINDOW_SIZE);
+    for (int32 digit = 0; digit < MODEXP_WINDOW_SIZE; ++digit)
+        digits[digit] = BN_new();
+
+    BN_copy(digits[0], _one);
+    for (int32 window = 0; window < windows; ++window)
+    {
+        // digit 1 of a window is base^(16^window), the product of digits 15 and 1 of the previous window
+        if (!window)
+        {
+            BN_nnmod(digits[1], base._bn, _modulus, ctx);
+            BN_to_montgomery(digits[1], digits[1], _mont, ctx);
+        }
+        else
+            BN_mod_mul_montgomery(digits[1], digits[MODEXP_WINDOW_SIZE - 1], digits[1], _mont, ctx);
+
+        for (int32 digit = 2; digit < MODEXP_WINDOW_SIZE; ++digit)
+            BN_mod_mul_montgomery(digits[digit], digits[digit - 1], digits[1], _mont, ctx);
+
+        // big endian bytes, left padded to whole words
+        uint8* entries = reinterpret_cast<uint8*>(&_table[window * MODEXP_WINDOW_SIZE * _entryWords]);
+        for (int32 digit = 0; digit < MODEXP_WINDOW_SIZE; ++digit)
+            BN_bn2bin(digits[digit], entries + (digit + 1) * _entryWords * 8 - BN_num_bytes(digits[digit]));
+    }
+
+    for (int32 digit = 0; digit < MODEXP_WINDOW_SIZE; ++digit)
+        BN_free(digits[digit]);
+}
+
+void ModExpContext::SelectEntry(int32 window, uint32 digit, uint64* entry) const
+{
+    memset(entry, 0, _entryWords * sizeof(uint64));
+
+    // every entry of the window is read, whatever the digit
+    uint64 const* candidates = &_table[window * MODEXP_WINDOW_SIZE * _entryWords];
+    for (uint32 candidate = 0; candidate < MODEXP_WINDOW_SIZE; ++candidate, candidates += _entryWords)
+    {
+        // all bits set if candidate == digit, 0 otherwise
+        uint64 mask = uint64(0) - (((candidate ^ digit) - 1) >> 31);
+        for (int32 i = 0; i < _entryWords; ++i)
+            entry[i] |= candidates[i] & mask;
+    }
+}
+
+BigNumber ModExpContext::ModExp(BigNumber const& base, BigNumber const& exponent) const
+{
+    BigNumber ret;
+    BN_mod_exp_mont(ret._bn, base._bn, exponent._bn, _modulus, GetThreadContext(), _mont);
+    return ret;
+}
+
+BigNumber ModExpContext::FixedBaseModExp(BigNumber const& exponent) const
+{
+    if (BN_num_bits(exponent._bn) > _maxExponentBits || BN_is_negative(exponent._bn))
+    {
+        // exponents are secret, take OpenSSL's constant time path
+        BigNumber secret(exponent);
+        BN_set_flags(secret._bn, BN_FLG_CONSTTIME);
+        return ModExp(_base, secret);
+    }
+
+    BN_CTX* ctx = GetThreadContext();
+
+    // every window is multiplied in, digits of 0 included, so the work doesn't depend on the exponent
+    std::vector<uint8> exponentBytes((_maxExponentBits + 7) / 8, 0);
+    BN_bn2bin(exponent._bn, &exponentBytes[0] + exponentBytes.size() - BN_num_bytes(exponent._bn));
+
+    std::vector<uint64> entry(_entryWords);
+    BigNumber factor;
+    BigNumber ret;
+    BN_copy(ret._bn, _one);
+
+    int32 windows = _maxExponentBits / MODEXP_WINDOW_BITS;
+    for (int32 window = 0; window < windows; ++window)
+    {
+        uint8 byte = exponentBytes[exponentBytes.size() - 1 - window / 2];
+        uint32 digit = (window & 1) ? byte >> MODEXP_WINDOW_BITS : byte & (MODEXP_WINDOW_SIZE - 1);
+
+        SelectEntry(window, digit, &entry[0]);
+        BN_bin2bn(reinterpret_cast<uint8 const*>(&entry[0]), _entryWords * 8, factor._bn);
+        BN_mod_mul_montgomery(ret._bn, ret._bn, factor._bn, _mont, ctx);
+    }
+
+    BN_from_montgomery(ret._bn, ret._bn, _mont, ctx);
+    return ret;
+}
@@ -21,11 +21,15 @@
 
 #include "Define.h"
 #include <ace/Auto_Ptr.h>
+#include <vector>
 
 struct bignum_st;
+struct bn_mont_ctx_st;
 
 class BigNumber
 {
+    friend class ModExpContext;
+
     public:
         BigNumber();
         BigNumber(BigNumber const& bn);
@@ -96,5 +100,44 @@ class BigNumber
         struct bignum_st *_bn;
 
 };
+
+/**
+    Modular exponentiation with a fixed odd modulus, keeps its Montgomery context.
+
+    SetFixedBase() precomputes base^(j * 16^i) in Montgomery form, so FixedBaseModExp()
+    needs one multiplication per 4 exponent bits and no squaring. Exponents are taken as
+    secret: every window is multiplied in and its entry is selected by reading all 16
+    candidates, so neither depends on the exponent's digits. The context is read only
+    once set up and can be shared by all threads.
+*/
+class ModExpContext
+{
+    public:
+        explicit ModExpContext(BigNumber const& modulus);
+        ~ModExpContext();
+
+        void SetFixedBase(BigNumber const& base, int32 maxExponentBits);
+
+        /// base^exponent % modulus
+        BigNumber ModExp(BigNumber const& base, BigNumber const& exponent) const;
+        /// base^exponent % modulus for the base given to SetFixedBase
+        BigNumber FixedBaseModExp(BigNumber const& exponent) const;
+
+    private:
+        ModExpContext(ModExpContext const&);
+        ModExpContext& operator=(ModExpContext const&);
+
+        // Copies the entry of digit in window to entry, reading every entry of the window
+        void SelectEntry(int32 window, uint32 digit, uint64* entry) const;
+
+        struct bignum_st* _modulus;
+        struct bn_mont_ctx_st* _mont;
+        struct bignum_st* _one;                             // 1 in Montgomery form
+        BigNumber _base;
+        int32 _maxExponentBits;
+        int32 _entryWords;                                  // size of the modulus in 64 bit words
+        std::vector<uint64> _table;                         // [(window * 16 + digit) * _entryWords], big endian Montgomery form
+};
+
 #endif
 
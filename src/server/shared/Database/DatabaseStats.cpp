@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseStats.h"
+#include <ace/Guard_T.h>
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    bool ExecutionTimeOrder(DatabaseStatementStatsEntry const& left, DatabaseStatementStatsEntry const& right)
+    {
+        return left.Stats.Execution.Total > right.Stats.Execution.Total;
+    }
+}
+
+void DatabaseTiming::Add(uint64 time)
+{
+    Total += time;
+    if (time > Max)
+        Max = time;
+    Histogram.Add(time);
+}
+
+uint64 DatabaseTiming::GetAverage() const
+{
+    uint64 count = GetCount();
+    return count ? Total / count : 0;
+}
+
+void DatabaseStats::Reset()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    _pool = DatabaseStatementStats();
+    _statements.clear();
+}
+
+void DatabaseStats::RecordQueueWait(uint32 index, uint64 time)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    _pool.QueueWait.Add(time);
+    if (index != DATABASE_STATS_ADHOC)
+        _statements[index].QueueWait.Add(time);
+}
+
+void DatabaseStats::RecordConnectionWait(uint32 index, uint64 time)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    _pool.ConnectionWait.Add(time);
+    if (index != DATABASE_STATS_ADHOC)
+        _statements[index].ConnectionWait.Add(time);
+}
+
+void DatabaseStats::RecordExecution(uint32 index, uint64 time, uint64 rows)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    ++_pool.Calls;
+    _pool.Rows += rows;
+    _pool.Execution.Add(time);
+
+    if (index == DATABASE_STATS_ADHOC)
+        return;
+
+    DatabaseStatementStats& stats = _statements[index];
+    ++stats.Calls;
+    stats.Rows += rows;
+    stats.Execution.Add(time);
+}
+
+DatabaseStatementStats DatabaseStats::GetPoolStats() const
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, DatabaseStatementStats());
+    return _pool;
+}
+
+void DatabaseStats::GetSnapshot(DatabaseStatsSnapshot& snapshot) const
+{
+    snapshot.clear();
+
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+        snapshot.reserve(_statements.size());
+        for (StatementStatsContainer::const_iterator itr = _statements.begin(); itr != _statements.end(); ++itr)
+        {
+            DatabaseStatementStatsEntry entry;
+            entry.Index = itr->first;
+            entry.Stats = itr->second;
+            snapshot.push_back(entry);
+        }
+    }
+
+    std::sort(snapshot.begin(), snapshot.end(), ExecutionTimeOrder);
+}
+
+std::string DatabaseStats::FormatTiming(char const* name, DatabaseTiming const& timing)
+{
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "%s avg " UI64FMTD " p99 <" UI64FMTD " max " UI64FMTD " us", name, timing.GetAverage(),
+        timing.Histogram.GetPercentile(99.0f), timing.Max);
+
+    return buffer;
+}
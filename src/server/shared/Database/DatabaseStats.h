@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_DATABASESTATS_H
+#define INFINITY_DATABASESTATS_H
+
+#include "Define.h"
+#include "LatencyHistogram.h"
+#include <ace/Thread_Mutex.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#define DATABASE_STATS_ADHOC    0xFFFFFFFF                  // operations without a prepared statement index
+
+struct DatabaseTiming
+{
+    DatabaseTiming() : Total(0), Max(0) { }
+
+    void Add(uint64 time);
+
+    uint64 GetCount() const { return Histogram.GetCount(); }
+    uint64 GetAverage() const;
+
+    uint64 Total;                                           // microseconds
+    uint64 Max;                                             // microseconds
+    LatencyHistogram Histogram;
+};
+
+struct DatabaseStatementStats
+{
+    DatabaseStatementStats() : Calls(0), Rows(0) { }
+
+    uint64 Calls;                                           // executions on the MySQL server
+    uint64 Rows;                                            // rows returned by queries or affected by other statements
+    DatabaseTiming QueueWait;                               // time spent in the asynchronous queue
+    DatabaseTiming ConnectionWait;                          // time spent waiting for a free synchronous connection
+    DatabaseTiming Execution;                               // time spent on the MySQL server, result fetch included
+};
+
+struct DatabaseStatementStatsEntry
+{
+    uint32 Index;
+    DatabaseStatementStats Stats;
+};
+
+typedef std::vector<DatabaseStatementStatsEntry> DatabaseStatsSnapshot;
+
+/**
+    Statistics of one DatabaseWorkerPool, as a whole and per prepared statement index.
+
+    Writers are the worker threads and every thread using the synchronous connections,
+    they share one lock per pool. Nothing is recorded, and the lock never taken, while
+    collection is disabled.
+*/
+class DatabaseStats
+{
+    public:
+        DatabaseStats() : _enabled(false) { }
+
+        bool IsEnabled() const { return _enabled; }
+        void SetEnabled(bool enabled) { _enabled = enabled; }
+        void Reset();
+
+        void RecordQueueWait(uint32 index, uint64 time);
+        void RecordConnectionWait(uint32 index, uint64 time);
+        void RecordExecution(uint32 index, uint64 time, uint64 rows);
+
+        DatabaseStatementStats GetPoolStats() const;
+        /// Prepared statements seen so far, highest total execution time first
+        void GetSnapshot(DatabaseStatsSnapshot& snapshot) const;
+
+        static std::string FormatTiming(char const* name, DatabaseTiming const& timing);
+
+    private:
+        typedef std::map<uint32, DatabaseStatementStats> StatementStatsContainer;
+
+        volatile bool _enabled;
+
+        DatabaseStatementStats _pool;
+        StatementStatsContainer _statements;
+        mutable ACE_Thread_Mutex _lock;
+};
+
+#endif
@@ -41,6 +41,9 @@ int DatabaseWorker::svc()
         if (!request)
             break;
 
+        if (request->m_queuedTime && m_conn->m_stats && m_conn->m_stats->IsEnabled())
+            m_conn->m_stats->RecordQueueWait(request->GetStatementIndex(), GetUSTimeDiffToNow(request->m_queuedTime));
+
         request->SetConnection(m_conn);
         request->call();
 
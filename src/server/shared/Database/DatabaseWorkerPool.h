@@ -30,10 +30,23 @@
 #include "QueryResult.h"
 #include "QueryHolder.h"
 #include "AdhocStatement.h"
+#include "DatabaseStats.h"
+#include "Timer.h"
 
 #define MIN_MYSQL_SERVER_VERSION 50100u
 #define MIN_MYSQL_CLIENT_VERSION 50100u
 
+struct WriteBatchStats
+{
+    WriteBatchStats() : Batches(0), Operations(0), Merged(0), LargestBatch(0), Pending(0) { }
+
+    uint64 Batches;                                         // batches handed to the worker threads
+    uint64 Operations;                                      // statements and transactions sent in them
+    uint64 Merged;                                          // statements replaced by a later one with the same key
+    uint32 LargestBatch;
+    uint32 Pending;                                         // operations waiting in the current batch
+};
+
 class PingOperation : public SQLOperation
 {
     //! Operation for idle delaythreads
@@ -50,7 +63,11 @@ class DatabaseWorkerPool
     public:
         /* Activity state */
         DatabaseWorkerPool() :
-        _queue(new ACE_Activation_Queue())
+        _queue(new ACE_Activation_Queue()),
+        _batch(NULL),
+        _batchStartTime(0),
+        _batchMaxSize(0),
+        _batchMaxDelay(0)
         {
             memset(_connectionCount, 0, sizeof(_connectionCount));
             _connections.resize(IDX_SIZE);
@@ -76,6 +93,7 @@ class DatabaseWorkerPool
             for (uint8 i = 0; i < async_threads; ++i)
             {
                 T* t = new T(_queue, _connectionInfo);
+                t->m_stats = &_stats;
                 res &= t->Open();
                 if (res) // only check mysql version if connection is valid
                     WPFatal(mysql_get_server_version(t->GetHandle()) >= MIN_MYSQL_SERVER_VERSION, "InfinityCore does not support MySQL versions below 5.1");
@@ -83,11 +101,27 @@ class DatabaseWorkerPool
                 ++_connectionCount[IDX_ASYNC];
             }
 
+            //! Remember which statements may replace each other in a write batch
+            if (_connectionCount[IDX_ASYNC])
+            {
+                PreparedStatementMap const& queries = _connections[IDX_ASYNC][0]->m_queries;
+                for (PreparedStatementMap::const_iterator itr = queries.begin(); itr != queries.end(); ++itr)
+                {
+                    if (!(itr->second.second & CONNECTION_MERGE))
+                        continue;
+
+                    if (itr->first >= _mergeable.size())
+                        _mergeable.resize(itr->first + 1, false);
+                    _mergeable[itr->first] = true;
+                }
+            }
+
             //! Open synchronous connections (direct, blocking operations)
             _connections[IDX_SYNCH].resize(synch_threads);
             for (uint8 i = 0; i < synch_threads; ++i)
             {
                 T* t = new T(_connectionInfo);
+                t->m_stats = &_stats;
                 res &= t->Open();
                 _connections[IDX_SYNCH][i] = t;
                 ++_connectionCount[IDX_SYNCH];
@@ -106,6 +140,11 @@ class DatabaseWorkerPool
         {
             IC_LOG_INFO("sql.driver", "Closing down DatabasePool '%s'.", GetDatabaseName());
 
+            {
+                ACE_GUARD(ACE_Thread_Mutex, guard, _batchLock);
+                FlushWriteBatch();
+            }
+
             //! Shuts down delaythreads for this connection pool by underlying deactivate().
             //! The next dequeue attempt in the worker thread tasks will result in an error,
             //! ultimately ending the worker thread task.
@@ -171,6 +210,12 @@ class DatabaseWorkerPool
         //! Statement must be prepared with CONNECTION_ASYNC flag.
         void Execute(PreparedStatement* stmt)
         {
+            if (_batchMaxSize)
+            {
+                AppendToWriteBatch(stmt);
+                return;
+            }
+
             PreparedStatementTask* task = new PreparedStatementTask(stmt);
             Enqueue(task);
         }
@@ -211,7 +256,7 @@ class DatabaseWorkerPool
         //! Statement must be prepared with the CONNECTION_SYNCH flag.
         void DirectExecute(PreparedStatement* stmt)
         {
-            T* t = GetFreeConnection();
+            T* t = GetFreeConnection(stmt->GetIndex());
             t->Execute(stmt);
             t->Unlock();
 
@@ -274,12 +319,52 @@ class DatabaseWorkerPool
             return Query(szQuery);
         }
 
+        //! Directly executes an SQL query in string format, its rows are read from the server while iterating
+        //! instead of being buffered, so memory use does not grow with the table. Meant for large startup loaders.
+        //! A synchronous connection stays locked until the last row is read or the result is released, so other
+        //! synchronous queries on this pool from inside the loop need more than one synchronous connection.
+        StreamedQueryResult StreamQuery(const char* sql)
+        {
+            T* conn = GetFreeConnection();
+
+            StreamedResultSet* result = conn->StreamQuery(sql);
+            if (!result)
+            {
+                conn->Unlock();
+                return StreamedQueryResult(NULL);
+            }
+
+            //! The result unlocks the connection once the rows are exhausted
+            if (!result->NextRow())
+            {
+                delete result;
+                return StreamedQueryResult(NULL);
+            }
+
+            return StreamedQueryResult(result);
+        }
+
+        //! Directly executes an SQL query in string format -with variable args- and streams its rows, see StreamQuery.
+        StreamedQueryResult PStreamQuery(const char* sql, ...)
+        {
+            if (!sql)
+                return StreamedQueryResult(NULL);
+
+            va_list ap;
+            char szQuery[MAX_QUERY_LEN];
+            va_start(ap, sql);
+            vsnprintf(szQuery, MAX_QUERY_LEN, sql, ap);
+            va_end(ap);
+
+            return StreamQuery(szQuery);
+        }
+
         //! Directly executes an SQL query in prepared format that will block the calling thread until finished.
         //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
         //! Statement must be prepared with CONNECTION_SYNCH flag.
         PreparedQueryResult Query(PreparedStatement* stmt)
         {
-            T* t = GetFreeConnection();
+            T* t = GetFreeConnection(stmt->GetIndex());
             PreparedResultSet* ret = t->Query(stmt);
             t->Unlock();
 
@@ -376,6 +461,12 @@ class DatabaseWorkerPool
             }
             #endif // INFINITY_DEBUG
 
+            if (_batchMaxSize)
+            {
+                AppendToWriteBatch(transaction);
+                return;
+            }
+
             Enqueue(new TransactionTask(transaction));
         }
 
@@ -473,6 +564,92 @@ class DatabaseWorkerPool
                 Enqueue(new PingOperation);
         }
 
+        /**
+            Statistics.
+        */
+
+        //! Call counts, rows, queue, connection and execution times of the pool and its prepared statements.
+        DatabaseStats& GetStats() { return _stats; }
+
+        //! Human readable summary of the pool followed by its limit most expensive prepared statements.
+        void GetStatsReport(std::vector<std::string>& lines, uint32 limit)
+        {
+            DatabaseStatementStats pool = _stats.GetPoolStats();
+            WriteBatchStats batches = GetWriteBatchStats();
+
+            char buffer[256];
+            snprintf(buffer, sizeof(buffer), "DatabasePool '%s': queue %u, calls " UI64FMTD ", rows " UI64FMTD ", write batches " UI64FMTD " (largest %u, merged " UI64FMTD ")",
+                GetDatabaseName(), uint32(GetQueueSize()), pool.Calls, pool.Rows, batches.Batches, batches.LargestBatch, batches.Merged);
+            lines.push_back(buffer);
+            lines.push_back("  " + DatabaseStats::FormatTiming("execution", pool.Execution));
+            lines.push_back("  " + DatabaseStats::FormatTiming("queue wait", pool.QueueWait));
+            lines.push_back("  " + DatabaseStats::FormatTiming("connection wait", pool.ConnectionWait));
+
+            DatabaseStatsSnapshot snapshot;
+            _stats.GetSnapshot(snapshot);
+            for (uint32 i = 0; i < snapshot.size() && i < limit; ++i)
+            {
+                DatabaseStatementStats const& stats = snapshot[i].Stats;
+                snprintf(buffer, sizeof(buffer), "  #%u calls " UI64FMTD " rows " UI64FMTD " total " UI64FMTD " ms, exec avg " UI64FMTD " p99 <" UI64FMTD " us, queue avg " UI64FMTD " us, conn avg " UI64FMTD " us: %.60s",
+                    snapshot[i].Index, stats.Calls, stats.Rows, stats.Execution.Total / IN_MILLISECONDS, stats.Execution.GetAverage(),
+                    stats.Execution.Histogram.GetPercentile(99.0f), stats.QueueWait.GetAverage(), stats.ConnectionWait.GetAverage(),
+                    GetStatementQuery(snapshot[i].Index));
+                lines.push_back(buffer);
+            }
+        }
+
+        //! Writes GetStatsReport to the "sql.stats" logger
+        void LogStats(uint32 limit)
+        {
+            static LogSite logSite = { "sql.stats", NULL, 0 };
+            if (!sLog->ShouldLog(logSite, LOG_LEVEL_INFO))
+                return;
+
+            std::vector<std::string> lines;
+            GetStatsReport(lines, limit);
+            for (std::vector<std::string>::const_iterator itr = lines.begin(); itr != lines.end(); ++itr)
+                IC_LOG_INFO("sql.stats", "%s", itr->c_str());
+        }
+
+        /**
+            Write batching.
+        */
+
+        //! Groups the operations enqueued by Execute(PreparedStatement*) and CommitTransaction into one transaction of
+        //! up to maxSize operations, handed to the worker threads once full or maxDelay milliseconds after it was started.
+        //! Any other asynchronous operation sends the pending batch first, so the queue keeps the order of the calls.
+        //! A maxSize below 2 disables batching. Must be set before the pool is used by other threads.
+        void SetWriteBatching(uint32 maxSize, uint32 maxDelay)
+        {
+            _batchMaxSize = maxSize > 1 ? maxSize : 0;
+            _batchMaxDelay = maxDelay;
+        }
+
+        //! Sends the pending write batch once it is older than the configured delay, called from the world update loop.
+        void UpdateWriteBatch()
+        {
+            if (!_batchMaxSize)
+                return;
+
+            ACE_GUARD(ACE_Thread_Mutex, guard, _batchLock);
+            if (_batch && getMSTimeDiff(_batchStartTime, getMSTime()) >= _batchMaxDelay)
+                FlushWriteBatch();
+        }
+
+        //! Operations waiting for a worker thread, a sent write batch counts as one, the pending one not at all.
+        size_t GetQueueSize() const
+        {
+            return _queue->method_count();
+        }
+
+        WriteBatchStats GetWriteBatchStats()
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _batchLock, WriteBatchStats());
+            WriteBatchStats stats = _batchStats;
+            stats.Pending = _batch ? uint32(_batch->GetSize()) : 0;
+            return stats;
+        }
+
     private:
         unsigned long EscapeString(char *to, const char *from, unsigned long length)
         {
@@ -484,13 +661,107 @@ class DatabaseWorkerPool
 
         void Enqueue(SQLOperation* op)
         {
+            if (_stats.IsEnabled())
+                op->m_queuedTime = getUSTime();
+
+            if (_batchMaxSize)
+            {
+                //! Whatever was batched so far was called first
+                ACE_GUARD(ACE_Thread_Mutex, guard, _batchLock);
+                FlushWriteBatch();
+                _queue->enqueue(op);
+                return;
+            }
+
             _queue->enqueue(op);
         }
 
+        void AppendToWriteBatch(PreparedStatement* stmt)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, _batchLock);
+            StartWriteBatch();
+
+            //! Mergeable statements only assign values, so the last one of a key wins wherever it runs
+            //! as long as no other operation in between could have read or written the row.
+            uint32 index = stmt->GetIndex();
+            uint64 key;
+            if (index < _mergeable.size() && _mergeable[index] && stmt->GetParameterCount() &&
+                stmt->GetIntegerParameter(stmt->GetParameterCount() - 1, key))
+            {
+                std::pair<uint32, uint64> batchKey(index, key);
+                WriteBatchKeyMap::iterator itr = _batchKeys.find(batchKey);
+                if (itr != _batchKeys.end())
+                {
+                    _batch->Remove(itr->second);
+                    ++_batchStats.Merged;
+                    itr->second = _batch->Append(stmt);
+                }
+                else
+                    _batchKeys[batchKey] = _batch->Append(stmt);
+            }
+            else
+            {
+                _batchKeys.clear();
+                _batch->Append(stmt);
+            }
+
+            if (IsWriteBatchDue())
+                FlushWriteBatch();
+        }
+
+        void AppendToWriteBatch(SQLTransaction& transaction)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, _batchLock);
+            StartWriteBatch();
+
+            _batchKeys.clear();
+            _batch->Append(transaction);
+
+            if (IsWriteBatchDue())
+                FlushWriteBatch();
+        }
+
+        //! Caller must hold _batchLock
+        void StartWriteBatch()
+        {
+            if (_batch)
+                return;
+
+            _batch = new WriteBatchTask();
+            _batchStartTime = getMSTime();
+        }
+
+        //! Caller must hold _batchLock
+        bool IsWriteBatchDue() const
+        {
+            return _batch->GetSize() >= _batchMaxSize || getMSTimeDiff(_batchStartTime, getMSTime()) >= _batchMaxDelay;
+        }
+
+        //! Caller must hold _batchLock
+        void FlushWriteBatch()
+        {
+            if (!_batch)
+                return;
+
+            uint32 size = uint32(_batch->GetSize());
+            ++_batchStats.Batches;
+            _batchStats.Operations += size;
+            _batchStats.LargestBatch = std::max(_batchStats.LargestBatch, size);
+
+            if (_stats.IsEnabled())
+                _batch->m_queuedTime = getUSTime();
+
+            _queue->enqueue(_batch);
+            _batch = NULL;
+            _batchKeys.clear();
+        }
+
         //! Gets a free connection in the synchronous connection pool.
         //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
-        T* GetFreeConnection()
+        //! The time spent waiting is accounted to the given prepared statement.
+        T* GetFreeConnection(uint32 index = DATABASE_STATS_ADHOC)
         {
+            uint64 statsStart = _stats.IsEnabled() ? getUSTime() : 0;
             uint8 i = 0;
             size_t num_cons = _connectionCount[IDX_SYNCH];
             T* t = NULL;
@@ -503,9 +774,23 @@ class DatabaseWorkerPool
                     break;
             }
 
+            if (statsStart)
+                _stats.RecordConnectionWait(index, GetUSTimeDiffToNow(statsStart));
+
             return t;
         }
 
+        char const* GetStatementQuery(uint32 index)
+        {
+            uint8 type = _connectionCount[IDX_SYNCH] ? IDX_SYNCH : IDX_ASYNC;
+            if (!_connectionCount[type])
+                return "";
+
+            PreparedStatementMap const& queries = _connections[type][0]->m_queries;
+            PreparedStatementMap::const_iterator itr = queries.find(index);
+            return itr != queries.end() ? itr->second.first.c_str() : "";
+        }
+
         char const* GetDatabaseName() const
         {
             return _connectionInfo.database.c_str();
@@ -519,10 +804,23 @@ class DatabaseWorkerPool
             IDX_SIZE
         };
 
+        typedef std::map<std::pair<uint32 /*index*/, uint64 /*key*/>, size_t /*position*/> WriteBatchKeyMap;
+
         ACE_Activation_Queue*           _queue;             //! Queue shared by async worker threads.
         std::vector< std::vector<T*> >  _connections;
         uint32                          _connectionCount[2];       //! Counter of MySQL connections;
         MySQLConnectionInfo             _connectionInfo;
+
+        ACE_Thread_Mutex                _batchLock;         //! Guards the write batch, see SetWriteBatching.
+        WriteBatchTask*                 _batch;             //! Pending one-way operations, NULL if none.
+        uint32                          _batchStartTime;
+        uint32                          _batchMaxSize;      //! 0 if batching is disabled.
+        uint32                          _batchMaxDelay;
+        WriteBatchKeyMap                _batchKeys;         //! Positions of the mergeable statements in the batch.
+        std::vector<bool>               _mergeable;         //! Statements prepared with CONNECTION_MERGE, by index.
+        WriteBatchStats                 _batchStats;
+
+        DatabaseStats                   _stats;
 };
 
 #endif
@@ -23,10 +23,16 @@
 
 #include <mysql.h>
 
+/**
+    Typed view of one column of a result row. The value is never owned by the field: it
+    points into the arena of a PreparedResultSet or into the current MYSQL_ROW of a
+    ResultSet and is valid as long as the row it was fetched from.
+*/
 class Field
 {
     friend class ResultSet;
     friend class PreparedResultSet;
+    friend class StreamedResultSet;
 
     public:
 
@@ -263,7 +269,7 @@ class Field
         struct
         {
             uint32 length;          // Length (prepared strings only)
-            void* value;            // Actual data in memory
+            void* value;            // Actual data in memory, owned by the result set
             enum_field_types type;  // Field type
             bool raw;               // Raw bytes? (Prepared statement or ad hoc)
          } data;
@@ -273,14 +279,8 @@ class Field
         #pragma pack(pop)
         #endif
 
-        void SetByteValue(void const* newValue, size_t const newSize, enum_field_types newType, uint32 length);
-        void SetStructuredValue(char* newValue, enum_field_types newType);
-
-        void CleanUp()
-        {
-            delete[] ((char*)data.value);
-            data.value = NULL;
-        }
+        void SetByteValue(void* newValue, enum_field_types newType, uint32 length);
+        void SetStructuredValue(char* newValue, enum_field_types newType, uint32 length);
 
         static size_t SizeForType(MYSQL_FIELD* field)
         {
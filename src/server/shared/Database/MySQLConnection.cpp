@@ -33,10 +33,12 @@
 #include "DatabaseWorker.h"
 #include "Timer.h"
 #include "Log.h"
+#include "DatabaseStats.h"
 
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_stats(NULL),
 m_queue(NULL),
 m_worker(NULL),
 m_Mysql(NULL),
@@ -46,6 +48,7 @@ m_connectionFlags(CONNECTION_SYNCH) { }
 MySQLConnection::MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_stats(NULL),
 m_queue(queue),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
@@ -158,6 +161,7 @@ bool MySQLConnection::Execute(const char* sql)
 
     {
         uint32 _s = getMSTime();
+        uint64 statsStart = IsRecordingStats() ? getUSTime() : 0;
 
         if (mysql_query(m_Mysql, sql))
         {
@@ -173,6 +177,9 @@ bool MySQLConnection::Execute(const char* sql)
         }
         else
             IC_LOG_DEBUG("sql.sql", "[%u ms] SQL: %s", getMSTimeDiff(_s, getMSTime()), sql);
+
+        if (statsStart)
+            m_stats->RecordExecution(DATABASE_STATS_ADHOC, GetUSTimeDiffToNow(statsStart), mysql_affected_rows(m_Mysql));
     }
 
     return true;
@@ -196,6 +203,7 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
         MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
         uint32 _s = getMSTime();
+        uint64 statsStart = IsRecordingStats() ? getUSTime() : 0;
 
         if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
         {
@@ -223,6 +231,9 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
 
         IC_LOG_DEBUG("sql.sql", "[%u ms] SQL(p): %s", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString(m_queries[index].first).c_str());
 
+        if (statsStart)
+            m_stats->RecordExecution(index, GetUSTimeDiffToNow(statsStart), mysql_stmt_affected_rows(msql_STMT));
+
         m_mStmt->ClearParameters();
         return true;
     }
@@ -295,10 +306,46 @@ ResultSet* MySQLConnection::Query(const char* sql)
     uint64 rowCount = 0;
     uint32 fieldCount = 0;
 
+    uint64 statsStart = IsRecordingStats() ? getUSTime() : 0;
+
     if (!_Query(sql, &result, &fields, &rowCount, &fieldCount))
         return NULL;
 
-    return new ResultSet(result, fields, rowCount, fieldCount);
+    ResultSet* resultSet = new ResultSet(result, fields, rowCount, fieldCount);
+
+    if (statsStart)
+        m_stats->RecordExecution(DATABASE_STATS_ADHOC, GetUSTimeDiffToNow(statsStart), rowCount);
+
+    return resultSet;
+}
+
+StreamedResultSet* MySQLConnection::StreamQuery(const char* sql)
+{
+    if (!m_Mysql || !sql)
+        return NULL;
+
+    uint32 _s = getMSTime();
+
+    if (mysql_query(m_Mysql, sql))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        IC_LOG_INFO("sql.sql", "SQL: %s", sql);
+        IC_LOG_ERROR("sql.sql", "[%u] %s", lErrno, mysql_error(m_Mysql));
+
+        if (_HandleMySQLErrno(lErrno))      // If it returns true, an error was handled successfully (i.e. reconnection)
+            return StreamQuery(sql);        // We try again
+
+        return NULL;
+    }
+    else
+        IC_LOG_DEBUG("sql.sql", "[%u ms] SQL (streamed): %s", getMSTimeDiff(_s, getMSTime()), sql);
+
+    // rows stay on the server side until fetched
+    MYSQL_RES* result = mysql_use_result(m_Mysql);
+    if (!result)
+        return NULL;
+
+    return new StreamedResultSet(this, result, mysql_fetch_fields(result), mysql_field_count(m_Mysql));
 }
 
 bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount)
@@ -365,6 +412,48 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
 
     BeginTransaction();
 
+    if (!_ExecuteQueries(queries))
+    {
+        IC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
+        RollbackTransaction();
+        return false;
+    }
+
+    // we might encounter errors during certain queries, and depending on the kind of error
+    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
+    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
+    // and not while iterating over every element.
+
+    CommitTransaction();
+    return true;
+}
+
+bool MySQLConnection::ExecuteBatch(std::vector<WriteBatchElement> const& elements)
+{
+    BeginTransaction();
+
+    for (std::vector<WriteBatchElement>::const_iterator itr = elements.begin(); itr != elements.end(); ++itr)
+    {
+        bool success = true;
+        if (itr->Statement)
+            success = Execute(itr->Statement);
+        else if (!itr->Trans.null())
+            success = _ExecuteQueries(itr->Trans->m_queries);
+
+        if (!success)
+        {
+            IC_LOG_WARN("sql.sql", "Write batch aborted. %u operations not executed.", (uint32)elements.size());
+            RollbackTransaction();
+            return false;
+        }
+    }
+
+    CommitTransaction();
+    return true;
+}
+
+bool MySQLConnection::_ExecuteQueries(std::list<SQLElementData> const& queries)
+{
     std::list<SQLElementData>::const_iterator itr;
     for (itr = queries.begin(); itr != queries.end(); ++itr)
     {
@@ -376,11 +465,7 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
                 PreparedStatement* stmt = data.element.stmt;
                 ASSERT(stmt);
                 if (!Execute(stmt))
-                {
-                    IC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    RollbackTransaction();
                     return false;
-                }
             }
             break;
             case SQL_ELEMENT_RAW:
@@ -388,22 +473,12 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
                 const char* sql = data.element.query;
                 ASSERT(sql);
                 if (!Execute(sql))
-                {
-                    IC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    RollbackTransaction();
                     return false;
-                }
             }
             break;
         }
     }
 
-    // we might encounter errors during certain queries, and depending on the kind of error
-    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
-    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
-    // and not while iterating over every element.
-
-    CommitTransaction();
     return true;
 }
 
@@ -465,6 +540,8 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatement* stmt)
     uint64 rowCount = 0;
     uint32 fieldCount = 0;
 
+    uint64 statsStart = IsRecordingStats() ? getUSTime() : 0;
+
     if (!_Query(stmt, &result, &rowCount, &fieldCount))
         return NULL;
 
@@ -472,7 +549,18 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatement* stmt)
     {
         mysql_next_result(m_Mysql);
     }
-    return new PreparedResultSet(stmt->m_stmt->GetSTMT(), result, rowCount, fieldCount);
+
+    PreparedResultSet* resultSet = new PreparedResultSet(stmt->m_stmt->GetSTMT(), result, rowCount, fieldCount);
+
+    if (statsStart)
+        m_stats->RecordExecution(stmt->m_index, GetUSTimeDiffToNow(statsStart), resultSet->GetRowCount());
+
+    return resultSet;
+}
+
+bool MySQLConnection::IsRecordingStats() const
+{
+    return m_stats && m_stats->IsEnabled();
 }
 
 bool MySQLConnection::_HandleMySQLErrno(uint32 errNo)
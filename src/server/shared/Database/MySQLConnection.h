@@ -28,12 +28,17 @@ class DatabaseWorker;
 class PreparedStatement;
 class MySQLPreparedStatement;
 class PingOperation;
+class DatabaseStats;
 
 enum ConnectionFlags
 {
     CONNECTION_ASYNC = 0x1,
     CONNECTION_SYNCH = 0x2,
-    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH
+    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH,
+    //! Asynchronous UPDATE that only assigns bound values to the row whose integer key is bound
+    //! as last parameter, a later one with the same key replaces it while both wait in a write batch.
+    CONNECTION_MERGE = 0x4,
+    CONNECTION_ASYNC_MERGE = CONNECTION_ASYNC | CONNECTION_MERGE
 };
 
 struct MySQLConnectionInfo
@@ -68,6 +73,8 @@ class MySQLConnection
 {
     template <class T> friend class DatabaseWorkerPool;
     friend class PingOperation;
+    friend class StreamedResultSet;
+    friend class DatabaseWorker;
 
     public:
         MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
@@ -82,6 +89,8 @@ class MySQLConnection
         bool Execute(PreparedStatement* stmt);
         ResultSet* Query(const char* sql);
         PreparedResultSet* Query(PreparedStatement* stmt);
+        //! The connection must be locked by the caller, the returned result unlocks it once done
+        StreamedResultSet* StreamQuery(const char* sql);
         bool _Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount);
         bool _Query(PreparedStatement* stmt, MYSQL_RES **pResult, uint64* pRowCount, uint32* pFieldCount);
 
@@ -89,6 +98,8 @@ class MySQLConnection
         void RollbackTransaction();
         void CommitTransaction();
         bool ExecuteTransaction(SQLTransaction& transaction);
+        //! Executes the operations of a write batch in one transaction, rolled back if any of them fails
+        bool ExecuteBatch(std::vector<WriteBatchElement> const& elements);
 
         operator bool () const { return m_Mysql != NULL; }
         void Ping() { mysql_ping(m_Mysql); }
@@ -121,9 +132,13 @@ class MySQLConnection
         PreparedStatementMap                 m_queries;       //! Query storage
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        DatabaseStats*                       m_stats;         //! Statistics of the owning pool, may be NULL
+
+        bool IsRecordingStats() const;
 
     private:
         bool _HandleMySQLErrno(uint32 errNo);
+        bool _ExecuteQueries(std::list<SQLElementData> const& queries);
 
     private:
         ACE_Activation_Queue* m_queue;                      //! Queue shared with other asynchronous connections.
@@ -198,6 +198,46 @@ void PreparedStatement::setNull(const uint8 index)
     statement_data[index].type = TYPE_NULL;
 }
 
+bool PreparedStatement::GetIntegerParameter(const uint8 index, uint64& value) const
+{
+    if (index >= statement_data.size())
+        return false;
+
+    PreparedStatementData const& data = statement_data[index];
+    switch (data.type)
+    {
+        case TYPE_BOOL:
+            value = data.data.boolean ? 1 : 0;
+            return true;
+        case TYPE_UI8:
+            value = data.data.ui8;
+            return true;
+        case TYPE_UI16:
+            value = data.data.ui16;
+            return true;
+        case TYPE_UI32:
+            value = data.data.ui32;
+            return true;
+        case TYPE_UI64:
+            value = data.data.ui64;
+            return true;
+        case TYPE_I8:
+            value = uint64(data.data.i8);
+            return true;
+        case TYPE_I16:
+            value = uint64(data.data.i16);
+            return true;
+        case TYPE_I32:
+            value = uint64(data.data.i32);
+            return true;
+        case TYPE_I64:
+            value = uint64(data.data.i64);
+            return true;
+        default:
+            return false;
+    }
+}
+
 MySQLPreparedStatement::MySQLPreparedStatement(MYSQL_STMT* stmt) :
 m_stmt(NULL),
 m_Mstmt(stmt),
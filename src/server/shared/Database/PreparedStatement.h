@@ -94,6 +94,11 @@ class PreparedStatement
         void setString(const uint8 index, const std::string& value);
         void setNull(const uint8 index);
 
+        uint32 GetIndex() const { return m_index; }
+        uint8 GetParameterCount() const { return uint8(statement_data.size()); }
+        //- Value of an integer parameter, false if the parameter isn't bound to an integer
+        bool GetIntegerParameter(const uint8 index, uint64& value) const;
+
     protected:
         void BindParameters();
 
@@ -158,6 +163,7 @@ class PreparedStatementTask : public SQLOperation
         ~PreparedStatementTask();
 
         bool Execute();
+        uint32 GetStatementIndex() const { return m_stmt->GetIndex(); }
 
     protected:
         PreparedStatement* m_stmt;
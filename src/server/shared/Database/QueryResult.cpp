@@ -19,6 +19,39 @@
 #include "DatabaseEnv.h"
 #include "Log.h"
 
+namespace
+{
+    uint32 const NULL_VALUE_OFFSET = 0xFFFFFFFF;
+
+    /// Types whose values are stored with their actual length and a terminating zero
+    bool IsStringType(enum_field_types type)
+    {
+        switch (type)
+        {
+            case MYSQL_TYPE_TINY_BLOB:
+            case MYSQL_TYPE_MEDIUM_BLOB:
+            case MYSQL_TYPE_LONG_BLOB:
+            case MYSQL_TYPE_BLOB:
+            case MYSQL_TYPE_STRING:
+            case MYSQL_TYPE_VAR_STRING:
+            case MYSQL_TYPE_DECIMAL:
+            case MYSQL_TYPE_NEWDECIMAL:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /// Fixed size values are aligned to their size (at most 8) so Field can read them in place
+    size_t GetArenaAlignment(MYSQL_BIND const& bind)
+    {
+        if (IsStringType(bind.buffer_type) || bind.buffer_length <= 1)
+            return 1;
+
+        return bind.buffer_length >= 8 ? 8 : bind.buffer_length;
+    }
+}
+
 ResultSet::ResultSet(MYSQL_RES *result, MYSQL_FIELD *fields, uint64 rowCount, uint32 fieldCount) :
 _rowCount(rowCount),
 _fieldCount(fieldCount),
@@ -30,6 +63,7 @@ _fields(fields)
 }
 
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES *result, uint64 rowCount, uint32 fieldCount) :
+m_rows(NULL),
 m_rowCount(rowCount),
 m_rowPosition(0),
 m_fieldCount(fieldCount),
@@ -98,40 +132,61 @@ m_length(NULL)
 
     m_rowCount = mysql_stmt_num_rows(m_stmt);
 
-    m_rows.resize(uint32(m_rowCount));
+    //- Copy all rows into one arena. It grows while fetching, so offsets are kept
+    //- aside and the fields are pointed at their values once it is complete
+    uint32 fieldTotal = uint32(m_rowCount) * m_fieldCount;
+    m_rows = new Field[fieldTotal];
+    std::vector<uint32> offsets(fieldTotal, NULL_VALUE_OFFSET);
+
+    size_t fixedRowSize = 0;
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+        if (!IsStringType(m_rBind[i].buffer_type))
+            fixedRowSize += m_rBind[i].buffer_length;
+    m_arena.reserve(size_t(m_rowCount) * fixedRowSize);
+
     while (_NextRow())
     {
-        m_rows[uint32(m_rowPosition)] = new Field[m_fieldCount];
-        for (uint64 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+        uint32 rowIndex = uint32(m_rowPosition) * m_fieldCount;
+        for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            if (!*m_rBind[fIndex].is_null)
-                m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( m_rBind[fIndex].buffer,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
-            else
-                switch (m_rBind[fIndex].buffer_type)
-                {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( "",
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
-                    break;
-                    default:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( 0,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
-                }
+            MYSQL_BIND const& bind = m_rBind[fIndex];
+            bool isString = IsStringType(bind.buffer_type);
+            bool isNull = *bind.is_null;
+
+            // NULL numbers read as 0, NULL strings as empty strings
+            if (isNull && !isString)
+            {
+                m_rows[rowIndex + fIndex].SetByteValue(NULL, bind.buffer_type, 0);
+                continue;
+            }
+
+            uint32 length = isNull ? 0 : uint32(*bind.length);
+            size_t size = bind.buffer_length;
+            if (isString)
+            {
+                length = std::min<uint32>(length, uint32(bind.buffer_length) - 1);
+                size = length + 1;
+            }
+
+            size_t alignment = GetArenaAlignment(bind);
+            size_t offset = (m_arena.size() + alignment - 1) & ~(alignment - 1);
+            m_arena.resize(offset + size);
+            if (!isNull)
+                memcpy(&m_arena[offset], bind.buffer, isString ? length : size);
+            if (isString)
+                m_arena[offset + length] = '\0';
+
+            offsets[rowIndex + fIndex] = uint32(offset);
+            m_rows[rowIndex + fIndex].SetByteValue(NULL, bind.buffer_type, length);
         }
         m_rowPosition++;
     }
+
+    if (!m_arena.empty())
+        for (uint32 i = 0; i < fieldTotal; ++i)
+            if (offsets[i] != NULL_VALUE_OFFSET)
+                m_rows[i].data.value = &m_arena[offsets[i]];
+
     m_rowPosition = 0;
 
     /// All data is buffered, let go of mysql c api structures
@@ -145,8 +200,7 @@ ResultSet::~ResultSet()
 
 PreparedResultSet::~PreparedResultSet()
 {
-    for (uint32 i = 0; i < uint32(m_rowCount); ++i)
-        delete[] m_rows[i];
+    delete[] m_rows;
 }
 
 bool ResultSet::NextRow()
@@ -163,8 +217,9 @@ bool ResultSet::NextRow()
         return false;
     }
 
+    unsigned long* lengths = mysql_fetch_lengths(_result);
     for (uint32 i = 0; i < _fieldCount; i++)
-        _currentRow[i].SetStructuredValue(row[i], _fields[i].type);
+        _currentRow[i].SetStructuredValue(row[i], _fields[i].type, uint32(lengths[i]));
 
     return true;
 }
@@ -197,6 +252,66 @@ bool PreparedResultSet::_NextRow()
     return retval;
 }
 
+StreamedResultSet::StreamedResultSet(MySQLConnection* connection, MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount) :
+_connection(connection),
+_result(result),
+_fields(fields),
+_rowCount(0),
+_fieldCount(fieldCount)
+{
+    _currentRow = new Field[_fieldCount];
+}
+
+StreamedResultSet::~StreamedResultSet()
+{
+    CleanUp();
+}
+
+bool StreamedResultSet::NextRow()
+{
+    if (!_result)
+        return false;
+
+    MYSQL_ROW row = mysql_fetch_row(_result);
+    if (!row)
+    {
+        if (uint32 lErrno = mysql_errno(_connection->GetHandle()))
+            IC_LOG_ERROR("sql.sql", "[%u] %s, streamed result ended after " UI64FMTD " rows", lErrno, mysql_error(_connection->GetHandle()), _rowCount);
+
+        CleanUp();
+        return false;
+    }
+
+    unsigned long* lengths = mysql_fetch_lengths(_result);
+    for (uint32 i = 0; i < _fieldCount; ++i)
+        _currentRow[i].SetStructuredValue(row[i], _fields[i].type, uint32(lengths[i]));
+
+    ++_rowCount;
+    return true;
+}
+
+void StreamedResultSet::CleanUp()
+{
+    if (_currentRow)
+    {
+        delete [] _currentRow;
+        _currentRow = NULL;
+    }
+
+    if (_result)
+    {
+        // discards the rows not read yet
+        mysql_free_result(_result);
+        _result = NULL;
+    }
+
+    if (_connection)
+    {
+        _connection->Unlock();
+        _connection = NULL;
+    }
+}
+
 void ResultSet::CleanUp()
 {
     if (_currentRow)
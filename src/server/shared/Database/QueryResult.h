@@ -29,6 +29,8 @@
 #endif
 #include <mysql.h>
 
+class MySQLConnection;
+
 class ResultSet
 {
     public:
@@ -72,18 +74,19 @@ class PreparedResultSet
         Field* Fetch() const
         {
             ASSERT(m_rowPosition < m_rowCount);
-            return m_rows[uint32(m_rowPosition)];
+            return &m_rows[uint32(m_rowPosition) * m_fieldCount];
         }
 
         const Field & operator [] (uint32 index) const
         {
             ASSERT(m_rowPosition < m_rowCount);
             ASSERT(index < m_fieldCount);
-            return m_rows[uint32(m_rowPosition)][index];
+            return m_rows[uint32(m_rowPosition) * m_fieldCount + index];
         }
 
     protected:
-        std::vector<Field*> m_rows;
+        Field* m_rows;                                      // m_rowCount * m_fieldCount fields, row by row
+        std::vector<char> m_arena;                          // values of all fields, referenced by m_rows
         uint64 m_rowCount;
         uint64 m_rowPosition;
         uint32 m_fieldCount;
@@ -104,5 +107,43 @@ class PreparedResultSet
 
 typedef Infinity::AutoPtr<PreparedResultSet, ACE_Thread_Mutex> PreparedQueryResult;
 
+/**
+    Result of an ad hoc query read from the server row by row (mysql_use_result) instead
+    of being buffered as a whole, so only the current row is held in memory.
+
+    The connection the query ran on stays locked until the last row has been read or the
+    result is released. Fields are only valid until the next call to NextRow().
+*/
+class StreamedResultSet
+{
+    public:
+        StreamedResultSet(MySQLConnection* connection, MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount);
+        ~StreamedResultSet();
+
+        bool NextRow();
+        /// Rows read so far, the total is only known once NextRow() returned false
+        uint64 GetRowCount() const { return _rowCount; }
+        uint32 GetFieldCount() const { return _fieldCount; }
+
+        Field* Fetch() const { return _currentRow; }
+        const Field & operator [] (uint32 index) const
+        {
+            ASSERT(index < _fieldCount);
+            return _currentRow[index];
+        }
+
+    private:
+        void CleanUp();
+
+        MySQLConnection* _connection;
+        MYSQL_RES* _result;
+        MYSQL_FIELD* _fields;
+        Field* _currentRow;
+        uint64 _rowCount;
+        uint32 _fieldCount;
+};
+
+typedef Infinity::AutoPtr<StreamedResultSet, ACE_Thread_Mutex> StreamedQueryResult;
+
 #endif
 
@@ -22,6 +22,7 @@
 #include <ace/Activation_Queue.h>
 
 #include "QueryResult.h"
+#include "DatabaseStats.h"
 
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
@@ -59,7 +60,7 @@ class MySQLConnection;
 class SQLOperation : public ACE_Method_Request
 {
     public:
-        SQLOperation(): m_conn(NULL) { }
+        SQLOperation(): m_conn(NULL), m_queuedTime(0) { }
         virtual int call()
         {
             Execute();
@@ -67,8 +68,11 @@ class SQLOperation : public ACE_Method_Request
         }
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
+        //! Prepared statement the operation is accounted to in DatabaseStats
+        virtual uint32 GetStatementIndex() const { return DATABASE_STATS_ADHOC; }
 
         MySQLConnection* m_conn;
+        uint64 m_queuedTime;                                //! getUSTime() when enqueued, 0 if not measured
 };
 
 #endif
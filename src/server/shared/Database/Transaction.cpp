@@ -90,3 +90,69 @@ bool TransactionTask::Execute()
 
     return false;
 }
+
+WriteBatchTask::~WriteBatchTask()
+{
+    for (std::vector<WriteBatchElement>::iterator itr = m_elements.begin(); itr != m_elements.end(); ++itr)
+        delete itr->Statement;
+}
+
+size_t WriteBatchTask::Append(PreparedStatement* stmt)
+{
+    WriteBatchElement element;
+    element.Statement = stmt;
+    m_elements.push_back(element);
+    ++m_size;
+    return m_elements.size() - 1;
+}
+
+size_t WriteBatchTask::Append(SQLTransaction trans)
+{
+    WriteBatchElement element;
+    element.Trans = trans;
+    m_elements.push_back(element);
+    ++m_size;
+    return m_elements.size() - 1;
+}
+
+void WriteBatchTask::Remove(size_t pos)
+{
+    ASSERT(pos < m_elements.size() && m_elements[pos].Statement);
+
+    delete m_elements[pos].Statement;
+    m_elements[pos].Statement = NULL;
+    --m_size;
+}
+
+bool WriteBatchTask::Execute()
+{
+    // Nothing to gain from wrapping a single operation
+    if (m_size == 1)
+    {
+        for (std::vector<WriteBatchElement>::iterator itr = m_elements.begin(); itr != m_elements.end(); ++itr)
+            if (itr->Statement || !itr->Trans.null())
+                return ExecuteElement(*itr);
+    }
+
+    if (m_conn->ExecuteBatch(m_elements))
+        return true;
+
+    // A failing operation must not take the unrelated ones with it,
+    // run them one by one as they would have been without batching
+    bool success = true;
+    for (std::vector<WriteBatchElement>::iterator itr = m_elements.begin(); itr != m_elements.end(); ++itr)
+        if (itr->Statement || !itr->Trans.null())
+            success &= ExecuteElement(*itr);
+
+    return success;
+}
+
+bool WriteBatchTask::ExecuteElement(WriteBatchElement& element)
+{
+    if (element.Statement)
+        return m_conn->Execute(element.Statement);
+
+    TransactionTask task(element.Trans);
+    task.SetConnection(m_conn);
+    return task.Execute();
+}
@@ -57,6 +57,7 @@ class TransactionTask : public SQLOperation
 {
     template <class T> friend class DatabaseWorkerPool;
     friend class DatabaseWorker;
+    friend class WriteBatchTask;
 
     public:
         TransactionTask(SQLTransaction trans) : m_trans(trans) { } ;
@@ -68,4 +69,38 @@ class TransactionTask : public SQLOperation
         SQLTransaction m_trans;
 };
 
+//- One operation of a write batch, either a single statement or a whole transaction.
+//- Both are empty when the statement was replaced by a later one.
+struct WriteBatchElement
+{
+    WriteBatchElement() : Statement(NULL) { }
+
+    PreparedStatement* Statement;
+    SQLTransaction Trans;
+};
+
+/*! One-way operations executed in a single transaction, see DatabaseWorkerPool::SetWriteBatching */
+class WriteBatchTask : public SQLOperation
+{
+    public:
+        WriteBatchTask() : m_size(0) { }
+        ~WriteBatchTask();
+
+        //! Returns the position of the operation in the batch
+        size_t Append(PreparedStatement* stmt);
+        size_t Append(SQLTransaction trans);
+        //! Drops the statement at the given position
+        void Remove(size_t pos);
+
+        //! Operations still to be executed
+        size_t GetSize() const { return m_size; }
+
+    protected:
+        bool Execute();
+        bool ExecuteElement(WriteBatchElement& element);
+
+        std::vector<WriteBatchElement> m_elements;
+        size_t m_size;
+};
+
 #endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_DENSE_ID_MAP_H
+#define INFINITY_DENSE_ID_MAP_H
+
+#include "Define.h"
+#include <vector>
+
+/**
+    Map from small integer ids (spell ids, entries) to values, for tables filled at load
+    and only read afterwards.
+
+    Values are kept contiguously in insertion order and a slot array indexed by id holds
+    their position, so a lookup is two array reads instead of a hash or tree walk. The
+    slot array is as long as the highest id stored, keep it for ids bounded by a DBC.
+    Inserting may move the values, don't keep references across insertions.
+*/
+template<class T>
+class DenseIdMap
+{
+    typedef std::vector<T> Storage;
+
+    public:
+        typedef typename Storage::const_iterator const_iterator;
+
+        const_iterator begin() const { return _values.begin(); }
+        const_iterator end() const { return _values.end(); }
+        bool empty() const { return _values.empty(); }
+        size_t size() const { return _values.size(); }
+
+        void clear()
+        {
+            _slots.clear();
+            _values.clear();
+        }
+
+        T const* find(uint32 id) const
+        {
+            if (id >= _slots.size() || !_slots[id])
+                return NULL;
+
+            return &_values[_slots[id] - 1];
+        }
+
+        size_t count(uint32 id) const { return find(id) ? 1 : 0; }
+
+        T& operator[](uint32 id)
+        {
+            if (id >= _slots.size())
+                _slots.resize(id + 1, 0);
+
+            if (!_slots[id])
+            {
+                _values.push_back(T());
+                _slots[id] = uint32(_values.size());
+            }
+
+            return _values[_slots[id] - 1];
+        }
+
+    private:
+        std::vector<uint32> _slots;                         // position in _values + 1, 0 if the id is not stored
+        Storage _values;
+};
+
+#endif
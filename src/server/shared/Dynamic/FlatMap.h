@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_FLAT_MAP_H
+#define INFINITY_FLAT_MAP_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/**
+    Map with unique keys kept in one vector of pairs sorted by key.
+
+    Counterpart of FlatSet for small maps of trivially copyable keys and values:
+    no node allocation per element, ordered iteration over contiguous memory.
+    Inserting or erasing invalidates iterators, and the key of an element must
+    not be changed through a non-const iterator.
+*/
+template<class K, class V>
+class FlatMap
+{
+    typedef std::vector<std::pair<K, V> > Storage;
+
+    struct KeyLess
+    {
+        bool operator()(std::pair<K, V> const& left, K const& right) const { return left.first < right; }
+    };
+
+    public:
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef std::pair<K, V> value_type;
+        typedef typename Storage::iterator iterator;
+        typedef typename Storage::const_iterator const_iterator;
+
+        iterator begin() { return _values.begin(); }
+        iterator end() { return _values.end(); }
+        const_iterator begin() const { return _values.begin(); }
+        const_iterator end() const { return _values.end(); }
+        bool empty() const { return _values.empty(); }
+        size_t size() const { return _values.size(); }
+        void clear() { _values.clear(); }
+        void reserve(size_t count) { _values.reserve(count); }
+
+        iterator find(K const& key)
+        {
+            iterator itr = std::lower_bound(_values.begin(), _values.end(), key, KeyLess());
+            return itr != _values.end() && !(key < itr->first) ? itr : _values.end();
+        }
+
+        const_iterator find(K const& key) const
+        {
+            const_iterator itr = std::lower_bound(_values.begin(), _values.end(), key, KeyLess());
+            return itr != _values.end() && !(key < itr->first) ? itr : _values.end();
+        }
+
+        size_t count(K const& key) const { return find(key) != end() ? 1 : 0; }
+
+        V& operator[](K const& key)
+        {
+            iterator itr = std::lower_bound(_values.begin(), _values.end(), key, KeyLess());
+            if (itr == _values.end() || key < itr->first)
+                itr = _values.insert(itr, value_type(key, V()));
+
+            return itr->second;
+        }
+
+        size_t erase(K const& key)
+        {
+            iterator itr = find(key);
+            if (itr == _values.end())
+                return 0;
+
+            _values.erase(itr);
+            return 1;
+        }
+
+        void erase(iterator itr) { _values.erase(itr); }
+
+    private:
+        Storage _values;
+};
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_FLAT_SET_H
+#define INFINITY_FLAT_SET_H
+
+#include <algorithm>
+#include <vector>
+
+/**
+    Set of unique values kept in one sorted vector.
+
+    Lookups are binary searches over contiguous memory and copies are a single
+    allocation, which beats std::set for the small, frequently copied sets of
+    trivially copyable values (GUIDs) it is meant for. Insert and erase shift
+    the tail, so prefer erase_sorted() to remove many values at once.
+*/
+template<class T>
+class FlatSet
+{
+    typedef std::vector<T> Storage;
+
+    public:
+        typedef T value_type;
+        typedef typename Storage::const_iterator iterator;
+        typedef typename Storage::const_iterator const_iterator;
+
+        iterator begin() const { return _values.begin(); }
+        iterator end() const { return _values.end(); }
+        bool empty() const { return _values.empty(); }
+        size_t size() const { return _values.size(); }
+        void clear() { _values.clear(); }
+        void reserve(size_t count) { _values.reserve(count); }
+        void swap(FlatSet& other) { _values.swap(other._values); }
+
+        iterator find(T const& value) const
+        {
+            iterator itr = std::lower_bound(_values.begin(), _values.end(), value);
+            return itr != _values.end() && !(value < *itr) ? itr : _values.end();
+        }
+
+        size_t count(T const& value) const { return find(value) != end() ? 1 : 0; }
+
+        bool insert(T const& value)
+        {
+            typename Storage::iterator itr = std::lower_bound(_values.begin(), _values.end(), value);
+            if (itr != _values.end() && !(value < *itr))
+                return false;
+
+            _values.insert(itr, value);
+            return true;
+        }
+
+        size_t erase(T const& value)
+        {
+            typename Storage::iterator itr = std::lower_bound(_values.begin(), _values.end(), value);
+            if (itr == _values.end() || value < *itr)
+                return 0;
+
+            _values.erase(itr);
+            return 1;
+        }
+
+        //! Removes every value of the sorted range [first, last) in a single merge pass.
+        template<class Iterator>
+        void erase_sorted(Iterator first, Iterator last)
+        {
+            typename Storage::iterator out = _values.begin();
+            for (typename Storage::iterator itr = _values.begin(); itr != _values.end(); ++itr)
+            {
+                while (first != last && *first < *itr)
+                    ++first;
+
+                if (first != last && !(*itr < *first))
+                    continue;
+
+                *out++ = *itr;
+            }
+
+            _values.erase(out, _values.end());
+        }
+
+    private:
+        Storage _values;
+};
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_FREE_LIST_POOL_H
+#define INFINITY_FREE_LIST_POOL_H
+
+#include "Define.h"
+#include <ace/TSS_T.h>
+#include <new>
+
+/**
+    Per-thread cache of freed blocks sized for T, meant to back T::operator new/delete.
+
+    Objects that are created and destroyed at a high rate (auras, spell events) reuse
+    the blocks released on the same thread instead of going through the heap each time.
+    Every block is a separate ::operator new allocation, so a block may be released on
+    another thread than the one that allocated it. Each thread keeps at most MaxCached
+    blocks, the rest is returned to the heap; a thread's cache is freed when it exits.
+    Requests of another size (classes derived from T without their own pool) bypass it.
+*/
+template<class T, uint32 MaxCached = 512>
+class FreeListPool
+{
+    struct Block
+    {
+        Block* Next;
+    };
+
+    struct Cache
+    {
+        Cache() : Head(NULL), Count(0) { }
+
+        ~Cache()
+        {
+            while (Block* block = Head)
+            {
+                Head = block->Next;
+                ::operator delete(block);
+            }
+        }
+
+        Block* Head;
+        uint32 Count;
+    };
+
+    public:
+        static void* Allocate(size_t size)
+        {
+            if (size != sizeof(T))
+                return ::operator new(size);
+
+            Cache* cache = *_cache;
+            if (!cache)
+                return ::operator new(size);
+
+            if (Block* block = cache->Head)
+            {
+                cache->Head = block->Next;
+                --cache->Count;
+                return block;
+            }
+
+            return ::operator new(BlockSize);
+        }
+
+        static void Deallocate(void* ptr, size_t size)
+        {
+            if (!ptr)
+                return;
+
+            Cache* cache = size == sizeof(T) ? static_cast<Cache*>(*_cache) : NULL;
+            if (!cache || cache->Count >= MaxCached)
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            Block* block = static_cast<Block*>(ptr);
+            block->Next = cache->Head;
+            cache->Head = block;
+            ++cache->Count;
+        }
+
+    private:
+        static size_t const BlockSize = sizeof(T) < sizeof(Block) ? sizeof(Block) : sizeof(T);
+
+        // never destroyed, blocks may still be released during static destruction
+        static ACE_TSS<Cache>* _cache;
+};
+
+template<class T, uint32 MaxCached>
+ACE_TSS<typename FreeListPool<T, MaxCached>::Cache>* FreeListPool<T, MaxCached>::_cache = new ACE_TSS<typename FreeListPool<T, MaxCached>::Cache>();
+
+#endif
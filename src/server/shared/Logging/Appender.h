@@ -93,6 +93,8 @@ class Appender
 
         void setLogLevel(LogLevel);
         void write(LogMessage& message);
+        /// Writes out anything the appender holds back
+        virtual void Flush() { }
         static const char* getLogLevelString(LogLevel level);
 
     private:
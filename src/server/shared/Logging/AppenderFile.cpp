@@ -21,6 +21,8 @@
 # include <Windows.h>
 #endif
 
+#define APPENDER_FILE_MAX_PENDING   (64 * 1024)
+
 AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, const char* _filename, const char* _logDir, const char* _mode, AppenderFlags _flags, uint64 fileSize):
     Appender(id, name, APPENDER_FILE, level, _flags),
     logfile(NULL),
@@ -28,7 +30,8 @@ AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, co
     logDir(_logDir),
     mode(_mode),
     maxFileSize(fileSize),
-    fileSize(0)
+    fileSize(0),
+    _buffered(false)
 {
     dynamicName = std::string::npos != filename.find("%s");
     backup = (_flags & APPENDER_FLAGS_MAKE_FILE_BACKUP) != 0;
@@ -38,6 +41,7 @@ AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, co
 
 AppenderFile::~AppenderFile()
 {
+    Flush();
     CloseFile();
 }
 
@@ -52,19 +56,47 @@ void AppenderFile::_write(LogMessage const& message)
         logfile = OpenFile(namebuf, mode, backup || exceedMaxSize);
     }
     else if (exceedMaxSize)
+    {
+        Flush();
         logfile = OpenFile(filename, "w", true);
+    }
 
     if (!logfile)
         return;
 
-    fprintf(logfile, "%s%s", message.prefix.c_str(), message.text.c_str());
-    fflush(logfile);
+    if (_buffered && !dynamicName)
+    {
+        _pending.append(message.prefix);
+        _pending.append(message.text);
+        if (_pending.size() >= APPENDER_FILE_MAX_PENDING)
+            Flush();
+    }
+    else
+    {
+        fprintf(logfile, "%s%s", message.prefix.c_str(), message.text.c_str());
+        fflush(logfile);
+    }
+
     fileSize += uint64(message.Size());
 
     if (dynamicName)
         CloseFile();
 }
 
+void AppenderFile::Flush()
+{
+    if (_pending.empty())
+        return;
+
+    if (logfile)
+    {
+        fwrite(_pending.data(), 1, _pending.size(), logfile);
+        fflush(logfile);
+    }
+
+    _pending.clear();
+}
+
 FILE* AppenderFile::OpenFile(std::string const &filename, std::string const &mode, bool backup)
 {
     std::string fullName(logDir + filename);
@@ -28,6 +28,10 @@ class AppenderFile: public Appender
         ~AppenderFile();
         FILE* OpenFile(std::string const& _name, std::string const& _mode, bool _backup);
 
+        /// Buffered appenders collect messages until Flush instead of flushing the file per message
+        void SetBuffered(bool buffered) { _buffered = buffered; }
+        void Flush();
+
     private:
         void CloseFile();
         void _write(LogMessage const& message);
@@ -39,6 +43,8 @@ class AppenderFile: public Appender
         bool backup;
         uint64 maxFileSize;
         ACE_Atomic_Op<ACE_Thread_Mutex, uint64> fileSize;
+        bool _buffered;
+        std::string _pending;
 };
 
 #endif
@@ -23,13 +23,12 @@
 #include "AppenderConsole.h"
 #include "AppenderFile.h"
 #include "AppenderDB.h"
-#include "LogOperation.h"
 
 #include <cstdarg>
 #include <cstdio>
 #include <sstream>
 
-Log::Log() : worker(NULL)
+Log::Log() : writer(NULL), generation(1)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     LoadFromConfig();
@@ -142,7 +141,10 @@ void Log::CreateAppenderFromConfig(std::string const& appenderName)
                 maxFileSize = atoi(*iter++);
 
             uint8 id = NextAppenderId();
-            appenders[id] = new AppenderFile(id, name, level, filename.c_str(), m_logsDir.c_str(), mode.c_str(), flags, maxFileSize);
+            AppenderFile* appender = new AppenderFile(id, name, level, filename.c_str(), m_logsDir.c_str(), mode.c_str(), flags, maxFileSize);
+            // the writer thread flushes once per batch
+            appender->SetBuffered(writer != NULL);
+            appenders[id] = appender;
             //fprintf(stdout, "Log::CreateAppenderFromConfig: Created Appender %s (%u), Type FILE, Mask %u, File %s, Mode %s\n", name.c_str(), id, level, filename.c_str(), mode.c_str());
             break;
         }
@@ -264,16 +266,48 @@ void Log::vlog(std::string const& filter, LogLevel level, char const* str, va_li
 {
     char text[MAX_QUERY_LEN];
     vsnprintf(text, MAX_QUERY_LEN, str, argptr);
-    write(new LogMessage(level, filter, text));
+
+    Logger const* logger;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, siteLock);
+        logger = GetLoggerByType(filter);
+    }
+
+    write(logger, new LogMessage(level, filter, text));
 }
 
-void Log::write(LogMessage* msg)
+void Log::vlog(LogSite const& site, LogLevel level, char const* str, va_list argptr)
+{
+    Logger const* logger = site.CachedLogger;
+
+    // formatted by the writer thread
+    if (writer && writer->Write(logger, site, level, str, argptr))
+        return;
+
+    char text[MAX_QUERY_LEN];
+    vsnprintf(text, MAX_QUERY_LEN, str, argptr);
+
+    LogMessage msg(level, site.Filter, text);
+    msg.text.append("\n");
+    logger->write(msg);
+}
+
+Logger const* Log::ResolveSite(LogSite& site)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, siteLock, NULL);
+
+    Logger const* logger = GetLoggerByType(site.Filter);
+    site.CachedLogger = logger;
+    site.Generation = generation;
+    return logger;
+}
+
+void Log::write(Logger const* logger, LogMessage* msg)
 {
-    Logger const* logger = GetLoggerByType(msg->type);
     msg->text.append("\n");
 
-    if (worker)
-        worker->enqueue(new LogOperation(logger, msg));
+    if (writer)
+        writer->Write(logger, msg);
     else
     {
         logger->write(*msg);
@@ -328,7 +362,8 @@ bool Log::SetLogLevel(std::string const& name, const char* newLevelc, bool isLog
 
 void Log::outCharDump(char const* str, uint32 accountId, uint32 guid, char const* name)
 {
-    if (!str || !ShouldLog("entities.player.dump", LOG_LEVEL_INFO))
+    static LogSite logSite = { "entities.player.dump", NULL, 0 };
+    if (!str || !ShouldLog(logSite, LOG_LEVEL_INFO))
         return;
 
     std::ostringstream ss;
@@ -341,12 +376,13 @@ void Log::outCharDump(char const* str, uint32 accountId, uint32 guid, char const
 
     msg->param1 = param.str();
 
-    write(msg);
+    write(logSite.CachedLogger, msg);
 }
 
 void Log::outCommand(uint32 account, const char * str, ...)
 {
-    if (!str || !ShouldLog("commands.gm", LOG_LEVEL_INFO))
+    static LogSite logSite = { "commands.gm", NULL, 0 };
+    if (!str || !ShouldLog(logSite, LOG_LEVEL_INFO))
         return;
 
     va_list ap;
@@ -361,7 +397,7 @@ void Log::outCommand(uint32 account, const char * str, ...)
     ss << account;
     msg->param1 = ss.str();
 
-    write(msg);
+    write(logSite.CachedLogger, msg);
 }
 
 void Log::SetRealmId(uint32 id)
@@ -373,10 +409,17 @@ void Log::SetRealmId(uint32 id)
 
 void Log::Close()
 {
-    delete worker;
-    worker = NULL;
+    // drains everything already logged before the loggers go away
+    delete writer;
+    writer = NULL;
+
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, siteLock);
+        ++generation;
+        cachedLoggers.clear();
+    }
+
     loggers.clear();
-    cachedLoggers.clear();
     for (AppenderMap::iterator it = appenders.begin(); it != appenders.end(); ++it)
     {
         delete it->second;
@@ -390,7 +433,11 @@ void Log::LoadFromConfig()
     Close();
 
     if (sConfigMgr->GetBoolDefault("Log.Async.Enable", false))
-        worker = new LogWorker();
+    {
+        // per thread ring, KB
+        uint32 bufferSize = uint32(std::max(sConfigMgr->GetIntDefault("Log.Async.BufferSize", 256), 128));
+        writer = new LogWriter(bufferSize * 1024);
+    }
 
     AppenderId = 0;
     m_logsDir = sConfigMgr->GetStringDefault("LogsDir", "");
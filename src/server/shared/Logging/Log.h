@@ -22,7 +22,7 @@
 #include "Define.h"
 #include "Appender.h"
 #include "Logger.h"
-#include "LogWorker.h"
+#include "LogWriter.h"
 #include "Dynamic/UnorderedMap.h"
 
 #include <string>
@@ -44,10 +44,14 @@ class Log
     public:
         void LoadFromConfig();
         void Close();
+        /// Looks the logger up under a lock on every call, hot paths should use a LogSite instead
         bool ShouldLog(std::string const& type, LogLevel level);
+        /// Same as above but resolves the logger of the call site only once per configuration
+        bool ShouldLog(LogSite& site, LogLevel level);
         bool SetLogLevel(std::string const& name, char const* level, bool isLogger = true);
 
         void outMessage(std::string const& f, LogLevel level, char const* str, ...) ATTR_PRINTF(4, 5);
+        void outMessage(LogSite const& site, LogLevel level, char const* str, ...) ATTR_PRINTF(4, 5);
 
         void outCommand(uint32 account, const char * str, ...) ATTR_PRINTF(3, 4);
         void outCharDump(char const* str, uint32 account_id, uint32 guid, char const* name);
@@ -57,7 +61,9 @@ class Log
     private:
         static std::string GetTimestampStr();
         void vlog(std::string const& f, LogLevel level, char const* str, va_list argptr);
-        void write(LogMessage* msg);
+        void vlog(LogSite const& site, LogLevel level, char const* str, va_list argptr);
+        Logger const* ResolveSite(LogSite& site);
+        void write(Logger const* logger, LogMessage* msg);
 
         Logger const* GetLoggerByType(std::string const& type);
         Appender* GetAppenderByName(std::string const& name);
@@ -75,7 +81,9 @@ class Log
         std::string m_logsDir;
         std::string m_logsTimestamp;
 
-        LogWorker* worker;
+        LogWriter* writer;
+        ACE_Thread_Mutex siteLock;                          // guards cachedLoggers
+        volatile long generation;                           // bumped whenever loggers are destroyed
 };
 
 inline Logger const* Log::GetLoggerByType(std::string const& originalType)
@@ -103,17 +111,28 @@ inline Logger const* Log::GetLoggerByType(std::string const& originalType)
     }
     while (!logger);
 
-    cachedLoggers[type] = logger;
+    cachedLoggers[originalType] = logger;
     return logger;
 }
 
 inline bool Log::ShouldLog(std::string const& type, LogLevel level)
 {
-    // TODO: Use cache to store "Type.sub1.sub2": "Type" equivalence, should
-    // Speed up in cases where requesting "Type.sub1.sub2" but only configured
-    // Logger "Type"
+    Logger const* logger;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, siteLock, false);
+        logger = GetLoggerByType(type);
+    }
+
+    if (!logger)
+        return false;
+
+    LogLevel logLevel = logger->getLogLevel();
+    return logLevel != LOG_LEVEL_DISABLED && logLevel <= level;
+}
 
-    Logger const* logger = GetLoggerByType(type);
+inline bool Log::ShouldLog(LogSite& site, LogLevel level)
+{
+    Logger const* logger = site.Generation == generation ? site.CachedLogger : ResolveSite(site);
     if (!logger)
         return false;
 
@@ -131,21 +150,33 @@ inline void Log::outMessage(std::string const& filter, LogLevel level, const cha
     va_end(ap);
 }
 
+inline void Log::outMessage(LogSite const& site, LogLevel level, const char * str, ...)
+{
+    va_list ap;
+    va_start(ap, str);
+
+    vlog(site, level, str, ap);
+
+    va_end(ap);
+}
+
 #define sLog ACE_Singleton<Log, ACE_Thread_Mutex>::instance()
 
 #if PLATFORM != PLATFORM_WINDOWS
 #define IC_LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
-                sLog->outMessage(filterType__, level__, __VA_ARGS__);   \
+            static LogSite logSite__ = { filterType__, NULL, 0 };       \
+            if (sLog->ShouldLog(logSite__, level__))                    \
+                sLog->outMessage(logSite__, level__, __VA_ARGS__);      \
         } while (0)
 #else
 #define IC_LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         __pragma(warning(push))                                         \
         __pragma(warning(disable:4127))                                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
-                sLog->outMessage(filterType__, level__, __VA_ARGS__);   \
+            static LogSite logSite__ = { filterType__, NULL, 0 };       \
+            if (sLog->ShouldLog(logSite__, level__))                    \
+                sLog->outMessage(logSite__, level__, __VA_ARGS__);      \
         } while (0)                                                     \
         __pragma(warning(pop))
 #endif
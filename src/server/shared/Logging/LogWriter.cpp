@@ -0,0 +1,763 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LogWriter.h"
+#include "Common.h"
+#include "Logger.h"
+#include <ace/OS_NS_Thread.h>
+#include <ace/OS_NS_unistd.h>
+#include <algorithm>
+#include <cctype>
+
+#ifndef va_copy
+#define va_copy(dest, src) ((dest) = (src))
+#endif
+
+namespace
+{
+    uint32 const LOG_WRITER_IDLE_SLEEP = 5;                 // milliseconds between polls of empty rings
+
+    enum LogRecordType
+    {
+        LOG_RECORD_FORMAT,                                  // format string followed by the captured arguments
+        LOG_RECORD_TEXT                                     // text formatted by the caller
+    };
+
+    struct LogRecord
+    {
+        uint32 Size;                                        // whole record, 0 marks the unused end of the ring
+        uint8 Level;
+        uint8 Type;
+        Logger const* Target;
+        LogSite const* Site;
+        time_t Time;
+    };
+
+    inline uint32 AlignRecordSize(size_t size)
+    {
+        return uint32((size + 7) & ~size_t(7));
+    }
+
+    enum LogArgType
+    {
+        LOG_ARG_INVALID,                                    // conversion we can't capture, the caller formats the message
+        LOG_ARG_INT,
+        LOG_ARG_LONG,
+        LOG_ARG_LONG_LONG,
+        LOG_ARG_SIZE,
+        LOG_ARG_PTRDIFF,
+        LOG_ARG_INTMAX,
+        LOG_ARG_DOUBLE,
+        LOG_ARG_LONG_DOUBLE,
+        LOG_ARG_STRING,
+        LOG_ARG_POINTER
+    };
+
+    enum LogArgLength
+    {
+        LOG_LENGTH_NONE,
+        LOG_LENGTH_LONG,
+        LOG_LENGTH_LONG_LONG,
+        LOG_LENGTH_SIZE,
+        LOG_LENGTH_PTRDIFF,
+        LOG_LENGTH_INTMAX,
+        LOG_LENGTH_LONG_DOUBLE
+    };
+
+    uint32 const LOG_MAX_SPEC_LENGTH = 31;
+
+    struct LogFormatSpec
+    {
+        char const* Start;                                  // the '%'
+        uint32 Length;
+        uint8 Stars;                                        // '*' width and precision, each takes an int argument
+        bool StarPrecision;                                 // the precision is the last '*' argument
+        int Precision;                                      // literal precision, -1 if none
+        LogArgType Type;
+    };
+
+    /// Parses the conversion starting at p (a '%' not followed by another '%'), returns the first character after it
+    char const* ParseSpec(char const* p, LogFormatSpec& spec)
+    {
+        spec.Start = p++;
+        spec.Stars = 0;
+        spec.StarPrecision = false;
+        spec.Precision = -1;
+        spec.Type = LOG_ARG_INVALID;
+        spec.Length = 0;
+
+        while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0' || *p == '\'')
+            ++p;
+
+        if (*p == '*')
+        {
+            ++spec.Stars;
+            ++p;
+        }
+        else
+            while (isdigit(uint8(*p)))
+                ++p;
+
+        if (*p == '.')
+        {
+            ++p;
+            if (*p == '*')
+            {
+                ++spec.Stars;
+                spec.StarPrecision = true;
+                ++p;
+            }
+            else
+            {
+                spec.Precision = 0;
+                while (isdigit(uint8(*p)))
+                {
+                    if (spec.Precision < 100000000)
+                        spec.Precision = spec.Precision * 10 + (*p - '0');
+                    ++p;
+                }
+            }
+        }
+
+        LogArgLength length = LOG_LENGTH_NONE;
+        switch (*p)
+        {
+            case 'h':
+                if (*++p == 'h')
+                    ++p;
+                break;
+            case 'l':
+                if (*++p == 'l')
+                {
+                    ++p;
+                    length = LOG_LENGTH_LONG_LONG;
+                }
+                else
+                    length = LOG_LENGTH_LONG;
+                break;
+            case 'q':
+                ++p;
+                length = LOG_LENGTH_LONG_LONG;
+                break;
+            case 'L':
+                ++p;
+                length = LOG_LENGTH_LONG_DOUBLE;
+                break;
+            case 'j':
+                ++p;
+                length = LOG_LENGTH_INTMAX;
+                break;
+            case 'z':
+                ++p;
+                length = LOG_LENGTH_SIZE;
+                break;
+            case 't':
+                ++p;
+                length = LOG_LENGTH_PTRDIFF;
+                break;
+            case 'I':                                       // MSVC: I64, I32 and I (size_t)
+                if (p[1] == '6' && p[2] == '4')
+                {
+                    p += 3;
+                    length = LOG_LENGTH_LONG_LONG;
+                }
+                else if (p[1] == '3' && p[2] == '2')
+                    p += 3;
+                else
+                {
+                    ++p;
+                    length = LOG_LENGTH_SIZE;
+                }
+                break;
+            default:
+                break;
+        }
+
+        char conversion = *p;
+        if (!conversion)
+            return p;
+        ++p;
+
+        switch (conversion)
+        {
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+                switch (length)
+                {
+                    case LOG_LENGTH_NONE:       spec.Type = LOG_ARG_INT; break;
+                    case LOG_LENGTH_LONG:       spec.Type = conversion == 'c' ? LOG_ARG_INVALID : LOG_ARG_LONG; break;
+                    case LOG_LENGTH_LONG_LONG:  spec.Type = LOG_ARG_LONG_LONG; break;
+                    case LOG_LENGTH_SIZE:       spec.Type = LOG_ARG_SIZE; break;
+                    case LOG_LENGTH_PTRDIFF:    spec.Type = LOG_ARG_PTRDIFF; break;
+                    case LOG_LENGTH_INTMAX:     spec.Type = LOG_ARG_INTMAX; break;
+                    default:                    break;
+                }
+                break;
+            case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+                spec.Type = length == LOG_LENGTH_LONG_DOUBLE ? LOG_ARG_LONG_DOUBLE : LOG_ARG_DOUBLE;
+                break;
+            case 's':
+                if (length == LOG_LENGTH_NONE)
+                    spec.Type = LOG_ARG_STRING;
+                break;
+            case 'p':
+                spec.Type = LOG_ARG_POINTER;
+                break;
+            default:                                        // %n, wide characters and unknown conversions
+                break;
+        }
+
+        spec.Length = uint32(p - spec.Start);
+        if (spec.Length > LOG_MAX_SPEC_LENGTH)
+            spec.Type = LOG_ARG_INVALID;
+
+        return p;
+    }
+
+    template<class T>
+    inline void PutArg(char*& out, T value)
+    {
+        memcpy(out, &value, sizeof(T));
+        out += sizeof(T);
+    }
+
+    template<class T>
+    inline T GetArg(char const*& in)
+    {
+        T value;
+        memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return value;
+    }
+
+    /// Walks the arguments of format, returns the bytes needed to capture them or -1 if they can't be captured.
+    /// With out set the arguments are also copied there.
+    int64 CaptureArguments(char const* format, va_list args, char* out)
+    {
+        int64 size = 0;
+        for (char const* p = format; *p;)
+        {
+            if (*p != '%')
+            {
+                ++p;
+                continue;
+            }
+
+            if (p[1] == '%')
+            {
+                p += 2;
+                continue;
+            }
+
+            LogFormatSpec spec;
+            p = ParseSpec(p, spec);
+            if (spec.Type == LOG_ARG_INVALID)
+                return -1;
+
+            int precision = spec.Precision;
+            for (uint8 i = 0; i < spec.Stars; ++i)
+            {
+                int star = va_arg(args, int);
+                if (out)
+                    PutArg(out, star);
+                size += sizeof(int);
+                if (spec.StarPrecision && i + 1 == spec.Stars)
+                    precision = star;                       // a negative precision is taken as if omitted
+            }
+
+            switch (spec.Type)
+            {
+                case LOG_ARG_INT:
+                {
+                    int value = va_arg(args, int);
+                    if (out)
+                        PutArg(out, value);
+                    size += sizeof(value);
+                    break;
+                }
+                case LOG_ARG_LONG:
+                {
+                    long value = va_arg(args, long);
+                    if (out)
+                        PutArg(out, value);
+                    size += sizeof(value);
+                    break;
+                }
+                case LOG_ARG_LONG_LONG:
+                {
+                    long long value = va_arg(args, long long);
+                    if (out)
+                        PutArg(out, value);
+                    size += sizeof(value);
+                    break;
+                }
+                case LOG_ARG_SIZE:
+                {
+                    size_t value = va_arg(args, size_t);
+                    if (out)
+                        PutArg(out, value);
+                    size += sizeof(value);
+                    break;
+                }
+                case LOG_ARG_PTRDIFF:
+                {
+                    ptrdiff_t value = va_arg(args, ptrdiff_t);
+                    if (out)
+                        PutArg(out, value);
+                    size += sizeof(value);
+                    break;
+                }
+                case LOG_ARG_INTMAX:
+                {
+                    intmax_t value = va_arg(args, intmax_t);
+                    if (out)
+                        PutArg(out, value);
+                    size += sizeof(value);
+                    break;
+                }
+                case LOG_ARG_DOUBLE:
+                {
+                    double value = va_arg(args, double);
+                    if (out)
+                        PutArg(out, value);
+                    size += sizeof(value);
+                    break;
+                }
+                case LOG_ARG_LONG_DOUBLE:
+                {
+                    long double value = va_arg(args, long double);
+                    if (out)
+                        PutArg(out, value);
+                    size += sizeof(value);
+                    break;
+                }
+                case LOG_ARG_POINTER:
+                {
+                    void* value = va_arg(args, void*);
+                    if (out)
+                        PutArg(out, value);
+                    size += sizeof(value);
+                    break;
+                }
+                case LOG_ARG_STRING:
+                {
+                    char const* value = va_arg(args, char const*);
+                    if (!value)
+                        value = "(null)";
+
+                    // with a precision the argument doesn't need to be NUL terminated, never read past it
+                    size_t length;
+                    if (precision >= 0)
+                    {
+                        char const* end = static_cast<char const*>(memchr(value, '\0', size_t(precision)));
+                        length = end ? size_t(end - value) : size_t(precision);
+                    }
+                    else
+                        length = strlen(value);
+
+                    if (out)
+                    {
+                        memcpy(out, value, length);
+                        out[length] = '\0';
+                        out += length + 1;
+                    }
+                    size += length + 1;
+                    break;
+                }
+                default:
+                    return -1;
+            }
+        }
+
+        return size;
+    }
+
+    template<class T>
+    int FormatArg(char* out, size_t size, char const* spec, uint8 stars, int const* starValues, T value)
+    {
+        switch (stars)
+        {
+            case 0:
+                return snprintf(out, size, spec, value);
+            case 1:
+                return snprintf(out, size, spec, starValues[0], value);
+            default:
+                return snprintf(out, size, spec, starValues[0], starValues[1], value);
+        }
+    }
+
+    /// Formats a message from its format string and the arguments stored by CaptureArguments
+    void FormatArguments(char const* format, char const* args, char* out, size_t size)
+    {
+        size_t length = 0;
+        char const* p = format;
+        while (*p && length + 1 < size)
+        {
+            if (*p != '%')
+            {
+                out[length++] = *p++;
+                continue;
+            }
+
+            if (p[1] == '%')
+            {
+                out[length++] = '%';
+                p += 2;
+                continue;
+            }
+
+            LogFormatSpec spec;
+            p = ParseSpec(p, spec);
+
+            char specText[LOG_MAX_SPEC_LENGTH + 1];
+            memcpy(specText, spec.Start, spec.Length);
+            specText[spec.Length] = '\0';
+
+            int starValues[2] = { 0, 0 };
+            for (uint8 i = 0; i < spec.Stars; ++i)
+                starValues[i] = GetArg<int>(args);
+
+            char* target = out + length;
+            size_t room = size - length;
+            int written = 0;
+            switch (spec.Type)
+            {
+                case LOG_ARG_INT:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, GetArg<int>(args));
+                    break;
+                case LOG_ARG_LONG:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, GetArg<long>(args));
+                    break;
+                case LOG_ARG_LONG_LONG:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, GetArg<long long>(args));
+                    break;
+                case LOG_ARG_SIZE:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, GetArg<size_t>(args));
+                    break;
+                case LOG_ARG_PTRDIFF:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, GetArg<ptrdiff_t>(args));
+                    break;
+                case LOG_ARG_INTMAX:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, GetArg<intmax_t>(args));
+                    break;
+                case LOG_ARG_DOUBLE:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, GetArg<double>(args));
+                    break;
+                case LOG_ARG_LONG_DOUBLE:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, GetArg<long double>(args));
+                    break;
+                case LOG_ARG_POINTER:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, GetArg<void*>(args));
+                    break;
+                case LOG_ARG_STRING:
+                    written = FormatArg(target, room, specText, spec.Stars, starValues, args);
+                    args += strlen(args) + 1;
+                    break;
+                default:
+                    break;
+            }
+
+            if (written > 0)
+                length += std::min(size_t(written), room - 1);
+        }
+
+        out[length] = '\0';
+    }
+}
+
+LogRingBuffer::LogRingBuffer(uint32 capacity) : _data(NULL), _capacity(8192), _head(0), _reservedHead(0), _cachedTail(0),
+    _tail(0), _readPos(0), _readEnd(0), _released(false)
+{
+    while (_capacity < capacity)
+        _capacity <<= 1;
+
+    _data = new char[_capacity];
+}
+
+LogRingBuffer::~LogRingBuffer()
+{
+    delete[] _data;
+}
+
+char* LogRingBuffer::Reserve(uint32 size)
+{
+    unsigned long head = _head.value();
+    uint32 offset = uint32(head & (_capacity - 1));
+    uint32 contiguous = _capacity - offset;
+    uint32 needed = size <= contiguous ? size : contiguous + size;
+
+    while (head + needed - _cachedTail > _capacity)
+    {
+        // atomic add of 0 reads the consumer position with a full barrier
+        _cachedTail = (_tail += 0);
+        if (head + needed - _cachedTail > _capacity)
+            ACE_OS::sleep(ACE_Time_Value(0, 1000));         // ring full, wait for the writer
+    }
+
+    if (size > contiguous)
+    {
+        // too close to the end, the record starts over at the beginning of the ring
+        *reinterpret_cast<uint32*>(_data + offset) = 0;
+        head += contiguous;
+        offset = 0;
+    }
+
+    _reservedHead = head + size;
+    return _data + offset;
+}
+
+void LogRingBuffer::Commit()
+{
+    _head = _reservedHead;
+}
+
+char const* LogRingBuffer::Next()
+{
+    if (_readPos == _readEnd)
+    {
+        _readEnd = (_head += 0);
+        if (_readPos == _readEnd)
+            return NULL;
+    }
+
+    uint32 offset = uint32(_readPos & (_capacity - 1));
+    uint32 size = *reinterpret_cast<uint32 const*>(_data + offset);
+    if (!size)
+    {
+        _readPos += _capacity - offset;
+        return Next();
+    }
+
+    _readPos += size;
+    return _data + offset;
+}
+
+void LogRingBuffer::EndRead()
+{
+    _tail = _readPos;
+}
+
+bool LogRingBuffer::IsEmpty()
+{
+    return _readPos == (_head += 0);
+}
+
+LogWriter::LogWriter(uint32 bufferSize) : _bufferSize(bufferSize), _stop(false), _writerThread(ACE_OS::NULL_thread),
+    _message(LOG_LEVEL_DISABLED, "", ""), _text(MAX_QUERY_LEN)
+{
+    ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1);
+}
+
+LogWriter::~LogWriter()
+{
+    _stop = true;
+    wait();
+
+    for (std::vector<LogRingBuffer*>::iterator itr = _buffers.begin(); itr != _buffers.end(); ++itr)
+        delete *itr;
+
+    for (LogMessageQueue::iterator itr = _queue.begin(); itr != _queue.end(); ++itr)
+        delete itr->second;
+}
+
+LogRingBuffer* LogWriter::GetThreadBuffer()
+{
+    ThreadSlot* slot = _slot.ts_object();
+    if (!slot)
+    {
+        slot = new ThreadSlot();
+        _slot.ts_object(slot);
+    }
+
+    if (!slot->Buffer)
+    {
+        slot->Buffer = new LogRingBuffer(_bufferSize);
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, slot->Buffer);
+        _buffers.push_back(slot->Buffer);
+    }
+
+    return slot->Buffer;
+}
+
+bool LogWriter::Write(Logger const* logger, LogSite const& site, LogLevel level, char const* format, va_list args)
+{
+    if (ACE_OS::thr_equal(ACE_OS::thr_self(), _writerThread))
+        return false;
+
+    LogRingBuffer* buffer = GetThreadBuffer();
+
+    va_list sizeArgs;
+    va_copy(sizeArgs, args);
+    int64 argsSize = CaptureArguments(format, sizeArgs, NULL);
+    va_end(sizeArgs);
+
+    size_t formatSize = strlen(format) + 1;
+    if (argsSize < 0 || sizeof(LogRecord) + formatSize + argsSize > buffer->GetMaxRecordSize())
+        return WriteText(buffer, logger, site, level, format, args);
+
+    uint32 size = AlignRecordSize(sizeof(LogRecord) + formatSize + size_t(argsSize));
+    char* data = buffer->Reserve(size);
+
+    LogRecord* record = reinterpret_cast<LogRecord*>(data);
+    record->Size = size;
+    record->Level = uint8(level);
+    record->Type = LOG_RECORD_FORMAT;
+    record->Target = logger;
+    record->Site = &site;
+    record->Time = time(NULL);
+
+    char* payload = data + sizeof(LogRecord);
+    memcpy(payload, format, formatSize);
+
+    va_list captureArgs;
+    va_copy(captureArgs, args);
+    CaptureArguments(format, captureArgs, payload + formatSize);
+    va_end(captureArgs);
+
+    buffer->Commit();
+    return true;
+}
+
+bool LogWriter::WriteText(LogRingBuffer* buffer, Logger const* logger, LogSite const& site, LogLevel level, char const* format, va_list args)
+{
+    char text[MAX_QUERY_LEN];
+    va_list textArgs;
+    va_copy(textArgs, args);
+    vsnprintf(text, MAX_QUERY_LEN, format, textArgs);
+    va_end(textArgs);
+
+    size_t textSize = strlen(text) + 1;
+    uint32 size = AlignRecordSize(sizeof(LogRecord) + textSize);
+    char* data = buffer->Reserve(size);
+
+    LogRecord* record = reinterpret_cast<LogRecord*>(data);
+    record->Size = size;
+    record->Level = uint8(level);
+    record->Type = LOG_RECORD_TEXT;
+    record->Target = logger;
+    record->Site = &site;
+    record->Time = time(NULL);
+    memcpy(data + sizeof(LogRecord), text, textSize);
+
+    buffer->Commit();
+    return true;
+}
+
+void LogWriter::Write(Logger const* logger, LogMessage* message)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    _queue.push_back(std::make_pair(logger, message));
+}
+
+int LogWriter::svc()
+{
+    _writerThread = ACE_OS::thr_self();
+
+    while (true)
+    {
+        bool stop = _stop;
+        uint32 written = Drain();
+
+        // the last pass started after the stop request, nothing queued before it is lost
+        if (stop)
+            break;
+
+        if (!written)
+            ACE_OS::sleep(ACE_Time_Value(0, LOG_WRITER_IDLE_SLEEP * 1000));
+    }
+
+    return 0;
+}
+
+uint32 LogWriter::Drain()
+{
+    std::vector<LogRingBuffer*> buffers;
+    LogMessageQueue queue;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, 0);
+        buffers = _buffers;
+        queue.swap(_queue);
+    }
+
+    uint32 written = 0;
+    for (std::vector<LogRingBuffer*>::const_iterator itr = buffers.begin(); itr != buffers.end(); ++itr)
+    {
+        while (char const* record = (*itr)->Next())
+        {
+            WriteRecord(record);
+            ++written;
+        }
+
+        (*itr)->EndRead();
+    }
+
+    for (LogMessageQueue::iterator itr = queue.begin(); itr != queue.end(); ++itr)
+    {
+        itr->first->write(*itr->second);
+        delete itr->second;
+
+        if (std::find(_batchLoggers.begin(), _batchLoggers.end(), itr->first) == _batchLoggers.end())
+            _batchLoggers.push_back(itr->first);
+        ++written;
+    }
+
+    // one write per file and batch
+    for (std::vector<Logger const*>::const_iterator itr = _batchLoggers.begin(); itr != _batchLoggers.end(); ++itr)
+        (*itr)->flush();
+    _batchLoggers.clear();
+
+    // rings of exited threads
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, written);
+    for (std::vector<LogRingBuffer*>::iterator itr = _buffers.begin(); itr != _buffers.end();)
+    {
+        if ((*itr)->IsReleased() && (*itr)->IsEmpty())
+        {
+            delete *itr;
+            itr = _buffers.erase(itr);
+        }
+        else
+            ++itr;
+    }
+
+    return written;
+}
+
+void LogWriter::WriteRecord(char const* data)
+{
+    LogRecord const* record = reinterpret_cast<LogRecord const*>(data);
+    char const* payload = data + sizeof(LogRecord);
+
+    _message.level = LogLevel(record->Level);
+    _message.type.assign(record->Site->Filter);
+    _message.mtime = record->Time;
+    _message.param1.clear();
+
+    if (record->Type == LOG_RECORD_TEXT)
+        _message.text.assign(payload);
+    else
+    {
+        FormatArguments(payload, payload + strlen(payload) + 1, &_text[0], _text.size());
+        _message.text.assign(&_text[0]);
+    }
+
+    _message.text.push_back('\n');
+    record->Target->write(_message);
+
+    if (std::find(_batchLoggers.begin(), _batchLoggers.end(), record->Target) == _batchLoggers.end())
+        _batchLoggers.push_back(record->Target);
+}
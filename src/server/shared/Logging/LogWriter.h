@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_LOGWRITER_H
+#define INFINITY_LOGWRITER_H
+
+#include "Appender.h"
+#include <ace/Atomic_Op.h>
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+#include <cstdarg>
+#include <deque>
+#include <vector>
+
+class Logger;
+
+/// Call site of a log macro. Static aggregate so it needs no guarded initialization,
+/// caches the logger its filter resolves to until the log configuration is reloaded.
+struct LogSite
+{
+    char const* Filter;                                     // string literal
+    Logger const* volatile CachedLogger;
+    volatile long Generation;                               // Log generation CachedLogger belongs to, 0 if never resolved
+};
+
+/**
+    Single producer, single consumer byte ring holding the records of one thread.
+
+    The owning thread reserves and commits whole records, the writer thread reads them in
+    batches and frees the space once a batch is written. Positions only grow, the capacity
+    is a power of two so they may wrap around. Every record starts with its uint32 size,
+    a multiple of 8; the size 0 is reserved for marking the unused end of the ring.
+*/
+class LogRingBuffer
+{
+    public:
+        explicit LogRingBuffer(uint32 capacity);
+        ~LogRingBuffer();
+
+        /// Largest record that is guaranteed to fit
+        uint32 GetMaxRecordSize() const { return _capacity / 2; }
+
+        /// Producer: contiguous space for a record of size bytes (multiple of 8), waits while the ring is full
+        char* Reserve(uint32 size);
+        /// Producer: publishes the record returned by the last Reserve
+        void Commit();
+
+        /// Consumer: records committed since the last EndRead, NULL once all of them were returned
+        char const* Next();
+        /// Consumer: hands the space of the returned records back to the producer
+        void EndRead();
+        bool IsEmpty();
+
+        /// Called when the owning thread exits, the writer frees the ring once it is empty
+        void Release() { _released = true; }
+        bool IsReleased() const { return _released; }
+
+    private:
+        LogRingBuffer(LogRingBuffer const&);
+        LogRingBuffer& operator=(LogRingBuffer const&);
+
+        char* _data;
+        uint32 _capacity;
+
+        // written by the producer only
+        ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> _head;
+        unsigned long _reservedHead;
+        unsigned long _cachedTail;
+
+        // written by the consumer only
+        ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> _tail;
+        unsigned long _readPos;
+        unsigned long _readEnd;
+
+        volatile bool _released;
+};
+
+/**
+    Background writer of the asynchronous logging mode (Log.Async.Enable).
+
+    A logging thread copies the format string and the raw printf arguments into its own
+    LogRingBuffer, without taking a lock or allocating memory; strings are copied, so
+    arguments may die right after the call. Formatting and the appenders run on the writer
+    thread, which drains all rings in batches and flushes the file appenders once per batch.
+    Messages of different threads are written in drain order, not strictly by time.
+*/
+class LogWriter : protected ACE_Task_Base
+{
+    struct ThreadSlot
+    {
+        ThreadSlot() : Buffer(NULL) { }
+        ~ThreadSlot() { if (Buffer) Buffer->Release(); }
+
+        LogRingBuffer* Buffer;                              // owned by LogWriter, outlives the thread
+    };
+
+    typedef std::deque<std::pair<Logger const*, LogMessage*> > LogMessageQueue;
+
+    public:
+        explicit LogWriter(uint32 bufferSize);
+        ~LogWriter();
+
+        /// Captures a printf style message into the calling thread's ring.
+        /// Returns false if the message must be written synchronously instead (called by the writer itself).
+        bool Write(Logger const* logger, LogSite const& site, LogLevel level, char const* format, va_list args);
+        /// Queues a prebuilt message (extra parameters, dumps), takes ownership of it
+        void Write(Logger const* logger, LogMessage* message);
+
+    private:
+        int svc();
+
+        LogRingBuffer* GetThreadBuffer();
+        bool WriteText(LogRingBuffer* buffer, Logger const* logger, LogSite const& site, LogLevel level, char const* format, va_list args);
+        uint32 Drain();
+        void WriteRecord(char const* record);
+
+        uint32 _bufferSize;
+        ACE_TSS<ThreadSlot> _slot;
+        std::vector<LogRingBuffer*> _buffers;
+        LogMessageQueue _queue;
+        ACE_Thread_Mutex _lock;                             // guards _buffers and _queue, taken once per thread by writers
+
+        volatile bool _stop;
+        ACE_thread_t _writerThread;
+
+        // writer thread only
+        LogMessage _message;
+        std::vector<Logger const*> _batchLoggers;           // loggers to flush after the batch
+        std::vector<char> _text;                            // formatting buffer
+};
+
+#endif
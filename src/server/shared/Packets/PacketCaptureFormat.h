@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_PACKETCAPTUREFORMAT_H
+#define INFINITY_PACKETCAPTUREFORMAT_H
+
+#include "Define.h"
+
+/**
+    Layout of the packet capture ring file (PacketLog.Capture.Size), shared with the
+    packetconverter tool.
+
+    The file is a PacketCaptureHeader followed by Capacity bytes used as a ring. Head and
+    Tail are byte positions that only grow; a record lives at HeaderSize + position % Capacity.
+    The records between Tail and Head are complete, older ones have been overwritten.
+    All fields are little endian, records are 8 byte aligned.
+*/
+
+#define PACKET_CAPTURE_MAGIC    0x43504349                  // "ICPC"
+#define PACKET_CAPTURE_VERSION  1
+
+struct PacketCaptureHeader
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 HeaderSize;                                      // sizeof(PacketCaptureHeader) of the writer
+    uint32 Reserved;
+    uint64 Capacity;                                        // size of the ring, bytes
+    uint64 Head;                                            // end of the newest record
+    uint64 Tail;                                            // start of the oldest record
+    uint64 StartTime;                                       // unix time the capture was started
+    uint64 Records;                                         // packets written since the start
+    uint64 Dropped;                                         // packets too large for the capture
+};
+
+struct PacketCaptureRecord
+{
+    uint32 Size;                                            // whole record with payload and padding, 0 marks the unused end of the ring
+    uint32 Opcode;
+    uint32 Length;                                          // payload bytes following the record
+    uint32 ConnectionId;                                    // world socket, unique for the capture
+    uint32 AccountId;                                       // 0 before the session is authenticated
+    uint8 Direction;                                        // Direction from PacketLog.h
+    uint8 Reserved[3];
+    uint64 Time;                                            // microseconds since the unix epoch
+};
+
+inline uint32 GetPacketCaptureRecordSize(uint32 length)
+{
+    return uint32((sizeof(PacketCaptureRecord) + length + 7) & ~size_t(7));
+}
+
+#endif
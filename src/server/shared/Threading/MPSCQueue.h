@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include "CompilerDefs.h"
+
+#if COMPILER_HAS_CPP11_SUPPORT
+#  include <atomic>
+#elif COMPILER == COMPILER_MICROSOFT
+#  include <intrin.h>
+#  pragma intrinsic(_InterlockedExchangePointer, _ReadWriteBarrier)
+#endif
+
+#include <cstddef>
+
+/**
+    Unbounded lock-free multi-producer / single-consumer queue (D. Vyukov's node based design).
+
+    Any number of threads may call add() concurrently. next(), peek() and empty()
+    must only ever be called from one thread at a time, which is the consumer.
+    Producers never wait for each other nor for the consumer: add() is a single
+    atomic exchange followed by a release store.
+*/
+template<typename T>
+class MPSCQueue
+{
+    struct Node;
+
+#if COMPILER_HAS_CPP11_SUPPORT
+    typedef std::atomic<Node*> AtomicNodePtr;
+#else
+    typedef Node* volatile AtomicNodePtr;
+#endif
+
+    struct Node
+    {
+        Node() : Data(), Next(NULL) { }
+        explicit Node(T const& data) : Data(data), Next(NULL) { }
+
+        T Data;
+        AtomicNodePtr Next;
+    };
+
+    public:
+        MPSCQueue() : _head(new Node()), _tail(NULL)
+        {
+            _tail = LoadAcquire(&_head);
+        }
+
+        ~MPSCQueue()
+        {
+            T output;
+            while (next(output))
+                ;
+
+            delete _tail;
+        }
+
+        //! Adds an item to the queue, safe to call from any thread.
+        void add(T const& item)
+        {
+            Node* node = new Node(item);
+            Node* prevHead = Exchange(&_head, node);
+            StoreRelease(&prevHead->Next, node);
+        }
+
+        //! Gets the next item in the queue, if any. Consumer only.
+        bool next(T& result)
+        {
+            Node* tail = _tail;
+            Node* next = LoadAcquire(&tail->Next);
+            if (!next)
+                return false;
+
+            result = next->Data;
+            _tail = next;
+            delete tail;
+            return true;
+        }
+
+        //! Gets the next item only if check.Process(item) accepts it. Consumer only.
+        template<class Checker>
+        bool next(T& result, Checker& check)
+        {
+            T const* front = peek();
+            if (!front || !check.Process(*front))
+                return false;
+
+            return next(result);
+        }
+
+        //! Moves up to max items accepted by check into out, stopping at the first rejected one. Consumer only.
+        template<class Container, class Checker>
+        size_t drain(Container& out, Checker& check, size_t max)
+        {
+            size_t count = 0;
+            T item;
+            while (count < max && next(item, check))
+            {
+                out.push_back(item);
+                ++count;
+            }
+
+            return count;
+        }
+
+        //! Returns the next item without removing it, NULL if the queue is empty. Consumer only.
+        T const* peek() const
+        {
+            Node* next = LoadAcquire(&_tail->Next);
+            return next ? &next->Data : NULL;
+        }
+
+        //! Checks if the queue is empty. Consumer only, producers may add at any time.
+        bool empty() const
+        {
+            return LoadAcquire(&_tail->Next) == NULL;
+        }
+
+    private:
+        MPSCQueue(MPSCQueue const&);
+        MPSCQueue& operator=(MPSCQueue const&);
+
+#if COMPILER_HAS_CPP11_SUPPORT
+        static Node* Exchange(AtomicNodePtr* target, Node* value)
+        {
+            return target->exchange(value, std::memory_order_acq_rel);
+        }
+
+        static void StoreRelease(AtomicNodePtr* target, Node* value)
+        {
+            target->store(value, std::memory_order_release);
+        }
+
+        static Node* LoadAcquire(AtomicNodePtr const* source)
+        {
+            return source->load(std::memory_order_acquire);
+        }
+#elif COMPILER == COMPILER_MICROSOFT
+        // volatile accesses have acquire/release semantics with MSVC
+        static Node* Exchange(AtomicNodePtr* target, Node* value)
+        {
+            return static_cast<Node*>(_InterlockedExchangePointer(reinterpret_cast<void* volatile*>(target), value));
+        }
+
+        static void StoreRelease(AtomicNodePtr* target, Node* value)
+        {
+            _ReadWriteBarrier();
+            *target = value;
+        }
+
+        static Node* LoadAcquire(AtomicNodePtr const* source)
+        {
+            Node* value = *source;
+            _ReadWriteBarrier();
+            return value;
+        }
+#else
+        static Node* Exchange(AtomicNodePtr* target, Node* value)
+        {
+            // __sync_lock_test_and_set is only an acquire barrier, make it a full one
+            __sync_synchronize();
+            return __sync_lock_test_and_set(target, value);
+        }
+
+        static void StoreRelease(AtomicNodePtr* target, Node* value)
+        {
+            __sync_synchronize();
+            *target = value;
+        }
+
+        static Node* LoadAcquire(AtomicNodePtr const* source)
+        {
+            Node* value = *source;
+            __sync_synchronize();
+            return value;
+        }
+#endif
+
+        AtomicNodePtr _head;                                // last added node, shared by producers
+        Node* _tail;                                        // stub node in front of the next item, consumer only
+};
+
+#endif
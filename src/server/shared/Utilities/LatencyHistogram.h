@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFINITY_LATENCYHISTOGRAM_H
+#define INFINITY_LATENCYHISTOGRAM_H
+
+#include "Define.h"
+#include <cstring>
+
+/**
+    Histogram of durations (usually microseconds) in power-of-two buckets.
+    Bucket 0 holds zero values, bucket i holds values in [2^(i-1), 2^i).
+
+    Not thread-safe: every writer must own its instance, readers merge copies.
+*/
+class LatencyHistogram
+{
+    public:
+        static uint8 const BUCKET_COUNT = 32;
+
+        LatencyHistogram() { Reset(); }
+
+        void Reset() { memset(_buckets, 0, sizeof(_buckets)); }
+
+        void Add(uint64 value) { ++_buckets[GetBucket(value)]; }
+
+        void Merge(LatencyHistogram const& other)
+        {
+            for (uint8 i = 0; i < BUCKET_COUNT; ++i)
+                _buckets[i] += other._buckets[i];
+        }
+
+        uint64 GetCount() const
+        {
+            uint64 count = 0;
+            for (uint8 i = 0; i < BUCKET_COUNT; ++i)
+                count += _buckets[i];
+            return count;
+        }
+
+        uint32 GetBucketCount(uint8 bucket) const { return bucket < BUCKET_COUNT ? _buckets[bucket] : 0; }
+
+        /// Returns the upper bound of the bucket containing the given percentile (0-100)
+        uint64 GetPercentile(float percentile) const
+        {
+            uint64 count = GetCount();
+            if (!count)
+                return 0;
+
+            uint64 target = uint64(count * percentile / 100.0f);
+            if (target < 1)
+                target = 1;
+            if (target > count)
+                target = count;
+
+            uint64 seen = 0;
+            for (uint8 i = 0; i < BUCKET_COUNT; ++i)
+            {
+                seen += _buckets[i];
+                if (seen >= target)
+                    return GetBucketUpperBound(i);
+            }
+
+            return GetBucketUpperBound(BUCKET_COUNT - 1);
+        }
+
+        static uint8 GetBucket(uint64 value)
+        {
+            uint8 bucket = 0;
+            while (value && bucket < BUCKET_COUNT - 1)
+            {
+                value >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        static uint64 GetBucketUpperBound(uint8 bucket)
+        {
+            return bucket ? (UI64LIT(1) << bucket) - 1 : 0;
+        }
+
+    private:
+        uint32 _buckets[BUCKET_COUNT];
+};
+
+#endif
@@ -42,6 +42,20 @@ inline uint32 GetMSTimeDiffToNow(uint32 oldMSTime)
     return getMSTimeDiff(oldMSTime, getMSTime());
 }
 
+// Microsecond resolution clock for profiling, does not wrap like getMSTime()
+inline uint64 getUSTime()
+{
+    static const ACE_Time_Value ApplicationStartTime = ACE_OS::gettimeofday();
+    ACE_Time_Value elapsed = ACE_OS::gettimeofday() - ApplicationStartTime;
+    return uint64(elapsed.sec()) * 1000000 + uint64(elapsed.usec());
+}
+
+inline uint64 GetUSTimeDiffToNow(uint64 oldUSTime)
+{
+    uint64 now = getUSTime();
+    return now > oldUSTime ? now - oldUSTime : 0;
+}
+
 struct IntervalTimer
 {
     public:
@@ -437,6 +437,9 @@ bool Master::_StartDB()
         return false;
     }
 
+    CharacterDatabase.SetWriteBatching(sConfigMgr->GetIntDefault("CharacterDatabase.WriteBatch.Size", 0),
+        sConfigMgr->GetIntDefault("CharacterDatabase.WriteBatch.Delay", 50));
+
     ///- Get login database info from configuration file
     dbString = sConfigMgr->GetStringDefault("LoginDatabaseInfo", "");
     if (dbString.empty())
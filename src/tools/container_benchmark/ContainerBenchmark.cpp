@@ -0,0 +1,768 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+    Compares the containers of shared/Dynamic with the standard containers they replaced, on
+    synthetic data shaped like the server data they hold. Ids are drawn from a fixed seed so
+    that runs are reproducible. Memory is the heap held by a container once filled, counted
+    by the replaced global operator new and delete.
+
+    Scenarios:
+      spellmgr   DenseIdMap, UNORDERED_MAP and std::map holding the entries of the SpellMgr
+                 tables kept in DenseIdMap: memory and lookup latency of stored and missing ids
+      visibility the VisibleNotifier pass of every player of a crowded city, with the client
+                 GUID sets in std::set and the old per object erase, and in FlatSet and the
+                 merge based diff of SendToSelf
+      auras      apply, remove and tick of the auras of many units, with the aura objects on
+                 the heap and the visible auras in std::map, and with the aura objects in
+                 FreeListPool and the visible auras in FlatMap
+      pull       area casts of a raid on a creature pack, with Spell and SpellEvent on the heap
+                 and the unit targets in std::list, and with Spell and SpellEvent in
+                 FreeListPool and the unit targets in std::vector
+*/
+
+#include "Define.h"
+#include "DenseIdMap.h"
+#include "FlatMap.h"
+#include "FlatSet.h"
+#include "FreeListPool.h"
+#include "SpellMgr.h"
+#include "UnorderedMap.h"
+
+#include <ace/OS_NS_sys_time.h>
+#include <ace/Time_Value.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <iterator>
+#include <list>
+#include <new>
+#include <set>
+#include <vector>
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+# define OPERATOR_NEW_THROW
+#else
+# define OPERATOR_NEW_THROW throw(std::bad_alloc)
+#endif
+
+#define HEAP_HEADER_SIZE    16                              // keeps the returned blocks aligned like malloc does
+#define LOOKUP_STREAM_SIZE  65536
+#define MAX_AURAS           255                             // as in Unit.h
+#define MAX_SPELL_EFFECTS   3
+
+// sizes of UnitAura, AuraApplication and AuraEffect in a 64 bit Linux build
+#define AURA_SIZE               208
+#define AURA_APPLICATION_SIZE   24
+#define AURA_EFFECT_SIZE        48
+// sizes of Spell and SpellEvent in a 64 bit Linux build
+#define SPELL_SIZE              1760
+#define SPELL_EVENT_SIZE        40
+
+namespace
+{
+    size_t LiveHeapBytes = 0;
+    uint64 HeapAllocations = 0;
+    uint32 RandomState = 0x1234567;
+    uint32 volatile Sink = 0;                               // lookup results go here so they can't be optimized away
+
+    uint64 Now()
+    {
+        ACE_UINT64 usec;
+        ACE_OS::gettimeofday().to_usec(usec);
+        return usec;
+    }
+
+    uint32 NextRandom()
+    {
+        RandomState = RandomState * 1103515245 + 12345;
+        return RandomState >> 8;
+    }
+}
+
+void* operator new(size_t size) OPERATOR_NEW_THROW
+{
+    char* block = static_cast<char*>(malloc(size + HEAP_HEADER_SIZE));
+    if (!block)
+        throw std::bad_alloc();
+
+    *reinterpret_cast<size_t*>(block) = size;
+    LiveHeapBytes += size;
+    ++HeapAllocations;
+    return block + HEAP_HEADER_SIZE;
+}
+
+void operator delete(void* ptr) throw()
+{
+    if (!ptr)
+        return;
+
+    char* block = static_cast<char*>(ptr) - HEAP_HEADER_SIZE;
+    LiveHeapBytes -= *reinterpret_cast<size_t*>(block);
+    free(block);
+}
+
+struct BenchmarkOptions
+{
+    BenchmarkOptions() : Scenario(NULL), Lookups(4000000), MaxSpellId(80000), Players(300), Creatures(200), Churn(2), Rounds(20),
+        Units(2000), Auras(20), Cycles(2000000), Casters(25), Targets(40), Pulls(20000) { }
+
+    char const* Scenario;
+    uint32 Lookups;                                         // per container and kind of lookup
+    uint32 MaxSpellId;                                      // highest id of Spell.dbc
+    uint32 Players;                                         // players in sight of each other
+    uint32 Creatures;                                       // creatures in sight of every player
+    uint32 Churn;                                           // percent of the objects out of range in one pass
+    uint32 Rounds;                                          // passes of every player
+    uint32 Units;                                           // units carrying auras
+    uint32 Auras;                                           // auras on every unit
+    uint32 Cycles;                                          // aura removals each followed by an application
+    uint32 Casters;                                         // players casting on the pack
+    uint32 Targets;                                         // creatures of the pack
+    uint32 Pulls;                                           // rounds of one cast per caster
+};
+
+/// Ids stored in a table and streams of lookups of stored and of missing ids
+struct IdSample
+{
+    std::vector<uint32> Stored;
+    std::vector<uint32> StoredLookups;
+    std::vector<uint32> MissingLookups;
+};
+
+IdSample MakeIdSample(uint32 rows, uint32 maxId)
+{
+    std::vector<bool> used(maxId + 1, false);
+
+    IdSample sample;
+    while (sample.Stored.size() < rows)
+    {
+        uint32 id = 1 + NextRandom() % maxId;
+        if (used[id])
+            continue;
+
+        used[id] = true;
+        sample.Stored.push_back(id);
+    }
+
+    // long random streams, a short repeating one would train the branch predictor
+    while (sample.StoredLookups.size() < LOOKUP_STREAM_SIZE)
+        sample.StoredLookups.push_back(sample.Stored[NextRandom() % rows]);
+
+    while (sample.MissingLookups.size() < LOOKUP_STREAM_SIZE)
+    {
+        uint32 id = 1 + NextRandom() % maxId;
+        if (!used[id])
+            sample.MissingLookups.push_back(id);
+    }
+
+    return sample;
+}
+
+template<class Entry>
+Entry const* Find(DenseIdMap<Entry> const& table, uint32 id)
+{
+    return table.find(id);
+}
+
+template<class Table>
+typename Table::mapped_type const* Find(Table const& table, uint32 id)
+{
+    typename Table::const_iterator itr = table.find(id);
+    return itr != table.end() ? &itr->second : NULL;
+}
+
+/// Nanoseconds per lookup of ids, cycled through until count lookups were made
+template<class Table>
+double TimeLookups(Table const& table, std::vector<uint32> const& ids, uint32 count)
+{
+    uint32 found = 0;
+    uint64 start = Now();
+    for (uint32 i = 0; i < count; ++i)
+        if (Find(table, ids[i % ids.size()]))
+            ++found;
+
+    uint64 elapsed = Now() - start;
+    Sink = Sink + found;
+    return double(elapsed) * 1000.0 / count;
+}
+
+template<class Table>
+void BenchmarkTable(char const* tableName, char const* containerName, IdSample const& sample, BenchmarkOptions const& options)
+{
+    size_t heapBefore = LiveHeapBytes;
+
+    Table* table = new Table();
+    for (std::vector<uint32>::const_iterator itr = sample.Stored.begin(); itr != sample.Stored.end(); ++itr)
+        (*table)[*itr];
+
+    size_t bytes = LiveHeapBytes - heapBefore;
+
+    double hit = TimeLookups(*table, sample.StoredLookups, options.Lookups);
+    double miss = TimeLookups(*table, sample.MissingLookups, options.Lookups);
+
+    printf("%-18s %-14s %6u rows %10u bytes %8.2f ns hit %8.2f ns miss\n", tableName, containerName, uint32(sample.Stored.size()),
+        uint32(bytes), hit, miss);
+
+    delete table;
+}
+
+template<class Entry>
+void BenchmarkSpellTable(char const* tableName, uint32 rows, BenchmarkOptions const& options)
+{
+    IdSample sample = MakeIdSample(rows, options.MaxSpellId);
+
+    BenchmarkTable<DenseIdMap<Entry> >(tableName, "DenseIdMap", sample, options);
+    BenchmarkTable<UNORDERED_MAP<uint32, Entry> >(tableName, "UNORDERED_MAP", sample, options);
+    BenchmarkTable<std::map<uint32, Entry> >(tableName, "std::map", sample, options);
+}
+
+/// Row counts are in the order of those of a 3.3.5 world database
+void RunSpellMgr(BenchmarkOptions const& options)
+{
+    printf("spell ids 1-%u, %u lookups per container\n", options.MaxSpellId, options.Lookups);
+
+    BenchmarkSpellTable<SpellProcEventEntry>("spell_proc_event", 1500, options);
+    BenchmarkSpellTable<SpellProcEntry>("spell_proc", 300, options);
+    BenchmarkSpellTable<SpellBonusEntry>("spell_bonus_data", 800, options);
+    BenchmarkSpellTable<SpellThreatEntry>("spell_threat", 250, options);
+}
+
+/// Client GUID set of one player with the VisibleNotifier pass before FlatSet
+struct TreeClientSet
+{
+    std::set<uint64> ClientGUIDs;
+
+    void Pass(std::vector<uint64> const& inRange, uint32& created, uint32& destroyed)
+    {
+        std::set<uint64> visGuids(ClientGUIDs);
+        for (std::vector<uint64>::const_iterator itr = inRange.begin(); itr != inRange.end(); ++itr)
+        {
+            visGuids.erase(*itr);
+            if (ClientGUIDs.find(*itr) == ClientGUIDs.end())
+            {
+                ClientGUIDs.insert(*itr);
+                ++created;
+            }
+        }
+
+        for (std::set<uint64>::const_iterator itr = visGuids.begin(); itr != visGuids.end(); ++itr)
+        {
+            ClientGUIDs.erase(*itr);
+            ++destroyed;
+        }
+    }
+};
+
+/// Client GUID set of one player with the VisibleNotifier pass of GridNotifiers.cpp
+struct FlatClientSet
+{
+    FlatSet<uint64> ClientGUIDs;
+
+    void Pass(std::vector<uint64> const& inRange, uint32& created, uint32& destroyed)
+    {
+        FlatSet<uint64> visGuids(ClientGUIDs);
+        std::vector<uint64> visited;
+        visited.reserve(visGuids.size());
+        for (std::vector<uint64>::const_iterator itr = inRange.begin(); itr != inRange.end(); ++itr)
+        {
+            visited.push_back(*itr);
+            if (ClientGUIDs.find(*itr) == ClientGUIDs.end())
+            {
+                ClientGUIDs.insert(*itr);
+                ++created;
+            }
+        }
+
+        std::sort(visited.begin(), visited.end());
+
+        std::vector<uint64> outOfRange;
+        std::set_difference(visGuids.begin(), visGuids.end(), visited.begin(), visited.end(), std::back_inserter(outOfRange));
+        ClientGUIDs.erase_sorted(outOfRange.begin(), outOfRange.end());
+        destroyed += outOfRange.size();
+    }
+};
+
+/**
+    Objects in range of each player for every pass. Every player sees all other players and
+    all creatures in grid visit order, but for Churn percent of them which are out of range.
+*/
+std::vector<std::vector<uint64> > MakeVisibilityPasses(BenchmarkOptions const& options)
+{
+    std::vector<uint64> objects;
+    for (uint32 i = 0; i < options.Players; ++i)
+        objects.push_back(uint64(1000 + i));                            // HIGHGUID_PLAYER
+    for (uint32 i = 0; i < options.Creatures; ++i)
+        objects.push_back(UI64LIT(0xF130000000000000) | (uint64(3000 + i % 50) << 24) | (200000 + i));   // HIGHGUID_UNIT
+
+    // the grid visit order has nothing to do with the GUID order
+    for (size_t i = objects.size(); i > 1; --i)
+        std::swap(objects[i - 1], objects[NextRandom() % i]);
+
+    std::vector<std::vector<uint64> > passes(options.Rounds * options.Players);
+    for (uint32 pass = 0; pass < passes.size(); ++pass)
+    {
+        uint64 self = uint64(1000 + pass % options.Players);
+        for (std::vector<uint64>::const_iterator itr = objects.begin(); itr != objects.end(); ++itr)
+            if (*itr != self && NextRandom() % 100 >= options.Churn)
+                passes[pass].push_back(*itr);
+    }
+
+    return passes;
+}
+
+template<class ClientSet>
+void BenchmarkVisibility(char const* name, std::vector<std::vector<uint64> > const& passes, BenchmarkOptions const& options)
+{
+    size_t heapBefore = LiveHeapBytes;
+    std::vector<ClientSet> players(options.Players);
+
+    // the first round fills the client sets, like players walking into the city
+    uint32 created = 0;
+    uint32 destroyed = 0;
+    for (uint32 i = 0; i < options.Players; ++i)
+        players[i].Pass(passes[i], created, destroyed);
+
+    size_t bytes = LiveHeapBytes - heapBefore;
+
+    created = 0;
+    destroyed = 0;
+    uint64 start = Now();
+    for (uint32 pass = options.Players; pass < passes.size(); ++pass)
+        players[pass % options.Players].Pass(passes[pass], created, destroyed);
+
+    uint64 elapsed = Now() - start;
+    uint32 count = uint32(passes.size()) - options.Players;
+
+    printf("%-10s %10.2f us/pass %10u bytes of client sets %8u created %8u destroyed\n", name, count ? double(elapsed) / count : 0.0,
+        uint32(bytes), created, destroyed);
+}
+
+void RunVisibility(BenchmarkOptions const& options)
+{
+    if (options.Players < 2 || options.Rounds < 2)
+        return;
+
+    printf("%u players, %u creatures, %u%% out of range per pass, %u passes of every player\n", options.Players, options.Creatures,
+        options.Churn, options.Rounds - 1);
+
+    std::vector<std::vector<uint64> > passes = MakeVisibilityPasses(options);
+    BenchmarkVisibility<TreeClientSet>("std::set", passes, options);
+    BenchmarkVisibility<FlatClientSet>("FlatSet", passes, options);
+}
+
+/// Stand-in of an aura object, allocated from the heap
+template<size_t Size>
+struct HeapObject
+{
+    char Data[Size];
+};
+
+/// Stand-in of an aura object, allocated from FreeListPool like the aura classes
+template<size_t Size>
+struct PooledObject
+{
+    static void* operator new(size_t size) { return FreeListPool<PooledObject>::Allocate(size); }
+    static void operator delete(void* ptr, size_t size) { FreeListPool<PooledObject>::Deallocate(ptr, size); }
+
+    char Data[Size];
+};
+
+/**
+    Units holding auras the way Unit and Aura do: an aura object, one application and one to
+    three effects per aura, and the application registered in the lowest free visible slot.
+*/
+template<class Aura, class Application, class Effect, class VisibleAuraMap>
+class AuraWorkload
+{
+    struct AuraRecord
+    {
+        Aura* Base;
+        Application* App;
+        Effect* Effects[MAX_SPELL_EFFECTS];
+        uint8 EffectCount;
+        uint8 Slot;
+    };
+
+    struct AuraUnit
+    {
+        VisibleAuraMap VisibleAuras;
+        std::vector<AuraRecord> Auras;
+    };
+
+    public:
+        explicit AuraWorkload(uint32 units) : _units(units) { }
+
+        ~AuraWorkload()
+        {
+            for (typename std::vector<AuraUnit>::iterator itr = _units.begin(); itr != _units.end(); ++itr)
+                while (!itr->Auras.empty())
+                    Remove(*itr, 0);
+        }
+
+        void Fill(uint32 auras)
+        {
+            for (uint32 i = 0; i < auras; ++i)
+                for (typename std::vector<AuraUnit>::iterator itr = _units.begin(); itr != _units.end(); ++itr)
+                    Apply(*itr);
+        }
+
+        /// Removes a random aura of a random unit and applies a new one to it
+        void Cycle()
+        {
+            AuraUnit& unit = _units[NextRandom() % _units.size()];
+            if (!unit.Auras.empty())
+                Remove(unit, NextRandom() % unit.Auras.size());
+
+            Apply(unit);
+        }
+
+        /// Walks the visible auras of every unit, like the periodic and client updates do
+        uint32 Tick()
+        {
+            uint32 visited = 0;
+            for (typename std::vector<AuraUnit>::const_iterator itr = _units.begin(); itr != _units.end(); ++itr)
+            {
+                for (typename VisibleAuraMap::const_iterator aura = itr->VisibleAuras.begin(); aura != itr->VisibleAuras.end(); ++aura)
+                {
+                    Sink += uint32(aura->second->Data[0]) + aura->first;
+                    ++visited;
+                }
+            }
+
+            return visited;
+        }
+
+    private:
+        void Apply(AuraUnit& unit)
+        {
+            AuraRecord record;
+            record.Base = new Aura();
+            record.Base->Data[0] = 1;
+            record.App = new Application();
+            record.App->Data[0] = 1;
+            record.EffectCount = uint8(1 + NextRandom() % MAX_SPELL_EFFECTS);
+            for (uint8 i = 0; i < record.EffectCount; ++i)
+            {
+                record.Effects[i] = new Effect();
+                record.Effects[i]->Data[0] = 1;
+            }
+
+            // lookup for free slots, as AuraApplication::AuraApplication does
+            record.Slot = MAX_AURAS;
+            typename VisibleAuraMap::const_iterator itr = unit.VisibleAuras.find(0);
+            for (uint32 freeSlot = 0; freeSlot < MAX_AURAS; ++itr, ++freeSlot)
+            {
+                if (itr == unit.VisibleAuras.end() || itr->first != freeSlot)
+                {
+                    record.Slot = uint8(freeSlot);
+                    break;
+                }
+            }
+
+            if (record.Slot < MAX_AURAS)
+                unit.VisibleAuras[record.Slot] = record.App;
+
+            unit.Auras.push_back(record);
+        }
+
+        void Remove(AuraUnit& unit, size_t index)
+        {
+            AuraRecord record = unit.Auras[index];
+            unit.Auras[index] = unit.Auras.back();
+            unit.Auras.pop_back();
+
+            if (record.Slot < MAX_AURAS)
+                unit.VisibleAuras.erase(record.Slot);
+
+            for (uint8 i = 0; i < record.EffectCount; ++i)
+                delete record.Effects[i];
+
+            delete record.App;
+            delete record.Base;
+        }
+
+        std::vector<AuraUnit> _units;
+};
+
+template<class Workload>
+void BenchmarkAuras(char const* name, BenchmarkOptions const& options)
+{
+    RandomState = 0x1234567;
+    size_t heapBefore = LiveHeapBytes;
+
+    Workload* workload = new Workload(options.Units);
+    workload->Fill(options.Auras);
+    size_t filledBytes = LiveHeapBytes - heapBefore;
+
+    uint64 start = Now();
+    for (uint32 i = 0; i < options.Cycles; ++i)
+        workload->Cycle();
+
+    uint64 cycleTime = Now() - start;
+    size_t cycledBytes = LiveHeapBytes - heapBefore;
+
+    uint32 visited = 0;
+    start = Now();
+    for (uint32 i = 0; i < 100; ++i)
+        visited += workload->Tick();
+
+    uint64 tickTime = Now() - start;
+
+    delete workload;
+
+    printf("%-24s %8.1f ns/cycle %6.2f ns/aura tick %10u bytes filled %10u bytes after cycles\n", name,
+        options.Cycles ? 1000.0 * cycleTime / options.Cycles : 0.0, visited ? 1000.0 * tickTime / visited : 0.0,
+        uint32(filledBytes), uint32(cycledBytes));
+}
+
+void RunAuras(BenchmarkOptions const& options)
+{
+    if (!options.Units || options.Auras >= MAX_AURAS)
+        return;
+
+    printf("%u units with %u auras, %u remove and apply cycles\n", options.Units, options.Auras, options.Cycles);
+
+    BenchmarkAuras<AuraWorkload<HeapObject<AURA_SIZE>, HeapObject<AURA_APPLICATION_SIZE>, HeapObject<AURA_EFFECT_SIZE>,
+        std::map<uint8, HeapObject<AURA_APPLICATION_SIZE>*> > >("heap, std::map", options);
+    BenchmarkAuras<AuraWorkload<PooledObject<AURA_SIZE>, PooledObject<AURA_APPLICATION_SIZE>, PooledObject<AURA_EFFECT_SIZE>,
+        FlatMap<uint8, PooledObject<AURA_APPLICATION_SIZE>*> > >("FreeListPool, FlatMap", options);
+}
+
+/// Spell::TargetInfo
+struct BenchmarkTargetInfo
+{
+    uint64 targetGUID;
+    uint64 timeDelay;
+    uint8 missCondition;
+    uint8 reflectResult;
+    uint8 effectMask;
+    bool processed:1;
+    bool alive:1;
+    bool crit:1;
+    bool scaleAura:1;
+    int32 damage;
+};
+
+/**
+    One cast as Spell keeps it: the spell object, the event that deletes it on the next
+    update of the caster, and the unit targets, added after a scan for duplicates like
+    Spell::AddUnitTarget does.
+*/
+template<class SpellObject, class EventObject, class TargetList>
+struct BenchmarkCast
+{
+    BenchmarkCast() : Spell(NULL), Event(NULL) { }
+
+    void Prepare(std::vector<uint64> const& targets)
+    {
+        Spell = new SpellObject();
+        Spell->Data[0] = 1;
+        Event = new EventObject();
+        Event->Data[0] = 1;
+
+        for (std::vector<uint64>::const_iterator itr = targets.begin(); itr != targets.end(); ++itr)
+        {
+            bool found = false;
+            for (typename TargetList::iterator ihit = Targets.begin(); ihit != Targets.end(); ++ihit)
+            {
+                if (ihit->targetGUID == *itr)
+                {
+                    ihit->effectMask |= 1;
+                    found = true;
+                    break;
+                }
+            }
+
+            if (found)
+                continue;
+
+            BenchmarkTargetInfo target;
+            memset(&target, 0, sizeof(target));
+            target.targetGUID = *itr;
+            target.effectMask = 1;
+            target.alive = true;
+            Targets.push_back(target);
+        }
+    }
+
+    /// Hits every target, as the loop over DoAllEffectOnTarget does
+    void Hit()
+    {
+        for (typename TargetList::iterator ihit = Targets.begin(); ihit != Targets.end(); ++ihit)
+        {
+            ihit->processed = true;
+            ihit->damage = int32(ihit->targetGUID & 0xFF);
+            Sink += uint32(ihit->damage);
+        }
+    }
+
+    /// The Spell destructor frees the target list with the spell
+    void Delete()
+    {
+        TargetList().swap(Targets);
+        delete Event;
+        delete Spell;
+        Event = NULL;
+        Spell = NULL;
+    }
+
+    SpellObject* Spell;
+    EventObject* Event;
+    TargetList Targets;
+};
+
+template<class Cast>
+void BenchmarkPull(char const* name, std::vector<uint64> const& pack, BenchmarkOptions const& options)
+{
+    std::vector<Cast> casts(options.Casters);
+    uint64 allocationsBefore = HeapAllocations;
+
+    // the casts of a round stay alive until the next update of their casters
+    uint64 start = Now();
+    for (uint32 pull = 0; pull < options.Pulls; ++pull)
+    {
+        for (typename std::vector<Cast>::iterator itr = casts.begin(); itr != casts.end(); ++itr)
+        {
+            itr->Prepare(pack);
+            itr->Hit();
+        }
+
+        for (typename std::vector<Cast>::iterator itr = casts.begin(); itr != casts.end(); ++itr)
+            itr->Delete();
+    }
+
+    uint64 elapsed = Now() - start;
+    uint32 count = options.Pulls * options.Casters;
+
+    printf("%-32s %8.1f ns/cast %6.2f heap allocations/cast\n", name, count ? 1000.0 * elapsed / count : 0.0,
+        count ? double(HeapAllocations - allocationsBefore) / count : 0.0);
+}
+
+void RunPull(BenchmarkOptions const& options)
+{
+    if (!options.Casters)
+        return;
+
+    printf("%u casters, %u creatures in the pack, %u pulls\n", options.Casters, options.Targets, options.Pulls);
+
+    std::vector<uint64> pack;
+    for (uint32 i = 0; i < options.Targets; ++i)
+        pack.push_back(UI64LIT(0xF130000000000000) | (uint64(3000 + i % 5) << 24) | (200000 + i));   // HIGHGUID_UNIT
+
+    BenchmarkPull<BenchmarkCast<HeapObject<SPELL_SIZE>, HeapObject<SPELL_EVENT_SIZE>, std::list<BenchmarkTargetInfo> > >(
+        "heap, std::list", pack, options);
+    BenchmarkPull<BenchmarkCast<PooledObject<SPELL_SIZE>, PooledObject<SPELL_EVENT_SIZE>, std::vector<BenchmarkTargetInfo> > >(
+        "FreeListPool, std::vector", pack, options);
+}
+
+void usage(char const* prog)
+{
+    printf("Usage:\n");
+    printf(" %s [<options>] <scenario>\n", prog);
+    printf("    -lookups count           lookups per container (spellmgr, default 4000000)\n");
+    printf("    -players count           players in the city (visibility, default 300)\n");
+    printf("    -creatures count         creatures in the city (visibility, default 200)\n");
+    printf("    -churn percent           objects out of range in one pass (visibility, default 2)\n");
+    printf("    -rounds count            passes of every player (visibility, default 20)\n");
+    printf("    -units count             units carrying auras (auras, default 2000)\n");
+    printf("    -auras count             auras on every unit (auras, default 20)\n");
+    printf("    -cycles count            aura removals each followed by an application (auras, default 2000000)\n");
+    printf("    -casters count           players casting on the pack (pull, default 25)\n");
+    printf("    -targets count           creatures of the pack (pull, default 40)\n");
+    printf("    -pulls count             rounds of one area cast per player (pull, default 20000)\n");
+    printf("Scenarios:\n");
+    printf("    spellmgr                 SpellMgr tables, DenseIdMap against UNORDERED_MAP and std::map\n");
+    printf("    visibility               client GUID sets of a crowded city, FlatSet against std::set\n");
+    printf("    auras                    aura objects and visible auras, FreeListPool and FlatMap against heap and std::map\n");
+    printf("    pull                     area casts on a pack, FreeListPool and std::vector against heap and std::list\n");
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    for (int c = 1; c < argc; ++c)
+    {
+        if (argv[c][0] != '-')
+        {
+            options.Scenario = argv[c];
+            continue;
+        }
+
+        if (c + 1 >= argc)
+        {
+            printf("Runtime-Error: %s option requires an input argument\n", argv[c]);
+            return 1;
+        }
+
+        char const* name = argv[c] + 1;
+        uint32 value = uint32(atoi(argv[++c]));
+        if (!strcmp(name, "lookups"))
+            options.Lookups = value;
+        else if (!strcmp(name, "players"))
+            options.Players = value;
+        else if (!strcmp(name, "creatures"))
+            options.Creatures = value;
+        else if (!strcmp(name, "churn"))
+            options.Churn = value;
+        else if (!strcmp(name, "rounds"))
+            options.Rounds = value;
+        else if (!strcmp(name, "units"))
+            options.Units = value;
+        else if (!strcmp(name, "auras"))
+            options.Auras = value;
+        else if (!strcmp(name, "cycles"))
+            options.Cycles = value;
+        else if (!strcmp(name, "casters"))
+            options.Casters = value;
+        else if (!strcmp(name, "targets"))
+            options.Targets = value;
+        else if (!strcmp(name, "pulls"))
+            options.Pulls = value;
+        else
+        {
+            printf("Runtime-Error: unknown option %s\n", argv[c - 1]);
+            return 1;
+        }
+    }
+
+    if (!options.Scenario || !options.Lookups)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (!strcmp(options.Scenario, "spellmgr"))
+        RunSpellMgr(options);
+    else if (!strcmp(options.Scenario, "visibility"))
+        RunVisibility(options);
+    else if (!strcmp(options.Scenario, "auras"))
+        RunAuras(options);
+    else if (!strcmp(options.Scenario, "pull"))
+        RunPull(options);
+    else
+    {
+        printf("Runtime-Error: unknown scenario %s\n", options.Scenario);
+        usage(argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,740 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+    Headless map benchmark. Starts the world like worldserver does (configuration, databases,
+    DBC and world data) but opens no listening socket. Creatures are summoned into one map
+    and players are created from the playercreateinfo of a race and class, backed by
+    WorldSessions without a socket. Nothing is saved, but the world start up writes to the
+    databases like worldserver does: point it at a test realm.
+
+    Scenarios:
+      aoe   area target searches from every player, through the cell target index and
+            through the cell containers, then real casts of an area spell
+      auras apply and remove of an aura on every creature, map updates with and without the
+            aura on every creature, and the resident memory through it. Run it on builds of
+            two revisions to compare their aura storage.
+      combat every creature attacks a player and every player fights back in melee, and
+            casts the area spell and the aura spell on a fixed interval; the map is updated
+            for a fixed number of ticks and the tick profile of the map is printed.
+      pull  a raid of 25 players casts the area spell on a pack of 40 creatures every round,
+            each round followed by a map update that deletes the finished spells. Run it on
+            builds of two revisions to compare their Spell allocations.
+*/
+
+#include "Common.h"
+#include "Configuration/Config.h"
+#include "Database/DatabaseEnv.h"
+#include "DBCStores.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "Log.h"
+#include "Map.h"
+#include "MapManager.h"
+#include "ObjectAccessor.h"
+#include "ObjectMgr.h"
+#include "OpenSSLCrypto.h"
+#include "Player.h"
+#include "Spell.h"
+#include "SpellMgr.h"
+#include "TemporarySummon.h"
+#include "TickProfiler.h"
+#include "Timer.h"
+#include "World.h"
+#include "WorldSession.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef _INFINITY_CORE_CONFIG
+# define _INFINITY_CORE_CONFIG  "InfinityWorld.conf"
+#endif
+
+#define BENCHMARK_ACCOUNT_ID    0x7FFF0000                  // first account id of the fake sessions
+#define BENCHMARK_FACTION       14                          // monsters, hostile to every player
+#define BENCHMARK_TICK          100                         // ms of game time per map update
+#define BENCHMARK_CAST_INTERVAL 10                          // map updates between two scripted casts of a player
+
+WorldDatabaseWorkerPool WorldDatabase;                      ///< Accessor to the world database
+CharacterDatabaseWorkerPool CharacterDatabase;              ///< Accessor to the character database
+LoginDatabaseWorkerPool LoginDatabase;                      ///< Accessor to the realm/login database
+
+uint32 realmID;                                             ///< Id of the realm
+
+struct BenchmarkOptions
+{
+    BenchmarkOptions() : ConfigFile(_INFINITY_CORE_CONFIG), Scenario(NULL), MapId(0), X(-8949.95f), Y(-132.49f), Z(83.53f),
+        Spread(0.0f), Creatures(0), Players(0), CreatureEntry(299), Race(RACE_HUMAN), Class(CLASS_MAGE),
+        SpellId(1449), AuraSpellId(172), Level(0), Iterations(200) { }
+
+    char const* ConfigFile;
+    char const* Scenario;
+    uint32 MapId;
+    float X;
+    float Y;
+    float Z;
+    float Spread;                                           // units stand in a square of 2 * Spread yards around X, Y, 0 for the scenario default
+    uint32 Creatures;                                       // 0 for the scenario default
+    uint32 Players;                                         // 0 for the scenario default
+    uint32 CreatureEntry;
+    uint8 Race;
+    uint8 Class;
+    uint32 SpellId;                                         // area spell cast by the players
+    uint32 AuraSpellId;                                     // aura put on the creatures
+    uint8 Level;                                            // level of all units, 0 keeps the start and template levels
+    uint32 Iterations;
+};
+
+/// Scripted cast of the combat scenario, queued so that it runs inside the map update of its caster
+class BenchmarkCastEvent : public BasicEvent
+{
+    public:
+        BenchmarkCastEvent(Unit* caster, Unit* target, SpellInfo const* spellInfo) : _caster(caster), _target(target), _spellInfo(spellInfo) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
+        {
+            _caster->CastSpell(_target, _spellInfo, true);
+            return true;
+        }
+
+    private:
+        Unit* _caster;
+        Unit* _target;
+        SpellInfo const* _spellInfo;
+};
+
+/// The constructor of CharacterCreateInfo is only open to the character creation code
+class BenchmarkCharacter : public CharacterCreateInfo
+{
+    public:
+        BenchmarkCharacter(std::string const& name, uint8 race, uint8 cclass, WorldPacket& data) :
+            CharacterCreateInfo(name, race, cclass, GENDER_MALE, 0, 0, 0, 0, 0, 0, data) { }
+};
+
+struct BenchmarkMap
+{
+    BenchmarkMap() : Instance(NULL) { }
+
+    Map* Instance;
+    std::vector<Creature*> Creatures;
+    std::vector<Player*> Players;
+};
+
+void usage(char const* prog)
+{
+    printf("Usage:\n");
+    printf(" %s [<options>] <scenario>\n", prog);
+    printf("    -c config_file           use config_file as configuration file\n");
+    printf("    -map id -x x -y y -z z   map and center of the units (default 0 -8949.95 -132.49 83.53)\n");
+    printf("    -spread yards            half width of the square the units stand in (default 30, 5 for pull)\n");
+    printf("    -creatures count         summoned creatures (default 500, 40 for pull)\n");
+    printf("    -players count           players with socketless sessions (default 10, 25 for pull)\n");
+    printf("    -entry entry             creature template of the creatures (default 299)\n");
+    printf("    -race race -class class  race and class of the players (default 1 8)\n");
+    printf("    -spell id                area spell cast by the players (default 1449)\n");
+    printf("    -aura id                 aura put on the creatures (default 172)\n");
+    printf("    -level level             level of the players and creatures (default start and template levels)\n");
+    printf("    -iterations count        searches and casts per player, aura cycles, map updates and pulls (default 200)\n");
+    printf("Scenarios:\n");
+    printf("    aoe                      area target searches and casts\n");
+    printf("    auras                    aura apply, remove and update throughput and resident memory\n");
+    printf("    combat                   melee and scripted casts for a fixed number of map updates\n");
+    printf("    pull                     area casts of a raid on a creature pack\n");
+}
+
+bool ParseOptions(int argc, char** argv, BenchmarkOptions& options)
+{
+    for (int c = 1; c < argc; ++c)
+    {
+        if (argv[c][0] != '-')
+        {
+            options.Scenario = argv[c];
+            continue;
+        }
+
+        if (c + 1 >= argc)
+        {
+            printf("Runtime-Error: %s option requires an input argument\n", argv[c]);
+            return false;
+        }
+
+        char const* name = argv[c] + 1;
+        char const* value = argv[++c];
+        if (!strcmp(name, "c"))
+            options.ConfigFile = value;
+        else if (!strcmp(name, "map"))
+            options.MapId = uint32(atoi(value));
+        else if (!strcmp(name, "x"))
+            options.X = float(atof(value));
+        else if (!strcmp(name, "y"))
+            options.Y = float(atof(value));
+        else if (!strcmp(name, "z"))
+            options.Z = float(atof(value));
+        else if (!strcmp(name, "spread"))
+            options.Spread = float(atof(value));
+        else if (!strcmp(name, "creatures"))
+            options.Creatures = uint32(atoi(value));
+        else if (!strcmp(name, "players"))
+            options.Players = uint32(atoi(value));
+        else if (!strcmp(name, "entry"))
+            options.CreatureEntry = uint32(atoi(value));
+        else if (!strcmp(name, "race"))
+            options.Race = uint8(atoi(value));
+        else if (!strcmp(name, "class"))
+            options.Class = uint8(atoi(value));
+        else if (!strcmp(name, "spell"))
+            options.SpellId = uint32(atoi(value));
+        else if (!strcmp(name, "aura"))
+            options.AuraSpellId = uint32(atoi(value));
+        else if (!strcmp(name, "level"))
+            options.Level = uint8(atoi(value));
+        else if (!strcmp(name, "iterations"))
+            options.Iterations = uint32(atoi(value));
+        else
+        {
+            printf("Runtime-Error: unknown option %s\n", argv[c - 1]);
+            return false;
+        }
+    }
+
+    if (!options.Scenario)
+        return false;
+
+    // the pull packs a raid and its target into the radius of the area spell
+    bool pull = !strcmp(options.Scenario, "pull");
+    if (options.Spread <= 0.0f)
+        options.Spread = pull ? 5.0f : 30.0f;
+    if (!options.Creatures)
+        options.Creatures = pull ? 40 : 500;
+    if (!options.Players)
+        options.Players = pull ? 25 : 10;
+
+    return true;
+}
+
+template<class T>
+bool OpenDatabase(DatabaseWorkerPool<T>& pool, std::string const& name)
+{
+    std::string info = sConfigMgr->GetStringDefault((name + "Info").c_str(), "");
+    if (info.empty())
+    {
+        IC_LOG_ERROR("server.worldserver", "%s not specified in configuration file", name.c_str());
+        return false;
+    }
+
+    uint8 asyncThreads = uint8(sConfigMgr->GetIntDefault((name + ".WorkerThreads").c_str(), 1));
+    uint8 synchThreads = uint8(sConfigMgr->GetIntDefault((name + ".SynchThreads").c_str(), 1));
+    if (!pool.Open(info, asyncThreads, synchThreads))
+    {
+        IC_LOG_ERROR("server.worldserver", "Cannot connect to %s %s", name.c_str(), info.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool StartWorld(BenchmarkOptions const& options)
+{
+    if (!sConfigMgr->LoadInitial(options.ConfigFile))
+    {
+        printf("Invalid or missing configuration file : %s\n", options.ConfigFile);
+        return false;
+    }
+
+    OpenSSLCrypto::threadsSetup();
+    MySQL::Library_Init();
+
+    if (!OpenDatabase(WorldDatabase, "WorldDatabase") || !OpenDatabase(CharacterDatabase, "CharacterDatabase") ||
+        !OpenDatabase(LoginDatabase, "LoginDatabase"))
+        return false;
+
+    realmID = sConfigMgr->GetIntDefault("RealmID", 0);
+    if (!realmID)
+    {
+        IC_LOG_ERROR("server.worldserver", "Realm ID not defined in configuration file");
+        return false;
+    }
+
+    sWorld->SetInitialWorldSettings();
+    return true;
+}
+
+void StopWorld()
+{
+    sMapMgr->UnloadAll();
+    sObjectAccessor->UnloadAll();
+
+    CharacterDatabase.Close();
+    WorldDatabase.Close();
+    LoginDatabase.Close();
+
+    MySQL::Library_End();
+    OpenSSLCrypto::threadsCleanup();
+}
+
+/// Position of unit index out of count, on a square lattice so that runs are reproducible
+Position GetSpawnPosition(BenchmarkOptions const& options, Map* map, uint32 index, uint32 count)
+{
+    uint32 side = uint32(ceil(sqrt(double(count))));
+    float step = side > 1 ? 2.0f * options.Spread / (side - 1) : 0.0f;
+    float x = options.X - options.Spread + step * (index % side);
+    float y = options.Y - options.Spread + step * (index / side);
+
+    float z = map->GetHeight(x, y, options.Z + 10.0f);
+    if (z <= INVALID_HEIGHT)
+        z = options.Z;
+
+    Position pos;
+    pos.Relocate(x, y, z, 0.0f);
+    return pos;
+}
+
+Player* CreatePlayer(BenchmarkOptions const& options, Map* map, uint32 index)
+{
+    WorldSession* session = new WorldSession(BENCHMARK_ACCOUNT_ID + index, NULL, SEC_PLAYER, uint8(sWorld->getIntConfig(CONFIG_EXPANSION)), 0, LOCALE_enUS);
+
+    char name[16];
+    snprintf(name, sizeof(name), "Bench%u", index);
+    WorldPacket data;
+    BenchmarkCharacter info(name, options.Race, options.Class, data);
+
+    Player* player = new Player(session);
+    player->GetMotionMaster()->Initialize();
+    if (!player->Create(sObjectMgr->GenerateLowGuid(HIGHGUID_PLAYER), &info))
+    {
+        delete player;
+        delete session;
+        return NULL;
+    }
+
+    // Create puts the player on the map of its race start position
+    if (player->GetMap() != map)
+    {
+        player->ResetMap();
+        player->SetMap(map);
+    }
+
+    Position pos = GetSpawnPosition(options, map, index, options.Players);
+    player->Relocate(pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), 0.0f);
+
+    session->SetPlayer(player);
+    if (!map->AddPlayerToMap(player))
+    {
+        session->SetPlayer(NULL);
+        player->ResetMap();
+        delete player;
+        delete session;
+        return NULL;
+    }
+
+    return player;
+}
+
+void RemovePlayer(Player* player)
+{
+    WorldSession* session = player->GetSession();
+
+    player->CleanupsBeforeDelete();
+    player->GetMap()->RemovePlayerFromMap(player, true);
+    session->SetPlayer(NULL);
+    delete session;
+}
+
+bool PopulateMap(BenchmarkOptions const& options, BenchmarkMap& bench)
+{
+    MapEntry const* entry = sMapStore.LookupEntry(options.MapId);
+    if (!entry || entry->Instanceable())
+    {
+        IC_LOG_ERROR("server.worldserver", "Map %u is not a continent", options.MapId);
+        return false;
+    }
+
+    bench.Instance = sMapMgr->CreateBaseMap(options.MapId);
+    bench.Instance->LoadGrid(options.X, options.Y);
+
+    for (uint32 i = 0; i < options.Creatures; ++i)
+    {
+        TempSummon* creature = bench.Instance->SummonCreature(options.CreatureEntry, GetSpawnPosition(options, bench.Instance, i, options.Creatures));
+        if (!creature)
+        {
+            IC_LOG_ERROR("server.worldserver", "Cannot summon creature %u", options.CreatureEntry);
+            return false;
+        }
+
+        creature->setFaction(BENCHMARK_FACTION);
+        bench.Creatures.push_back(creature);
+    }
+
+    for (uint32 i = 0; i < options.Players; ++i)
+    {
+        Player* player = CreatePlayer(options, bench.Instance, i);
+        if (!player)
+        {
+            IC_LOG_ERROR("server.worldserver", "Cannot create a player of race %u and class %u", options.Race, options.Class);
+            return false;
+        }
+
+        bench.Players.push_back(player);
+    }
+
+    return true;
+}
+
+void Report(char const* name, uint64 usec, uint32 count)
+{
+    printf("%-40s %10.2f us/op\n", name, count ? double(usec) / count : 0.0);
+}
+
+/// Resident set size of the process from /proc, 0 where there is no /proc
+uint64 GetResidentBytes()
+{
+#if PLATFORM == PLATFORM_WINDOWS
+    return 0;
+#else
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm)
+        return 0;
+
+    unsigned long size = 0;
+    unsigned long resident = 0;
+    if (fscanf(statm, "%lu %lu", &size, &resident) != 2)
+        resident = 0;
+
+    fclose(statm);
+    return uint64(resident) * uint64(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void ReportResident(char const* name, uint64 bytes)
+{
+    printf("%-40s %10.2f MB\n", name, bytes / 1048576.0);
+}
+
+int RunAoE(BenchmarkOptions const& options, BenchmarkMap& bench)
+{
+    SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(options.SpellId);
+    if (!spellInfo)
+    {
+        printf("Spell %u does not exist\n", options.SpellId);
+        return 1;
+    }
+
+    float radius = spellInfo->Effects[EFFECT_0].CalcRadius();
+    if (radius <= 0.0f)
+        radius = options.Spread;
+
+    uint32 searches = options.Iterations * bench.Players.size();
+    uint32 indexTargets = 0;
+    uint32 containerTargets = 0;
+    uint64 indexTime = 0;
+    uint64 containerTime = 0;
+
+    std::list<WorldObject*> targets;
+    for (uint32 i = 0; i < options.Iterations; ++i)
+    {
+        for (std::vector<Player*>::const_iterator itr = bench.Players.begin(); itr != bench.Players.end(); ++itr)
+        {
+            Player* player = *itr;
+            Infinity::WorldObjectSpellAreaTargetCheck check(radius, player, player, player, spellInfo, TARGET_CHECK_ENEMY, NULL);
+            Infinity::WorldObjectListSearcher<Infinity::WorldObjectSpellAreaTargetCheck> searcher(player, targets, check, GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_PLAYER);
+
+            uint64 start = getUSTime();
+            bench.Instance->VisitCellTargets(player->GetPositionX(), player->GetPositionY(), radius, searcher);
+            indexTime += GetUSTimeDiffToNow(start);
+            indexTargets += targets.size();
+            targets.clear();
+
+            start = getUSTime();
+            bench.Instance->VisitAll(player->GetPositionX(), player->GetPositionY(), radius, searcher);
+            containerTime += GetUSTimeDiffToNow(start);
+            containerTargets += targets.size();
+            targets.clear();
+        }
+    }
+
+    printf("%u creatures, %u players, radius %.1f yards, %.1f targets per search\n", uint32(bench.Creatures.size()), uint32(bench.Players.size()),
+        radius, searches ? double(indexTargets) / searches : 0.0);
+    Report("area search, cell target index", indexTime, searches);
+    Report("area search, cell containers", containerTime, searches);
+
+    if (indexTargets != containerTargets)
+    {
+        printf("target count mismatch: %u through the index, %u through the containers\n", indexTargets, containerTargets);
+        return 1;
+    }
+
+    // no cast may kill a creature, every round has to hit the same targets
+    for (std::vector<Creature*>::const_iterator itr = bench.Creatures.begin(); itr != bench.Creatures.end(); ++itr)
+    {
+        (*itr)->SetMaxHealth(0x7FFFFFFF);
+        (*itr)->SetFullHealth();
+    }
+
+    uint64 start = getUSTime();
+    for (uint32 i = 0; i < options.Iterations; ++i)
+        for (std::vector<Player*>::const_iterator itr = bench.Players.begin(); itr != bench.Players.end(); ++itr)
+            (*itr)->CastSpell(*itr, spellInfo, true);
+
+    Report("area spell cast", GetUSTimeDiffToNow(start), searches);
+    return 0;
+}
+
+int RunAuras(BenchmarkOptions const& options, BenchmarkMap& bench)
+{
+    if (!sSpellMgr->GetSpellInfo(options.AuraSpellId))
+    {
+        printf("Spell %u does not exist\n", options.AuraSpellId);
+        return 1;
+    }
+
+    // periodic damage must not kill a creature, every round has to find the same units
+    for (std::vector<Creature*>::const_iterator itr = bench.Creatures.begin(); itr != bench.Creatures.end(); ++itr)
+    {
+        (*itr)->SetMaxHealth(0x7FFFFFFF);
+        (*itr)->SetFullHealth();
+    }
+
+    printf("%u creatures, %u players, aura %u\n", uint32(bench.Creatures.size()), uint32(bench.Players.size()), options.AuraSpellId);
+    ReportResident("resident, populated map", GetResidentBytes());
+
+    // removed auras are deleted by the next update of their owner, like on a running map that update is not timed
+    uint32 applications = options.Iterations * bench.Creatures.size();
+    uint64 elapsed = 0;
+    for (uint32 i = 0; i < options.Iterations; ++i)
+    {
+        uint64 start = getUSTime();
+        for (std::vector<Creature*>::const_iterator itr = bench.Creatures.begin(); itr != bench.Creatures.end(); ++itr)
+        {
+            (*itr)->AddAura(options.AuraSpellId, *itr);
+            (*itr)->RemoveAurasDueToSpell(options.AuraSpellId);
+        }
+
+        elapsed += GetUSTimeDiffToNow(start);
+        bench.Instance->Update(BENCHMARK_TICK);
+    }
+
+    Report("aura apply and remove", elapsed, applications);
+    ReportResident("resident, after apply and remove", GetResidentBytes());
+
+    uint64 start = getUSTime();
+    for (uint32 i = 0; i < options.Iterations; ++i)
+        bench.Instance->Update(BENCHMARK_TICK);
+
+    Report("map update without auras", GetUSTimeDiffToNow(start), options.Iterations);
+
+    for (std::vector<Creature*>::const_iterator itr = bench.Creatures.begin(); itr != bench.Creatures.end(); ++itr)
+        (*itr)->AddAura(options.AuraSpellId, *itr);
+
+    ReportResident("resident, aura on every creature", GetResidentBytes());
+
+    start = getUSTime();
+    for (uint32 i = 0; i < options.Iterations; ++i)
+        bench.Instance->Update(BENCHMARK_TICK);
+
+    Report("map update with auras", GetUSTimeDiffToNow(start), options.Iterations);
+
+    for (std::vector<Creature*>::const_iterator itr = bench.Creatures.begin(); itr != bench.Creatures.end(); ++itr)
+        (*itr)->RemoveAurasDueToSpell(options.AuraSpellId);
+
+    return 0;
+}
+
+void ReportPhase(char const* name, TickPhaseStats const& stats)
+{
+    printf("%-24s %8u %8u %8u %8u\n", name, stats.P50, stats.P99, stats.Max, stats.Average);
+}
+
+int RunCombat(BenchmarkOptions const& options, BenchmarkMap& bench)
+{
+    SpellInfo const* areaSpell = sSpellMgr->GetSpellInfo(options.SpellId);
+    SpellInfo const* auraSpell = sSpellMgr->GetSpellInfo(options.AuraSpellId);
+    if (!areaSpell || !auraSpell)
+    {
+        printf("Spell %u or %u does not exist\n", options.SpellId, options.AuraSpellId);
+        return 1;
+    }
+
+    if (bench.Players.empty())
+    {
+        printf("The combat scenario needs players\n");
+        return 1;
+    }
+
+    if (options.Level)
+    {
+        for (std::vector<Player*>::const_iterator itr = bench.Players.begin(); itr != bench.Players.end(); ++itr)
+            (*itr)->GiveLevel(options.Level);
+
+        for (std::vector<Creature*>::const_iterator itr = bench.Creatures.begin(); itr != bench.Creatures.end(); ++itr)
+            (*itr)->SetLevel(options.Level);
+    }
+
+    // creature i attacks player i % players, every player attacks the first creature attacking it
+    std::vector<Unit*> playerTargets(bench.Players.size(), NULL);
+    for (uint32 i = 0; i < bench.Creatures.size(); ++i)
+    {
+        Creature* creature = bench.Creatures[i];
+        Player* player = bench.Players[i % bench.Players.size()];
+
+        creature->AddThreat(player, 1.0f);
+        if (creature->IsAIEnabled)
+            creature->AI()->AttackStart(player);
+
+        if (!playerTargets[i % bench.Players.size()])
+            playerTargets[i % bench.Players.size()] = creature;
+    }
+
+    for (uint32 i = 0; i < bench.Players.size(); ++i)
+        if (playerTargets[i])
+            bench.Players[i]->Attack(playerTargets[i], true);
+
+    sTickProfiler->Reset();
+    sTickProfiler->SetEnabled(true);
+
+    uint64 start = getUSTime();
+    for (uint32 tick = 0; tick < options.Iterations; ++tick)
+    {
+        // no unit may die, every tick has to fight with the same units
+        for (std::vector<Creature*>::const_iterator itr = bench.Creatures.begin(); itr != bench.Creatures.end(); ++itr)
+        {
+            (*itr)->SetMaxHealth(0x7FFFFFFF);
+            (*itr)->SetFullHealth();
+        }
+
+        for (uint32 i = 0; i < bench.Players.size(); ++i)
+        {
+            Player* player = bench.Players[i];
+            player->SetMaxHealth(0x7FFFFFFF);
+            player->SetFullHealth();
+
+            if (tick % BENCHMARK_CAST_INTERVAL || !playerTargets[i])
+                continue;
+
+            // the creatures chase the players, face the target again before melee and casts
+            player->SetOrientation(player->GetAngle(playerTargets[i]));
+            player->m_Events.AddEvent(new BenchmarkCastEvent(player, player, areaSpell), player->m_Events.CalculateTime(0));
+            player->m_Events.AddEvent(new BenchmarkCastEvent(player, playerTargets[i], auraSpell), player->m_Events.CalculateTime(0));
+        }
+
+        bench.Instance->Update(BENCHMARK_TICK);
+    }
+
+    uint64 elapsed = GetUSTimeDiffToNow(start);
+    sTickProfiler->SetEnabled(false);
+
+    printf("%u creatures, %u players, %u ticks of %u ms, spells %u and %u every %u ticks\n", uint32(bench.Creatures.size()),
+        uint32(bench.Players.size()), options.Iterations, BENCHMARK_TICK, options.SpellId, options.AuraSpellId, BENCHMARK_CAST_INTERVAL);
+    Report("map update", elapsed, options.Iterations);
+
+    TickProfile profile(TICK_PROFILE_MAP, 0, 0, NULL);
+    if (!sTickProfiler->GetMapProfile(bench.Instance->GetId(), bench.Instance->GetInstanceId(), profile))
+    {
+        printf("No ticks recorded for map %u\n", bench.Instance->GetId());
+        return 1;
+    }
+
+    printf("last %u ticks, microseconds:\n", profile.GetSampleCount());
+    printf("%-24s %8s %8s %8s %8s\n", "", "p50", "p99", "max", "avg");
+    ReportPhase("Tick", profile.GetPhaseStats(MAX_TICK_PHASES));
+    for (uint8 phase = 0; phase < profile.GetPhaseCount(); ++phase)
+        ReportPhase(TickProfiler::GetPhaseName(TICK_PROFILE_MAP, phase), profile.GetPhaseStats(phase));
+
+    for (uint8 section = 0; section < MAX_MAP_TICK_SECTIONS; ++section)
+        ReportPhase(TickProfiler::GetSectionName(section), profile.GetSectionStats(section));
+
+    return 0;
+}
+
+int RunPull(BenchmarkOptions const& options, BenchmarkMap& bench)
+{
+    SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(options.SpellId);
+    if (!spellInfo)
+    {
+        printf("Spell %u does not exist\n", options.SpellId);
+        return 1;
+    }
+
+    // the spells of a round are deleted by the next update of their casters, like on a running map that update is not timed
+    uint32 casts = options.Iterations * bench.Players.size();
+    uint64 elapsed = 0;
+    for (uint32 i = 0; i < options.Iterations; ++i)
+    {
+        // no cast may kill a creature, every pull has to hit the whole pack
+        for (std::vector<Creature*>::const_iterator itr = bench.Creatures.begin(); itr != bench.Creatures.end(); ++itr)
+        {
+            (*itr)->SetMaxHealth(0x7FFFFFFF);
+            (*itr)->SetFullHealth();
+        }
+
+        uint64 start = getUSTime();
+        for (std::vector<Player*>::const_iterator itr = bench.Players.begin(); itr != bench.Players.end(); ++itr)
+            (*itr)->CastSpell(*itr, spellInfo, true);
+
+        elapsed += GetUSTimeDiffToNow(start);
+        bench.Instance->Update(BENCHMARK_TICK);
+    }
+
+    printf("%u players, %u creatures up to %.1f yards off the center, spell %u, %u pulls\n", uint32(bench.Players.size()), uint32(bench.Creatures.size()),
+        options.Spread, options.SpellId, options.Iterations);
+    Report("area spell cast", elapsed, casts);
+    Report("pull, all players", elapsed, options.Iterations);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (strcmp(options.Scenario, "aoe") && strcmp(options.Scenario, "auras") && strcmp(options.Scenario, "combat") &&
+        strcmp(options.Scenario, "pull"))
+    {
+        printf("Runtime-Error: unknown scenario %s\n", options.Scenario);
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (!StartWorld(options))
+        return 1;
+
+    BenchmarkMap bench;
+    int ret = 1;
+    if (PopulateMap(options, bench))
+    {
+        if (!strcmp(options.Scenario, "aoe"))
+            ret = RunAoE(options, bench);
+        else if (!strcmp(options.Scenario, "auras"))
+            ret = RunAuras(options, bench);
+        else if (!strcmp(options.Scenario, "combat"))
+            ret = RunCombat(options, bench);
+        else
+            ret = RunPull(options, bench);
+    }
+
+    for (std::vector<Player*>::const_iterator itr = bench.Players.begin(); itr != bench.Players.end(); ++itr)
+        RemovePlayer(*itr);
+
+    StopWorld();
+    return ret;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+    Converts a packet capture ring file (PacketLog.Capture.Size) into the plain packet log
+    format written by PacketLog without capture: int32 opcode, int32 size, uint32 unix time,
+    uint8 direction followed by the packet data. Packets can be filtered on the way.
+*/
+
+#include "PacketCaptureFormat.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <vector>
+
+struct PacketFilter
+{
+    PacketFilter() : ConnectionId(0), AccountId(0), Direction(-1), From(0), To(0) { }
+
+    std::set<uint32> Opcodes;                               // empty: all opcodes
+    uint32 ConnectionId;                                    // 0: all connections
+    uint32 AccountId;                                       // 0: all accounts
+    int Direction;                                          // -1: both directions
+    uint64 From;                                            // unix time, 0: no limit
+    uint64 To;
+
+    bool Matches(PacketCaptureRecord const& record) const
+    {
+        if (!Opcodes.empty() && Opcodes.find(record.Opcode) == Opcodes.end())
+            return false;
+
+        if (ConnectionId && record.ConnectionId != ConnectionId)
+            return false;
+
+        if (AccountId && record.AccountId != AccountId)
+            return false;
+
+        if (Direction >= 0 && record.Direction != Direction)
+            return false;
+
+        uint64 time = record.Time / 1000000;
+        if ((From && time < From) || (To && time > To))
+            return false;
+
+        return true;
+    }
+};
+
+void PrintUsage(char const* name)
+{
+    printf("usage: %s <capture file> <output file> [options]\n"
+           "  -o <opcode>      only packets with this opcode, may be repeated\n"
+           "  -c <connection>  only packets of this connection id\n"
+           "  -a <account>     only packets of this account id\n"
+           "  -d <direction>   only packets of this direction (0 - client to server, 1 - server to client)\n"
+           "  -f <unix time>   only packets captured at or after this time\n"
+           "  -t <unix time>   only packets captured at or before this time\n", name);
+}
+
+bool ParseArguments(int argc, char* argv[], PacketFilter& filter)
+{
+    for (int i = 3; i < argc; ++i)
+    {
+        if (argv[i][0] != '-' || !argv[i][1] || argv[i][2] || i + 1 >= argc)
+            return false;
+
+        unsigned long value = strtoul(argv[++i], NULL, 0);  // decimal or 0x hex
+        switch (argv[i - 1][1])
+        {
+            case 'o': filter.Opcodes.insert(uint32(value)); break;
+            case 'c': filter.ConnectionId = uint32(value); break;
+            case 'a': filter.AccountId = uint32(value); break;
+            case 'd': filter.Direction = value ? 1 : 0; break;
+            case 'f': filter.From = value; break;
+            case 't': filter.To = value; break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void WriteUInt32(FILE* file, uint32 value)
+{
+    uint8 bytes[4] = { uint8(value), uint8(value >> 8), uint8(value >> 16), uint8(value >> 24) };
+    fwrite(bytes, 1, sizeof(bytes), file);
+}
+
+int main(int argc, char* argv[])
+{
+    PacketFilter filter;
+    if (argc < 3 || !ParseArguments(argc, argv, filter))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    FILE* input = fopen(argv[1], "rb");
+    if (!input)
+    {
+        printf("Could not open %s\n", argv[1]);
+        return 1;
+    }
+
+    PacketCaptureHeader header;
+    if (fread(&header, sizeof(header), 1, input) != 1 || header.Magic != PACKET_CAPTURE_MAGIC ||
+        header.Version != PACKET_CAPTURE_VERSION || header.HeaderSize < sizeof(header) || !header.Capacity)
+    {
+        printf("%s is not a packet capture file\n", argv[1]);
+        fclose(input);
+        return 1;
+    }
+
+    FILE* output = fopen(argv[2], "wb");
+    if (!output)
+    {
+        printf("Could not create %s\n", argv[2]);
+        fclose(input);
+        return 1;
+    }
+
+    uint64 read = 0;
+    uint64 written = 0;
+    std::vector<uint8> payload;
+
+    // the writer may still run, the header read above is the snapshot converted
+    uint64 position = header.Tail;
+    while (position < header.Head)
+    {
+        uint64 offset = position % header.Capacity;
+        PacketCaptureRecord record;
+        uint32 size = 0;
+
+        if (header.Capacity - offset >= sizeof(uint32))
+        {
+            fseek(input, long(header.HeaderSize + offset), SEEK_SET);
+            if (fread(&size, sizeof(size), 1, input) != 1)
+                break;
+        }
+
+        if (!size)
+        {
+            position += header.Capacity - offset;
+            continue;
+        }
+
+        fseek(input, long(header.HeaderSize + offset), SEEK_SET);
+        if (size < sizeof(record) || fread(&record, sizeof(record), 1, input) != 1 ||
+            record.Length > size - sizeof(record))
+        {
+            printf("Corrupted record at position " UI64FMTD ", stopping\n", position);
+            break;
+        }
+
+        position += size;
+        ++read;
+
+        if (!filter.Matches(record))
+            continue;
+
+        payload.resize(record.Length);
+        if (record.Length && fread(&payload[0], record.Length, 1, input) != 1)
+            break;
+
+        WriteUInt32(output, record.Opcode);
+        WriteUInt32(output, record.Length);
+        WriteUInt32(output, uint32(record.Time / 1000000));
+        fputc(record.Direction, output);
+        if (record.Length)
+            fwrite(&payload[0], record.Length, 1, output);
+
+        ++written;
+    }
+
+    fclose(input);
+    fclose(output);
+
+    printf("Read " UI64FMTD " packets, wrote " UI64FMTD ". The capture has seen " UI64FMTD " packets, " UI64FMTD " were too large to capture.\n",
+        read, written, header.Records, header.Dropped);
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2008-2013 Trinitycore <http://www.trinitycore.org/>
+ * Copyright (C) 2009-2014 Infinitycore <http://www.infinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+    Times the server side SRP6 math of one authserver handshake: g^b and B for the logon
+    challenge, S = (A * v^u)^b for the logon proof. The plain BigNumber path, which builds
+    a Montgomery context per call, is compared with ModExpContext and its fixed base table.
+    The fixed base exponentiation is also timed with exponents of only zero and only
+    non zero digits, both should take the same time.
+*/
+
+#include "Cryptography/BigNumber.h"
+
+#include <ace/OS_NS_sys_time.h>
+#include <ace/Time_Value.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define SRP6_MODULUS            "894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7"
+#define SRP6_GENERATOR          7
+#define SRP6_MAX_EXPONENT_BITS  160
+
+struct HandshakeInput
+{
+    BigNumber v;                                            // verifier
+    BigNumber b;                                            // server private ephemeral
+    BigNumber A;                                            // client public ephemeral
+    BigNumber u;                                            // scrambler
+};
+
+uint64 Now()
+{
+    ACE_UINT64 usec;
+    ACE_OS::gettimeofday().to_usec(usec);
+    return usec;
+}
+
+void Report(char const* name, uint64 usec, uint32 count)
+{
+    printf("%-40s %10.2f us/op\n", name, double(usec) / count);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32 count = argc > 1 ? uint32(atoi(argv[1])) : 2000;
+    if (!count)
+    {
+        printf("usage: %s [handshakes]\n", argv[0]);
+        return 1;
+    }
+
+    BigNumber N;
+    N.SetHexStr(SRP6_MODULUS);
+    BigNumber g(SRP6_GENERATOR);
+
+    uint64 start = Now();
+    ModExpContext context(N);
+    context.SetFixedBase(g, SRP6_MAX_EXPONENT_BITS);
+    Report("ModExpContext setup", Now() - start, 1);
+
+    std::vector<HandshakeInput> inputs(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        BigNumber x;
+        x.SetRand(SRP6_MAX_EXPONENT_BITS);
+        inputs[i].v = g.ModExp(x, N);
+        inputs[i].b.SetRand(19 * 8);
+        BigNumber a;
+        a.SetRand(19 * 8);
+        inputs[i].A = g.ModExp(a, N);
+        inputs[i].u.SetRand(SRP6_MAX_EXPONENT_BITS);
+    }
+
+    // results are compared so that neither path can be optimized away
+    std::vector<BigNumber> plain(count);
+    std::vector<BigNumber> fixed(count);
+
+    start = Now();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        HandshakeInput& in = inputs[i];
+        BigNumber B = ((in.v * 3) + g.ModExp(in.b, N)) % N;
+        plain[i] = (in.A * in.v.ModExp(in.u, N)).ModExp(in.b, N) + B;
+    }
+    Report("handshake, BigNumber::ModExp", Now() - start, count);
+
+    start = Now();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        HandshakeInput& in = inputs[i];
+        BigNumber B = ((in.v * 3) + context.FixedBaseModExp(in.b)) % N;
+        fixed[i] = context.ModExp(in.A * context.ModExp(in.v, in.u), in.b) + B;
+    }
+    Report("handshake, ModExpContext", Now() - start, count);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if ((plain[i] - fixed[i]).isZero())
+            continue;
+
+        printf("result mismatch in handshake %u\n", i);
+        return 1;
+    }
+
+    start = Now();
+    for (uint32 i = 0; i < count; ++i)
+        plain[i] = g.ModExp(inputs[i].b, N);
+    Report("g^b, BigNumber::ModExp", Now() - start, count);
+
+    start = Now();
+    for (uint32 i = 0; i < count; ++i)
+        fixed[i] = context.FixedBaseModExp(inputs[i].b);
+    Report("g^b, FixedBaseModExp", Now() - start, count);
+
+    // 2^156: every digit but the top one is 0, 0x...FFFF: every digit is 15
+    BigNumber zeroDigits;
+    zeroDigits.SetHexStr("1000000000000000000000000000000000000000");
+    BigNumber fullDigits;
+    fullDigits.SetHexStr("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF");
+
+    start = Now();
+    for (uint32 i = 0; i < count; ++i)
+        fixed[i] = context.FixedBaseModExp(zeroDigits);
+    Report("FixedBaseModExp, zero digits", Now() - start, count);
+
+    start = Now();
+    for (uint32 i = 0; i < count; ++i)
+        fixed[i] = context.FixedBaseModExp(fullDigits);
+    Report("FixedBaseModExp, non zero digits", Now() - start, count);
+
+    if (!(context.FixedBaseModExp(fullDigits) - g.ModExp(fullDigits, N)).isZero())
+    {
+        printf("result mismatch for the non zero digits exponent\n");
+        return 1;
+    }
+
+    return 0;
+}